@@ -38,6 +38,7 @@ int main() {
         auto tradeService = std::make_shared<TradeService>(repo, publisher);
         tradeService->AddValidator(equityValidator);
         tradeService->AddValidator(bondValidator);
+        tradeService->SetMetricsSampleInterval(1);  // A handful of trades: time them all
 
         std::cout << "\nBooking sample trades..." << std::endl;
 
@@ -110,6 +111,8 @@ int main() {
             std::cout << "✓ Validation correctly failed: " << ex.what() << std::endl;
         }
 
+        std::cout << "\n" << tradeService->GetMetricsSnapshot().ToText();
+
         std::cout << "\n=== Trade Booking Engine Demo Complete ===" << std::endl;
     }
     catch (const std::exception& ex) {
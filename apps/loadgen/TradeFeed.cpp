@@ -0,0 +1,262 @@
+#include "TradeFeed.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Utils;
+
+namespace TradeBookEngine {
+namespace LoadGen {
+
+    namespace {
+
+        const char* const Header =
+            "asset_class,instrument_id,counterparty,notional,currency,side,"
+            "trade_date,settlement_date,idempotency_key,attributes";
+        const std::size_t FieldCount = 10;
+
+        const char* const AssetClassNames[AssetClassCount] = {"equity", "bond", "derivative", "commodity", "currency"};
+        const char* const InstrumentPrefixes[AssetClassCount] = {"EQ-", "BD-", "DV-", "CM-", ""};
+        const char* const CurrencyPairs[] = {"EURUSD", "USDJPY", "GBPUSD", "USDCHF", "AUDUSD", "USDCAD", "EURGBP", "EURJPY"};
+        const char* const Currencies[] = {"USD", "EUR", "GBP", "JPY", "CHF"};
+        const double CurrencyWeights[] = {50.0, 25.0, 10.0, 10.0, 5.0};
+        const char* const Exchanges[] = {"NYSE", "NASDAQ", "LSE", "XETRA"};
+        const char* const Ratings[] = {"AAA", "AA", "A", "BBB"};
+
+        template <typename T, std::size_t N>
+        const T& Pick(std::mt19937_64& rng, const T (&values)[N]) {
+            return values[std::uniform_int_distribution<std::size_t>(0, N - 1)(rng)];
+        }
+
+        std::vector<std::string> Split(const std::string& text, char separator) {
+            std::vector<std::string> parts;
+            std::size_t start = 0;
+            for (;;) {
+                auto end = text.find(separator, start);
+                parts.push_back(text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+                if (end == std::string::npos) {
+                    return parts;
+                }
+                start = end + 1;
+            }
+        }
+
+        std::string FormatTime(const std::chrono::system_clock::time_point& time) {
+            char buffer[DateTimeUtils::MaxIso8601Length];
+            auto length = DateTimeUtils::FormatIso8601(time, buffer, sizeof(buffer), TimestampPrecision::Milliseconds);
+            return std::string(buffer, length);
+        }
+
+        bool ParseTime(const std::string& text, std::chrono::system_clock::time_point& time) {
+            return DateTimeUtils::ParseIso8601(text.data(), text.size(), time);
+        }
+
+    } // namespace
+
+    const char* AssetClassName(AssetClass assetClass) {
+        auto index = static_cast<std::size_t>(assetClass);
+        return index < AssetClassCount ? AssetClassNames[index] : "unknown";
+    }
+
+    AssetClass ParseAssetClass(const std::string& name) {
+        for (std::size_t i = 0; i < AssetClassCount; ++i) {
+            if (name == AssetClassNames[i]) {
+                return static_cast<AssetClass>(i);
+            }
+        }
+        throw FeedError("Unknown asset class '" + name + "'");
+    }
+
+    std::array<double, AssetClassCount> ParseMix(const std::string& text) {
+        std::array<double, AssetClassCount> mix{};
+        double total = 0.0;
+        for (const auto& part : Split(text, ',')) {
+            auto equals = part.find('=');
+            if (equals == std::string::npos) {
+                throw FeedError("Asset class mix entry '" + part + "' is not class=weight");
+            }
+            auto weightText = part.substr(equals + 1);
+            char* end = nullptr;
+            double weight = std::strtod(weightText.c_str(), &end);
+            if (weightText.empty() || *end != '\0' || !(weight >= 0.0)) {
+                throw FeedError("Asset class mix entry '" + part + "' has an invalid weight");
+            }
+            mix[static_cast<std::size_t>(ParseAssetClass(part.substr(0, equals)))] = weight;
+            total += weight;
+        }
+        if (!(total > 0.0)) {
+            throw FeedError("Asset class mix '" + text + "' has no positive weight");
+        }
+        return mix;
+    }
+
+    std::vector<TradeDto> Synthesize(const FeedOptions& options, std::size_t stream, std::size_t count) {
+        if (options.Counterparties == 0 || options.Instruments == 0) {
+            throw FeedError("Counterparty and instrument counts must be positive");
+        }
+        std::mt19937_64 rng(options.Seed ^ (0x9E3779B97F4A7C15ull * (stream + 1)));
+        std::discrete_distribution<std::size_t> assetClasses(options.Mix.begin(), options.Mix.end());
+        std::discrete_distribution<std::size_t> currencies(std::begin(CurrencyWeights), std::end(CurrencyWeights));
+        std::uniform_int_distribution<std::size_t> counterparties(0, options.Counterparties - 1);
+        std::uniform_int_distribution<std::size_t> instruments(0, options.Instruments - 1);
+        // Median notional 250k with a long right tail
+        std::lognormal_distribution<double> notionals(std::log(250000.0), 1.2);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::uniform_int_distribution<int> maturityYears(1, 30);
+        auto now = std::chrono::system_clock::now();
+        std::string streamPrefix = "s" + std::to_string(stream) + "-";
+
+        std::vector<TradeDto> trades;
+        trades.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!trades.empty() && unit(rng) * 100.0 < options.DuplicatePercent) {
+                std::uniform_int_distribution<std::size_t> earlier(0, trades.size() - 1);
+                trades.push_back(trades[earlier(rng)]);
+                continue;
+            }
+
+            TradeDto dto;
+            auto assetClass = static_cast<AssetClass>(assetClasses(rng));
+            auto classIndex = static_cast<std::size_t>(assetClass);
+            dto.AssetClass = assetClass;
+            dto.Counterparty = "CP-" + std::to_string(counterparties(rng));
+            dto.Side = unit(rng) < 0.5 ? TradeSide::Buy : TradeSide::Sell;
+            dto.Currency = Currencies[currencies(rng)];
+            dto.Notional = std::round(notionals(rng) * 100.0) / 100.0;
+            if (assetClass == AssetClass::Currency) {
+                dto.InstrumentId = Pick(rng, CurrencyPairs);
+            } else {
+                dto.InstrumentId = InstrumentPrefixes[classIndex] + std::to_string(instruments(rng));
+            }
+            if (assetClass == AssetClass::Equity) {
+                dto.Notional = std::max(1.0, std::round(dto.Notional));
+                dto.Additional.SetExchange(Pick(rng, Exchanges));
+            } else if (assetClass == AssetClass::Bond) {
+                dto.Notional = std::max(1000.0, std::round(dto.Notional / 1000.0) * 1000.0);
+                dto.Additional.SetMaturityDate(std::to_string(2025 + maturityYears(rng)) + "-06-15");
+                dto.Additional.SetCreditRating(Pick(rng, Ratings));
+            }
+            dto.TradeDate = now;
+            dto.SettlementDate = now + std::chrono::hours(48);
+            dto.IdempotencyKey = streamPrefix + std::to_string(i);
+            dto.CreatedBy = "loadgen";
+            trades.push_back(std::move(dto));
+        }
+        return trades;
+    }
+
+    void WriteTradeFile(std::ostream& out, const std::vector<TradeDto>& trades) {
+        out << Header << "\n";
+        out.precision(17);
+        for (const auto& dto : trades) {
+            out << AssetClassName(dto.AssetClass) << ',' << dto.InstrumentId << ',' << dto.Counterparty << ','
+                << dto.Notional << ',' << dto.Currency << ',' << (dto.Side == TradeSide::Buy ? "buy" : "sell") << ','
+                << FormatTime(dto.TradeDate) << ',' << FormatTime(dto.SettlementDate) << ','
+                << dto.IdempotencyKey << ',';
+            bool first = true;
+            for (const auto& entry : dto.Additional) {
+                out << (first ? "" : ";") << entry.Key() << '=' << entry.Value;
+                first = false;
+            }
+            out << "\n";
+        }
+    }
+
+    void WriteTradeFile(const std::string& path, const std::vector<TradeDto>& trades) {
+        std::ofstream out(path);
+        if (!out) {
+            throw FeedError("Cannot create " + path);
+        }
+        WriteTradeFile(out, trades);
+        out.flush();
+        if (!out) {
+            throw FeedError("Cannot write " + path);
+        }
+    }
+
+    std::vector<TradeDto> ReadTradeFile(std::istream& in, const std::string& sourceName) {
+        std::vector<TradeDto> trades;
+        std::string line;
+        std::size_t lineNumber = 0;
+        auto fail = [&](const std::string& what) {
+            return FeedError(sourceName + ":" + std::to_string(lineNumber) + ": " + what);
+        };
+
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (lineNumber == 1) {
+                if (line != Header) {
+                    throw fail("expected header '" + std::string(Header) + "'");
+                }
+                continue;
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            auto fields = Split(line, ',');
+            if (fields.size() != FieldCount) {
+                throw fail("expected " + std::to_string(FieldCount) + " fields, found " + std::to_string(fields.size()));
+            }
+            TradeDto dto;
+            try {
+                dto.AssetClass = ParseAssetClass(fields[0]);
+            } catch (const FeedError& error) {
+                throw fail(error.what());
+            }
+            dto.InstrumentId = fields[1];
+            dto.Counterparty = fields[2];
+            char* end = nullptr;
+            dto.Notional = std::strtod(fields[3].c_str(), &end);
+            if (fields[3].empty() || *end != '\0') {
+                throw fail("invalid notional '" + fields[3] + "'");
+            }
+            dto.Currency = fields[4];
+            if (fields[5] != "buy" && fields[5] != "sell") {
+                throw fail("side must be buy or sell");
+            }
+            dto.Side = fields[5] == "buy" ? TradeSide::Buy : TradeSide::Sell;
+            if (!ParseTime(fields[6], dto.TradeDate) || !ParseTime(fields[7], dto.SettlementDate)) {
+                throw fail("invalid ISO-8601 date");
+            }
+            dto.IdempotencyKey = fields[8];
+            if (!fields[9].empty()) {
+                for (const auto& attribute : Split(fields[9], ';')) {
+                    auto equals = attribute.find('=');
+                    if (equals == std::string::npos || equals == 0) {
+                        throw fail("attribute '" + attribute + "' is not key=value");
+                    }
+                    dto.Additional.Set(std::string_view(attribute).substr(0, equals),
+                                       std::string_view(attribute).substr(equals + 1));
+                }
+            }
+            dto.CreatedBy = "loadgen-replay";
+            trades.push_back(std::move(dto));
+        }
+        if (lineNumber == 0) {
+            throw FeedError(sourceName + ": empty trade file");
+        }
+        return trades;
+    }
+
+    std::vector<TradeDto> ReadTradeFile(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            throw FeedError("Cannot open " + path);
+        }
+        return ReadTradeFile(in, path);
+    }
+
+} // namespace LoadGen
+} // namespace TradeBookEngine
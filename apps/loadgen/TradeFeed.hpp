@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TradeBookEngine/Core/Enums.hpp"
+#include "TradeBookEngine/Core/TradeDto.hpp"
+
+namespace TradeBookEngine {
+namespace LoadGen {
+
+    // Shape of a synthetic trade stream
+    struct FeedOptions {
+        // Relative weight of each asset class, indexed by AssetClass
+        std::array<double, Core::Enums::AssetClassCount> Mix{{70.0, 30.0, 0.0, 0.0, 0.0}};
+        std::size_t Counterparties = 1000;
+        std::size_t Instruments = 5000;
+        // Share of trades that resend an earlier trade of the same stream,
+        // idempotency key included, as a client retry would
+        double DuplicatePercent = 0.0;
+        std::uint64_t Seed = 42;
+    };
+
+    class FeedError : public std::runtime_error {
+    public:
+        explicit FeedError(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    const char* AssetClassName(Core::Enums::AssetClass assetClass);
+    // Accepts the lower-case names AssetClassName returns; throws FeedError
+    Core::Enums::AssetClass ParseAssetClass(const std::string& name);
+
+    // Parses "equity=70,bond=30"; classes not named get weight 0
+    std::array<double, Core::Enums::AssetClassCount> ParseMix(const std::string& text);
+
+    // count trades for stream `stream`. Streams with different numbers
+    // never share idempotency keys, so each booking thread can own one.
+    // Bonds carry a maturity and rating and equities an exchange, so every
+    // trade passes the bundled validators.
+    std::vector<Core::Models::TradeDto> Synthesize(const FeedOptions& options, std::size_t stream, std::size_t count);
+
+    // Recorded trade files are CSV with a header row:
+    //   asset_class,instrument_id,counterparty,notional,currency,side,
+    //   trade_date,settlement_date,idempotency_key,attributes
+    // Dates are ISO-8601 UTC, side is buy or sell, and attributes are
+    // key=value pairs separated by ';'. Fields cannot contain commas.
+    void WriteTradeFile(std::ostream& out, const std::vector<Core::Models::TradeDto>& trades);
+    void WriteTradeFile(const std::string& path, const std::vector<Core::Models::TradeDto>& trades);
+    // Throws FeedError naming the line of the first malformed row
+    std::vector<Core::Models::TradeDto> ReadTradeFile(std::istream& in, const std::string& sourceName);
+    std::vector<Core::Models::TradeDto> ReadTradeFile(const std::string& path);
+
+} // namespace LoadGen
+} // namespace TradeBookEngine
@@ -0,0 +1,470 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TradeFeed.hpp"
+#include "TradeBookEngine/Core/TradeService.hpp"
+#include "TradeBookEngine/Core/Metrics/BookingMetrics.hpp"
+#include "TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include "TradeBookEngine/Core/Interfaces/IEventPublisher.hpp"
+#include "TradeBookEngine/Core/Validators/IAssetValidator.hpp"
+
+using namespace TradeBookEngine::LoadGen;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Services;
+using namespace TradeBookEngine::Core::Validators;
+using namespace TradeBookEngine::Core::Metrics;
+
+// Factory functions implemented in the core static library (extern "C")
+extern "C" {
+    ITradeRepository* CreateInMemoryTradeRepository();
+    void DestroyInMemoryTradeRepository(ITradeRepository* repository);
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+    void DestroyShardedTradeRepository(ITradeRepository* repository);
+    ITradeRepository* CreateJournalTradeRepository(const char* path);
+    void DestroyJournalTradeRepository(ITradeRepository* repository);
+    IAssetValidator* CreateEquityValidator();
+    IAssetValidator* CreateBondValidator();
+    void DestroyValidator(IAssetValidator* validator);
+}
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    const char* const Usage =
+        "Usage: tradebook_loadgen [options]\n"
+        "\n"
+        "Load:\n"
+        "  --rate N                 open loop: N trades/s across all threads, each\n"
+        "                           sent on schedule whether or not the last returned\n"
+        "                           (default: closed loop, each thread as fast as it can)\n"
+        "  --count N                trades to book (default 100000)\n"
+        "  --duration S             open loop: book rate*S trades instead of --count\n"
+        "  --threads N              booking threads (default 1)\n"
+        "  --batch N                trades per BookTrades call (default 1: TryBookTrade)\n"
+        "  --expected-interval-us U closed loop: correct for coordinated omission\n"
+        "                           assuming one request per U microseconds per thread\n"
+        "Feed:\n"
+        "  --replay FILE            book the trades in FILE instead of synthetic ones.\n"
+        "                           FILE is CSV with the header asset_class,instrument_id,\n"
+        "                           counterparty,notional,currency,side,trade_date,\n"
+        "                           settlement_date,idempotency_key,attributes; dates are\n"
+        "                           ISO-8601, attributes key=value;key=value\n"
+        "  --mix equity=70,bond=30  asset class weights (equity, bond, derivative,\n"
+        "                           commodity, currency)\n"
+        "  --counterparties N       distinct counterparties (default 1000)\n"
+        "  --instruments N          distinct instruments per asset class (default 5000)\n"
+        "  --duplicates P           percent of trades resent with an earlier key (default 0)\n"
+        "  --seed N                 random seed (default 42)\n"
+        "  --write-feed FILE        write the synthetic feed to FILE and exit\n"
+        "Engine:\n"
+        "  --repository KIND        memory, sharded (default) or journal:PATH\n"
+        "  --shards N               shards of the sharded repository (default 16)\n"
+        "Report:\n"
+        "  --metrics                also print TradeService's per-stage metrics\n"
+        "  --slo-p99-us U           exit with status 2 if p99 response time exceeds U\n";
+
+    struct LoadOptions {
+        double Rate = 0.0;  // 0 is closed loop
+        std::size_t Count = 100000;
+        double DurationSeconds = 0.0;
+        std::size_t Threads = 1;
+        std::size_t Batch = 1;
+        double ExpectedIntervalMicros = 0.0;
+        std::string ReplayPath;
+        std::string WriteFeedPath;
+        std::string Repository = "sharded";
+        std::size_t Shards = 16;
+        bool PrintMetrics = false;
+        double SloP99Micros = 0.0;
+        FeedOptions Feed;
+    };
+
+    class UsageError : public std::runtime_error {
+    public:
+        explicit UsageError(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    double ParseNumber(const std::string& option, const char* text) {
+        char* end = nullptr;
+        double value = std::strtod(text, &end);
+        if (*text == '\0' || *end != '\0' || !(value >= 0.0)) {
+            throw UsageError(option + " needs a non-negative number, got '" + text + "'");
+        }
+        return value;
+    }
+
+    std::size_t ParseCount(const std::string& option, const char* text) {
+        double value = ParseNumber(option, text);
+        if (value != static_cast<double>(static_cast<std::size_t>(value))) {
+            throw UsageError(option + " needs a whole number, got '" + text + "'");
+        }
+        return static_cast<std::size_t>(value);
+    }
+
+    LoadOptions ParseOptions(int argc, char** argv) {
+        LoadOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--metrics") {
+                options.PrintMetrics = true;
+                continue;
+            }
+            if (option == "--help" || option == "-h") {
+                throw UsageError("");
+            }
+            if (i + 1 >= argc) {
+                throw UsageError("Missing value for " + option);
+            }
+            const char* value = argv[++i];
+            if (option == "--rate") {
+                options.Rate = ParseNumber(option, value);
+            } else if (option == "--count") {
+                options.Count = ParseCount(option, value);
+            } else if (option == "--duration") {
+                options.DurationSeconds = ParseNumber(option, value);
+            } else if (option == "--threads") {
+                options.Threads = ParseCount(option, value);
+            } else if (option == "--batch") {
+                options.Batch = ParseCount(option, value);
+            } else if (option == "--expected-interval-us") {
+                options.ExpectedIntervalMicros = ParseNumber(option, value);
+            } else if (option == "--replay") {
+                options.ReplayPath = value;
+            } else if (option == "--write-feed") {
+                options.WriteFeedPath = value;
+            } else if (option == "--mix") {
+                options.Feed.Mix = ParseMix(value);
+            } else if (option == "--counterparties") {
+                options.Feed.Counterparties = ParseCount(option, value);
+            } else if (option == "--instruments") {
+                options.Feed.Instruments = ParseCount(option, value);
+            } else if (option == "--duplicates") {
+                options.Feed.DuplicatePercent = std::min(100.0, ParseNumber(option, value));
+            } else if (option == "--seed") {
+                options.Feed.Seed = static_cast<std::uint64_t>(ParseCount(option, value));
+            } else if (option == "--repository") {
+                options.Repository = value;
+            } else if (option == "--shards") {
+                options.Shards = ParseCount(option, value);
+            } else if (option == "--slo-p99-us") {
+                options.SloP99Micros = ParseNumber(option, value);
+            } else {
+                throw UsageError("Unknown option " + option);
+            }
+        }
+        if (options.Threads == 0 || options.Batch == 0) {
+            throw UsageError("--threads and --batch must be at least 1");
+        }
+        if (options.DurationSeconds > 0.0) {
+            if (options.Rate <= 0.0) {
+                throw UsageError("--duration needs --rate");
+            }
+            options.Count = static_cast<std::size_t>(options.Rate * options.DurationSeconds);
+        }
+        return options;
+    }
+
+    // Discards events so the run measures booking, not the console
+    class DiscardingEventPublisher : public IEventPublisher {
+    public:
+        void Publish(const TradeBookEngine::Core::Events::TradeBookedEvent&) override {}
+        void PublishBatch(const std::vector<TradeBookEngine::Core::Events::TradeBookedEvent>&) override {}
+    };
+
+    std::shared_ptr<ITradeRepository> MakeRepository(const LoadOptions& options) {
+        const std::string journalPrefix = "journal:";
+        if (options.Repository == "memory") {
+            return std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(), DestroyInMemoryTradeRepository);
+        }
+        if (options.Repository == "sharded") {
+            return std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(options.Shards),
+                                                     DestroyShardedTradeRepository);
+        }
+        if (options.Repository.compare(0, journalPrefix.size(), journalPrefix) == 0 &&
+            options.Repository.size() > journalPrefix.size()) {
+            auto path = options.Repository.substr(journalPrefix.size());
+            return std::shared_ptr<ITradeRepository>(CreateJournalTradeRepository(path.c_str()),
+                                                     DestroyJournalTradeRepository);
+        }
+        throw UsageError("Unknown repository '" + options.Repository + "'");
+    }
+
+    // What one booking thread saw. Latencies are in nanoseconds.
+    struct StreamResult {
+        std::unique_ptr<LatencyHistogram> ServiceTime = std::make_unique<LatencyHistogram>();
+        std::unique_ptr<LatencyHistogram> ResponseTime = std::make_unique<LatencyHistogram>();
+        std::uint64_t Booked = 0;
+        std::uint64_t Duplicates = 0;
+        std::uint64_t Rejected = 0;
+        std::uint64_t Failed = 0;  // The repository or publisher threw
+        std::string FirstFailure;
+    };
+
+    // When a thread is stalled for longer than the interval it was meant to
+    // send at, a closed-loop client silently skips the requests it would
+    // have sent meanwhile. Record those too, each having waited one interval
+    // less than the last (HdrHistogram's recordValueWithExpectedInterval).
+    void RecordCorrected(LatencyHistogram& histogram, std::uint64_t value, std::uint64_t expectedInterval) {
+        histogram.Record(value);
+        if (expectedInterval == 0) {
+            return;
+        }
+        for (auto missed = value; missed > expectedInterval;) {
+            missed -= expectedInterval;
+            histogram.Record(missed);
+        }
+    }
+
+    void WaitUntil(Clock::time_point target) {
+        for (;;) {
+            auto now = Clock::now();
+            if (now >= target) {
+                return;
+            }
+            // Sleep while far away, then yield so the send is not late by a
+            // scheduler quantum
+            if (target - now > std::chrono::microseconds(200)) {
+                std::this_thread::sleep_for(target - now - std::chrono::microseconds(100));
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::uint64_t Nanos(Clock::duration duration) {
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(
+            0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+
+    // Books one thread's trades. Trade i of the stream is due at
+    // start + offset + i * period in open loop; its response time runs from
+    // then, not from when the thread got round to sending it, so a stall
+    // shows up in every trade queued behind it.
+    void RunStream(TradeService& service, const std::vector<TradeDto>& trades, const LoadOptions& options,
+                   Clock::time_point start, double offsetNanos, double periodNanos, StreamResult& result) {
+        const bool openLoop = options.Rate > 0.0;
+        const auto expectedInterval = static_cast<std::uint64_t>(options.ExpectedIntervalMicros * 1000.0);
+        auto dueAt = [&](std::size_t i) {
+            return start + std::chrono::nanoseconds(
+                static_cast<std::int64_t>(offsetNanos + static_cast<double>(i) * periodNanos));
+        };
+
+        for (std::size_t first = 0; first < trades.size(); first += options.Batch) {
+            std::size_t count = std::min(options.Batch, trades.size() - first);
+            if (openLoop) {
+                WaitUntil(dueAt(first + count - 1));
+            }
+
+            auto sent = Clock::now();
+            try {
+                if (options.Batch == 1) {
+                    auto outcome = service.TryBookTrade(trades[first]);
+                    result.Booked += outcome.Status == BookingStatus::Booked ? 1u : 0u;
+                    result.Duplicates += outcome.Status == BookingStatus::Duplicate ? 1u : 0u;
+                    result.Rejected += outcome.Status == BookingStatus::Rejected ? 1u : 0u;
+                } else {
+                    for (const auto& outcome : service.BookTrades(&trades[first], count)) {
+                        result.Booked += outcome.Status == BookingStatus::Booked ? 1u : 0u;
+                        result.Duplicates += outcome.Status == BookingStatus::Duplicate ? 1u : 0u;
+                        result.Rejected += outcome.Status == BookingStatus::Rejected ? 1u : 0u;
+                    }
+                }
+            } catch (const std::exception& error) {
+                if (result.Failed == 0) {
+                    result.FirstFailure = error.what();
+                }
+                result.Failed += count;
+            }
+            auto done = Clock::now();
+
+            auto serviceTime = Nanos(done - sent);
+            for (std::size_t i = first; i < first + count; ++i) {
+                result.ServiceTime->Record(serviceTime);
+                if (openLoop) {
+                    result.ResponseTime->Record(Nanos(done - dueAt(i)));
+                } else {
+                    RecordCorrected(*result.ResponseTime, serviceTime, expectedInterval);
+                }
+            }
+        }
+    }
+
+    std::string Percent(double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.0f%%", value);
+        return text;
+    }
+
+    void PrintLatencyRow(const char* label, const HistogramSnapshot& latency) {
+        std::printf("  %-15s %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", label,
+                    latency.MeanNanos() / 1000.0, latency.PercentileNanos(50.0) / 1000.0,
+                    latency.PercentileNanos(90.0) / 1000.0, latency.PercentileNanos(99.0) / 1000.0,
+                    latency.PercentileNanos(99.9) / 1000.0, latency.PercentileNanos(99.99) / 1000.0,
+                    latency.MaxNanos() / 1000.0);
+    }
+
+    std::string DescribeFeed(const LoadOptions& options, std::size_t tradeCount) {
+        if (!options.ReplayPath.empty()) {
+            return std::to_string(tradeCount) + " trades replayed from " + options.ReplayPath;
+        }
+        double total = 0.0;
+        for (double weight : options.Feed.Mix) {
+            total += weight;
+        }
+        std::string mix;
+        for (std::size_t i = 0; i < AssetClassCount; ++i) {
+            if (options.Feed.Mix[i] > 0.0) {
+                mix += (mix.empty() ? "" : ", ") + std::string(AssetClassName(static_cast<AssetClass>(i))) + " " +
+                       Percent(options.Feed.Mix[i] / total * 100.0);
+            }
+        }
+        return std::to_string(tradeCount) + " synthetic trades (" + mix + "), " +
+               std::to_string(options.Feed.Counterparties) + " counterparties, " +
+               std::to_string(options.Feed.Instruments) + " instruments per class, " +
+               Percent(options.Feed.DuplicatePercent) + " duplicates";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LoadOptions options;
+    try {
+        options = ParseOptions(argc, argv);
+    } catch (const std::exception& error) {
+        if (*error.what() != '\0') {
+            std::cerr << error.what() << "\n\n";
+        }
+        std::cerr << Usage;
+        return 1;
+    }
+
+    try {
+        // Each thread gets its own stream: synthetic streams never share
+        // keys, and a replayed file is dealt out round-robin so that trade j
+        // of the file is still due at j / rate
+        std::vector<std::vector<TradeDto>> streams(options.Threads);
+        std::size_t tradeCount = 0;
+        if (!options.ReplayPath.empty()) {
+            auto trades = ReadTradeFile(options.ReplayPath);
+            for (std::size_t j = 0; j < trades.size(); ++j) {
+                streams[j % options.Threads].push_back(std::move(trades[j]));
+            }
+            tradeCount = trades.size();
+        } else {
+            for (std::size_t t = 0; t < options.Threads; ++t) {
+                std::size_t count = options.Count / options.Threads + (t < options.Count % options.Threads ? 1 : 0);
+                streams[t] = Synthesize(options.Feed, t, count);
+                tradeCount += count;
+            }
+        }
+
+        if (!options.WriteFeedPath.empty()) {
+            std::vector<TradeDto> interleaved;
+            interleaved.reserve(tradeCount);
+            for (std::size_t j = 0; j < tradeCount; ++j) {
+                interleaved.push_back(streams[j % options.Threads][j / options.Threads]);
+            }
+            WriteTradeFile(options.WriteFeedPath, interleaved);
+            std::cout << "Wrote " << tradeCount << " trades to " << options.WriteFeedPath << std::endl;
+            return 0;
+        }
+
+        auto service = std::make_shared<TradeService>(MakeRepository(options),
+                                                      std::make_shared<DiscardingEventPublisher>());
+        service->AddValidator(std::shared_ptr<IAssetValidator>(CreateEquityValidator(), DestroyValidator));
+        service->AddValidator(std::shared_ptr<IAssetValidator>(CreateBondValidator(), DestroyValidator));
+
+        const bool openLoop = options.Rate > 0.0;
+        std::cout << (openLoop ? "Open loop at " + std::to_string(static_cast<std::uint64_t>(options.Rate)) + " trades/s"
+                               : std::string("Closed loop"))
+                  << ", " << options.Threads << " thread" << (options.Threads == 1 ? "" : "s")
+                  << ", batch " << options.Batch << ", " << options.Repository << " repository\n"
+                  << "Feed: " << DescribeFeed(options, tradeCount) << std::endl;
+
+        // Thread t sends file positions t, t + threads, ...: per-thread
+        // period threads / rate, offset t / rate
+        double globalPeriod = openLoop ? 1e9 / options.Rate : 0.0;
+        std::vector<StreamResult> results(options.Threads);
+        std::vector<std::thread> threads;
+        auto start = Clock::now() + std::chrono::milliseconds(10);  // Let every thread start first
+        for (std::size_t t = 0; t < options.Threads; ++t) {
+            threads.emplace_back([&, t]() {
+                if (!openLoop) {
+                    WaitUntil(start);
+                }
+                RunStream(*service, streams[t], options, start, static_cast<double>(t) * globalPeriod,
+                          static_cast<double>(options.Threads) * globalPeriod, results[t]);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - start).count();
+
+        HistogramSnapshot serviceTime, responseTime;
+        StreamResult totals;
+        for (const auto& result : results) {
+            serviceTime.Add(*result.ServiceTime);
+            responseTime.Add(*result.ResponseTime);
+            totals.Booked += result.Booked;
+            totals.Duplicates += result.Duplicates;
+            totals.Rejected += result.Rejected;
+            totals.Failed += result.Failed;
+            if (totals.FirstFailure.empty()) {
+                totals.FirstFailure = result.FirstFailure;
+            }
+        }
+
+        double throughput = static_cast<double>(tradeCount) / elapsed;
+        std::printf("Elapsed %.3f s: %.0f trades/s", elapsed, throughput);
+        if (openLoop) {
+            std::printf(" (target %.0f%s)", options.Rate,
+                        throughput < options.Rate * 0.95 ? ", NOT SUSTAINED" : "");
+        }
+        std::printf("\nBooked %llu, duplicates %llu, rejected %llu, failed %llu\n",
+                    static_cast<unsigned long long>(totals.Booked), static_cast<unsigned long long>(totals.Duplicates),
+                    static_cast<unsigned long long>(totals.Rejected), static_cast<unsigned long long>(totals.Failed));
+        if (totals.Failed > 0) {
+            std::printf("First failure: %s\n", totals.FirstFailure.c_str());
+        }
+
+        std::printf("  %-15s %9s %9s %9s %9s %9s %9s %9s\n", "latency (us)", "mean", "p50", "p90", "p99",
+                    "p99.9", "p99.99", "max");
+        PrintLatencyRow("service time", serviceTime);
+        bool corrected = openLoop || options.ExpectedIntervalMicros > 0.0;
+        if (corrected) {
+            PrintLatencyRow("response time", responseTime);
+            std::printf("Response times are corrected for coordinated omission%s.\n",
+                        openLoop ? ": measured from when each trade was due" : " at the expected interval");
+        } else {
+            std::printf("Closed loop measures service time only; use --rate or --expected-interval-us\n"
+                        "to see the latency a client sending at a fixed pace would get.\n");
+        }
+
+        if (options.PrintMetrics) {
+            std::cout << "\n" << service->GetMetricsSnapshot().ToText();
+        }
+
+        const auto& slo = corrected ? responseTime : serviceTime;
+        if (options.SloP99Micros > 0.0 && slo.PercentileNanos(99.0) > options.SloP99Micros * 1000.0) {
+            std::printf("p99 %.1f us exceeds the %.1f us objective\n", slo.PercentileNanos(99.0) / 1000.0,
+                        options.SloP99Micros);
+            return 2;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
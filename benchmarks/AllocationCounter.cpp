@@ -0,0 +1,50 @@
+#include <cstdlib>
+#include <new>
+
+#include "BenchCommon.hpp"
+
+// Counts heap allocations per thread for the allocation and footprint
+// benchmarks. Plain thread-local counters keep the overhead to a few
+// instructions so timing benchmarks are not skewed.
+namespace {
+    thread_local TradeBookEngine::Bench::AllocationCounts t_counts{0, 0};
+}
+
+namespace TradeBookEngine {
+namespace Bench {
+
+    AllocationCounts ThreadAllocations() {
+        return t_counts;
+    }
+
+} // namespace Bench
+} // namespace TradeBookEngine
+
+void* operator new(std::size_t size) {
+    ++t_counts.Allocations;
+    t_counts.Bytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
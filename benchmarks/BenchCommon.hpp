@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TradeBookEngine/Core/TradeDto.hpp"
+#include "TradeBookEngine/Core/TradeService.hpp"
+#include "TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include "TradeBookEngine/Core/Interfaces/IEventPublisher.hpp"
+#include "TradeBookEngine/Core/Validators/IAssetValidator.hpp"
+
+// Factory functions implemented in the core static library (extern "C")
+extern "C" {
+    TradeBookEngine::Core::Interfaces::ITradeRepository* CreateInMemoryTradeRepository();
+    TradeBookEngine::Core::Validators::IAssetValidator* CreateEquityValidator();
+    TradeBookEngine::Core::Validators::IAssetValidator* CreateBondValidator();
+}
+
+namespace TradeBookEngine {
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchmarkCase {
+        const char* Name;
+        void (*Run)();
+    };
+
+    // Defined in bench_main.cpp
+    std::vector<BenchmarkCase>& Registry();
+
+    struct Registrar {
+        Registrar(const char* name, void (*run)()) {
+            Registry().push_back(BenchmarkCase{name, run});
+        }
+    };
+
+    // Publisher that discards events so benchmarks measure the engine, not stdout
+    class NullEventPublisher : public Core::Interfaces::IEventPublisher {
+    public:
+        void Publish(const Core::Events::TradeBookedEvent&) override {}
+        void PublishBatch(const std::vector<Core::Events::TradeBookedEvent>&) override {}
+    };
+
+    inline std::unique_ptr<Core::Services::TradeService> MakeService(
+        std::shared_ptr<Core::Interfaces::ITradeRepository> repository = nullptr) {
+        if (!repository) {
+            repository = std::shared_ptr<Core::Interfaces::ITradeRepository>(CreateInMemoryTradeRepository());
+        }
+        auto service = std::make_unique<Core::Services::TradeService>(
+            repository, std::make_shared<NullEventPublisher>());
+        service->AddValidator(std::shared_ptr<Core::Validators::IAssetValidator>(CreateEquityValidator()));
+        service->AddValidator(std::shared_ptr<Core::Validators::IAssetValidator>(CreateBondValidator()));
+        return service;
+    }
+
+    inline Core::Models::TradeDto MakeEquityDto(std::size_t index, std::size_t counterparties = 100) {
+        Core::Models::TradeDto dto;
+        dto.AssetClass = Core::Enums::AssetClass::Equity;
+        dto.InstrumentId = "EQ-" + std::to_string(index % 500);
+        dto.Counterparty = "CP-" + std::to_string(index % counterparties);
+        dto.Notional = 1000.0 + static_cast<double>(index % 1000);
+        dto.Currency = "USD";
+        dto.Side = (index % 2 == 0) ? Core::Enums::TradeSide::Buy : Core::Enums::TradeSide::Sell;
+        dto.SettlementDate = dto.TradeDate + std::chrono::hours(48);
+        dto.Additional["Exchange"] = "NASDAQ";
+        dto.IdempotencyKey = "bench-" + std::to_string(index);
+        dto.CreatedBy = "bench";
+        return dto;
+    }
+
+    struct AllocationCounts {
+        std::uint64_t Allocations;
+        std::uint64_t Bytes;
+    };
+
+    // Heap allocations made by the calling thread so far (AllocationCounter.cpp)
+    AllocationCounts ThreadAllocations();
+
+    inline volatile std::uint64_t KeepAliveSink = 0;
+
+    // Keeps a computed value observable so the optimiser cannot drop the loop
+    inline void KeepAlive(std::uint64_t value) {
+        KeepAliveSink = value;
+    }
+
+    inline double NanosPerOp(Clock::duration elapsed, std::size_t ops) {
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        return ops == 0 ? 0.0 : static_cast<double>(nanos) / static_cast<double>(ops);
+    }
+
+    // Which way a figure improves, for the --json output. ByUnit takes
+    // rates ("trades/s") as higher-is-better and everything else (times,
+    // sizes, allocation counts) as lower-is-better; counts that should grow,
+    // like records per commit, pass Higher.
+    enum class Better { ByUnit, Higher, Lower };
+
+    // Keeps a reported figure for the --json output (bench_main.cpp)
+    void RecordResult(const std::string& name, double value, const std::string& unit, Better better);
+
+    inline void Report(const std::string& name, double value, const std::string& unit = "ns/op",
+                       Better better = Better::ByUnit) {
+        std::cout << "  " << std::left << std::setw(48) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+                  << value << " " << unit << "\n";
+        RecordResult(name, value, unit, better);
+    }
+
+    // Reports mean, p50, p90, p99, p99.9 and max of per-operation latencies
+    // in nanoseconds; sorts samples
+    inline void ReportLatency(const std::string& name, std::vector<std::uint64_t>& samples) {
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double fraction) {
+            auto rank = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+            return static_cast<double>(samples[rank]);
+        };
+        double total = 0.0;
+        for (auto sample : samples) {
+            total += static_cast<double>(sample);
+        }
+        Report(name + " mean", total / static_cast<double>(samples.size()), "ns");
+        Report(name + " p50", percentile(0.50), "ns");
+        Report(name + " p90", percentile(0.90), "ns");
+        Report(name + " p99", percentile(0.99), "ns");
+        Report(name + " p99.9", percentile(0.999), "ns");
+        Report(name + " max", static_cast<double>(samples.back()), "ns");
+    }
+
+} // namespace Bench
+} // namespace TradeBookEngine
+
+#define TRADEBOOK_BENCHMARK(name) \
+    static void name(); \
+    static ::TradeBookEngine::Bench::Registrar name##_registrar(#name, &name); \
+    static void name()
@@ -0,0 +1,57 @@
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Publishers/AsyncEventPublisher.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Publishers;
+using namespace TradeBookEngine::Core::Services;
+
+namespace {
+
+    // Stands in for a slow downstream consumer (e.g. a broker round trip)
+    class SlowEventPublisher : public IEventPublisher {
+    public:
+        void Publish(const TradeBookEngine::Core::Events::TradeBookedEvent&) override {
+            auto until = Clock::now() + std::chrono::microseconds(5);
+            while (Clock::now() < until) {
+            }
+        }
+    };
+
+    double BookAll(TradeService& service, const std::vector<TradeDto>& dtos) {
+        auto start = Clock::now();
+        for (const auto& dto : dtos) {
+            service.BookTrade(dto);
+        }
+        return NanosPerOp(Clock::now() - start, dtos.size());
+    }
+
+} // namespace
+
+// BookTrade cost with a 5us-per-event consumer, inline versus behind the async decorator
+TRADEBOOK_BENCHMARK(AsyncPublisher) {
+    const std::size_t totalTrades = 50000;
+    std::vector<TradeDto> dtos;
+    dtos.reserve(totalTrades);
+    for (std::size_t i = 0; i < totalTrades; ++i) {
+        dtos.push_back(MakeEquityDto(i));
+    }
+
+    {
+        auto repository = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        TradeService service(repository, std::make_shared<SlowEventPublisher>());
+        Report("BookTrade/sync-slow-consumer", BookAll(service, dtos), "ns/trade");
+    }
+
+    for (auto policy : {BackpressurePolicy::Block, BackpressurePolicy::DropOldest}) {
+        auto repository = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        auto async = std::make_shared<AsyncEventPublisher>(std::make_shared<SlowEventPublisher>(), 1 << 16, policy);
+        TradeService service(repository, async);
+        double nanos = BookAll(service, dtos);
+        auto stats = async->GetStats();
+        Report(std::string("BookTrade/async-") + (policy == BackpressurePolicy::Block ? "block" : "drop-oldest")
+               + " (dropped " + std::to_string(stats.Dropped) + ")", nanos, "ns/trade");
+        async->Flush();
+    }
+}
@@ -0,0 +1,37 @@
+#include <algorithm>
+
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+
+// Per-trade cost of BookTrade against BookTrades at increasing batch sizes
+TRADEBOOK_BENCHMARK(BatchBooking) {
+    const std::size_t totalTrades = 200000;
+
+    std::vector<TradeDto> dtos;
+    dtos.reserve(totalTrades);
+    for (std::size_t i = 0; i < totalTrades; ++i) {
+        dtos.push_back(MakeEquityDto(i));
+    }
+
+    {
+        auto service = MakeService();
+        auto start = Clock::now();
+        for (const auto& dto : dtos) {
+            service->BookTrade(dto);
+        }
+        Report("BookTrade", NanosPerOp(Clock::now() - start, totalTrades), "ns/trade");
+    }
+
+    for (std::size_t batchSize : {std::size_t{1}, std::size_t{16}, std::size_t{256}, std::size_t{4096}}) {
+        auto service = MakeService();
+        auto start = Clock::now();
+        for (std::size_t offset = 0; offset < totalTrades; offset += batchSize) {
+            std::size_t count = std::min(batchSize, totalTrades - offset);
+            service->BookTrades(dtos.data() + offset, count);
+        }
+        Report("BookTrades/batch=" + std::to_string(batchSize),
+               NanosPerOp(Clock::now() - start, totalTrades), "ns/trade");
+    }
+}
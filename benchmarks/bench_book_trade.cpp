@@ -0,0 +1,98 @@
+#include <thread>
+
+#include "BenchCommon.hpp"
+
+extern "C" TradeBookEngine::Core::Interfaces::ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Services;
+
+namespace {
+
+    const std::size_t SeededTrades = 10000;
+
+    // Trades for one thread. hitPercent of them reuse the key of a seeded
+    // trade, so BookTrade returns the existing trade instead of booking.
+    std::vector<TradeDto> MakeFeed(std::size_t thread, std::size_t count, std::size_t hitPercent) {
+        std::vector<TradeDto> dtos;
+        dtos.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto dto = MakeEquityDto(thread * count + i);
+            if ((i * 37) % 100 < hitPercent) {
+                dto.IdempotencyKey = "seed-" + std::to_string((i * 7919) % SeededTrades);
+            } else {
+                dto.IdempotencyKey = "t" + std::to_string(thread) + "-" + std::to_string(i);
+            }
+            dtos.push_back(std::move(dto));
+        }
+        return dtos;
+    }
+
+    void Seed(TradeService& service) {
+        for (std::size_t i = 0; i < SeededTrades; ++i) {
+            auto dto = MakeEquityDto(i);
+            dto.IdempotencyKey = "seed-" + std::to_string(i);
+            service.BookTrade(dto);
+        }
+    }
+
+    // Books every feed on its own thread, timing each call
+    void Measure(const std::string& label, std::size_t threads, std::size_t perThread, std::size_t hitPercent) {
+        auto service = MakeService(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(16)));
+        Seed(*service);
+
+        std::vector<std::vector<TradeDto>> feeds;
+        std::vector<std::vector<std::uint64_t>> latencies(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            feeds.push_back(MakeFeed(t, perThread, hitPercent));
+            latencies[t].reserve(perThread);
+        }
+
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&service, &feeds, &latencies, t]() {
+                for (const auto& dto : feeds[t]) {
+                    auto before = Clock::now();
+                    service->BookTrade(dto);
+                    latencies[t].push_back(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count()));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto elapsed = Clock::now() - start;
+
+        std::vector<std::uint64_t> all;
+        all.reserve(threads * perThread);
+        for (const auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        Report(label, static_cast<double>(threads * perThread) /
+                      std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count(), "trades/s");
+        ReportLatency(label, all);
+    }
+
+} // namespace
+
+// BookTrade throughput and latency distribution over a 16-shard repository,
+// from one thread and several, as the share of idempotent retries grows.
+// Each call is timed separately, which adds the clock's cost (~20 ns).
+TRADEBOOK_BENCHMARK(BookTradeLatency) {
+    const std::size_t perThread = 100000;
+    for (std::size_t hitPercent : {std::size_t{0}, std::size_t{50}, std::size_t{90}}) {
+        Measure("BookTrade/threads=1/hits=" + std::to_string(hitPercent) + "%", 1, perThread, hitPercent);
+    }
+
+    std::size_t maxThreads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    for (std::size_t threads = 2; threads <= maxThreads; threads *= 2) {
+        for (std::size_t hitPercent : {std::size_t{0}, std::size_t{50}}) {
+            Measure("BookTrade/threads=" + std::to_string(threads) + "/hits=" + std::to_string(hitPercent) + "%",
+                    threads, perThread / threads, hitPercent);
+        }
+    }
+}
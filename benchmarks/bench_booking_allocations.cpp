@@ -0,0 +1,59 @@
+#include <algorithm>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Memory/SlabPool.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Services;
+using namespace TradeBookEngine::Core::Memory;
+
+namespace {
+
+    void MeasureBooking(const std::string& label, TradeAllocation allocation, std::size_t batchSize,
+                        const std::vector<TradeDto>& dtos) {
+        auto service = MakeService();
+        service->SetTradeAllocation(allocation);
+
+        auto before = ThreadAllocations();
+        auto start = Clock::now();
+        if (batchSize == 1) {
+            for (const auto& dto : dtos) {
+                service->BookTrade(dto);
+            }
+        } else {
+            for (std::size_t i = 0; i < dtos.size(); i += batchSize) {
+                std::size_t count = std::min(batchSize, dtos.size() - i);
+                service->BookTrades(dtos.data() + i, count);
+            }
+        }
+        auto elapsed = Clock::now() - start;
+        auto after = ThreadAllocations();
+
+        auto trades = static_cast<double>(dtos.size());
+        Report(label + " allocations/trade", static_cast<double>(after.Allocations - before.Allocations) / trades, "allocs");
+        Report(label + " heap/trade", static_cast<double>(after.Bytes - before.Bytes) / trades, "bytes");
+        Report(label, NanosPerOp(elapsed, dtos.size()), "ns/trade");
+    }
+
+} // namespace
+
+// Heap allocations the booking thread makes per booked trade, with trades
+// on the global heap and from the slab pool. Slab refills are counted, so
+// the pooled figures include the amortised cost of growing the pool.
+TRADEBOOK_BENCHMARK(BookingAllocations) {
+    const std::size_t tradeCount = 100000;
+    std::vector<TradeDto> dtos;
+    dtos.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        dtos.push_back(MakeEquityDto(i));
+    }
+
+    MeasureBooking("BookTrade/heap", TradeAllocation::Heap, 1, dtos);
+    MeasureBooking("BookTrade/pooled", TradeAllocation::Pooled, 1, dtos);
+    MeasureBooking("BookTrades/batch=256/heap", TradeAllocation::Heap, 256, dtos);
+    MeasureBooking("BookTrades/batch=256/pooled", TradeAllocation::Pooled, 256, dtos);
+
+    auto stats = SlabPool::GetStats();
+    Report("SlabPool reserved", static_cast<double>(stats.SlabBytes) / (1024.0 * 1024.0), "MiB");
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/BookingEngine.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Services;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+
+extern "C" {
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+}
+
+namespace {
+
+    const std::size_t TradeCount = 200000;
+    const std::size_t Producers = 4;
+
+    std::vector<std::vector<TradeDto>> MakeFeeds() {
+        std::vector<std::vector<TradeDto>> feeds(Producers);
+        for (std::size_t i = 0; i < TradeCount; ++i) {
+            feeds[i % Producers].push_back(MakeEquityDto(i, 1000));
+        }
+        return feeds;
+    }
+
+    double TradesPerSecond(Clock::duration elapsed) {
+        return static_cast<double>(TradeCount) /
+               std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+    }
+
+} // namespace
+
+// Booking throughput as workers are added. Four producer threads submit
+// 200k trades over 1,000 counterparties; the baseline has the same
+// producers call one TradeService over a 16-shard repository.
+TRADEBOOK_BENCHMARK(BookingEngineScaling) {
+    std::size_t cores = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::cout << "  hardware threads: " << cores << "\n";
+
+    {
+        auto feeds = MakeFeeds();
+        auto service = MakeService(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(16)));
+        auto start = Clock::now();
+        std::vector<std::thread> producers;
+        for (auto& feed : feeds) {
+            producers.emplace_back([&service, &feed]() {
+                for (const auto& dto : feed) {
+                    service->BookTrade(dto);
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        Report("TradeService direct/producers=4", TradesPerSecond(Clock::now() - start), "trades/s");
+    }
+
+    std::vector<std::size_t> workerCounts;
+    for (std::size_t workers = 1; workers <= std::max<std::size_t>(cores, 4); workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    if (workerCounts.back() != cores && cores > 4) {
+        workerCounts.push_back(cores);
+    }
+
+    for (std::size_t workers : workerCounts) {
+        auto feeds = MakeFeeds();
+        BookingEngineOptions options;
+        options.WorkerCount = workers;
+        for (std::size_t cpu = 0; cpu < cores; ++cpu) {
+            options.CpuAffinity.push_back(static_cast<int>(cpu));
+        }
+        options.ConfigureService = [](TradeService& service) {
+            service.AddValidator(std::shared_ptr<TradeBookEngine::Core::Validators::IAssetValidator>(CreateEquityValidator()));
+        };
+        std::atomic<std::uint64_t> booked{0};
+        std::uint64_t batches = 0;
+        Clock::duration elapsed;
+        {
+            BookingEngine engine(std::make_shared<NullEventPublisher>(), options);
+            auto start = Clock::now();
+            std::vector<std::thread> producers;
+            for (auto& feed : feeds) {
+                producers.emplace_back([&engine, &feed, &booked]() {
+                    for (auto& dto : feed) {
+                        engine.Submit(std::move(dto), [&booked](const BookingResult& result) {
+                            if (result.Status == BookingStatus::Booked) {
+                                booked.fetch_add(1, std::memory_order_relaxed);
+                            }
+                        });
+                    }
+                });
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            engine.Flush();
+            elapsed = Clock::now() - start;
+            for (const auto& worker : engine.GetStats()) {
+                batches += worker.Batches;
+            }
+        }
+        std::string name = "BookingEngine/workers=" + std::to_string(workers);
+        Report(name, TradesPerSecond(elapsed), "trades/s");
+        Report(name + " trades/batch",
+               static_cast<double>(booked.load()) / static_cast<double>(std::max<std::uint64_t>(batches, 1)), "trades",
+               Better::Higher);
+        KeepAlive(booked.load());
+    }
+}
@@ -0,0 +1,106 @@
+#include <ctime>
+#include <set>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Calendars/HolidayCalendar.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Calendars;
+using TradeBookEngine::Core::Utils::DateTimeUtils;
+
+namespace {
+
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    // DateTimeUtils::AddBusinessDays before calendars: one localtime call
+    // per calendar day
+    TimePoint LegacyAddBusinessDays(TimePoint current, int businessDays) {
+        int daysAdded = 0;
+        while (daysAdded < businessDays) {
+            current += std::chrono::hours(24);
+            auto seconds = std::chrono::system_clock::to_time_t(current);
+            auto tm = *std::localtime(&seconds);
+            if (tm.tm_wday != 0 && tm.tm_wday != 6) {
+                daysAdded++;
+            }
+        }
+        return current;
+    }
+
+    // The same walk with a holiday set, as a calendar without tables would do
+    Day WalkAddBusinessDays(const std::set<Day>& holidays, Day day, int businessDays) {
+        while (businessDays > 0) {
+            ++day;
+            unsigned weekday = static_cast<unsigned>(((day % 7) + 11) % 7);
+            if (weekday != 0 && weekday != 6 && holidays.count(day) == 0) {
+                --businessDays;
+            }
+        }
+        return day;
+    }
+
+    template <typename Step>
+    void Measure(const std::string& name, std::size_t count, Step&& step) {
+        std::int64_t sink = 0;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            sink += step(i);
+        }
+        Report(name, NanosPerOp(Clock::now() - start, count));
+        KeepAlive(static_cast<std::uint64_t>(sink));
+    }
+
+} // namespace
+
+// Settlement (T+2) and coupon-style (T+250) date arithmetic over a spread of
+// trade dates, against a calendar with ten holidays a year
+TRADEBOOK_BENCHMARK(Calendars) {
+    const std::size_t count = 200000;
+    const Day base = static_cast<Day>(DateTimeUtils::DaysFromCivil(2020, 1, 1));
+
+    std::vector<Day> holidayList;
+    for (int year = 1990; year < 2100; ++year) {
+        for (unsigned month = 1; month <= 10; ++month) {
+            holidayList.push_back(static_cast<Day>(DateTimeUtils::DaysFromCivil(year, month, 11)));
+        }
+    }
+    std::set<Day> holidaySet(holidayList.begin(), holidayList.end());
+
+    auto buildStart = Clock::now();
+    HolidayCalendar calendar("BENCH", holidayList);
+    Report("Build 300-year tables", static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - buildStart).count()), "us");
+
+    std::vector<Day> days(count);
+    std::vector<TimePoint> times(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        days[i] = base + static_cast<Day>((i * 7919) % 3650);
+        times[i] = HolidayCalendar::FromDay(days[i]) + std::chrono::hours(9);
+    }
+
+    for (int lag : {2, 250}) {
+        std::string suffix = " T+" + std::to_string(lag);
+        // The walks cost a day each, so long ones run on a sample
+        std::size_t walkCount = lag > 10 ? count / 100 : count;
+        Measure("Legacy localtime loop" + suffix, walkCount, [&](std::size_t i) {
+            return LegacyAddBusinessDays(times[i], lag).time_since_epoch().count();
+        });
+        Measure("Holiday set walk" + suffix, walkCount, [&](std::size_t i) {
+            return static_cast<std::int64_t>(WalkAddBusinessDays(holidaySet, days[i], lag));
+        });
+        Measure("Table AddBusinessDays" + suffix, count, [&](std::size_t i) {
+            return static_cast<std::int64_t>(calendar.AddBusinessDays(days[i], lag));
+        });
+        Measure("Table AddBusinessDays time_point" + suffix, count, [&](std::size_t i) {
+            return calendar.AddBusinessDays(times[i], lag).time_since_epoch().count();
+        });
+    }
+
+    Measure("Table BusinessDaysBetween 1y", count, [&](std::size_t i) {
+        return static_cast<std::int64_t>(calendar.BusinessDaysBetween(days[i], days[i] + 365));
+    });
+    Measure("Table Roll ModifiedFollowing", count, [&](std::size_t i) {
+        return static_cast<std::int64_t>(calendar.Roll(days[i], RollConvention::ModifiedFollowing));
+    });
+}
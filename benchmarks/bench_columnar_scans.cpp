@@ -0,0 +1,85 @@
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Analytics/ColumnarTradeStore.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Analytics;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+namespace {
+
+    double Millis(Clock::duration elapsed) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000.0;
+    }
+
+} // namespace
+
+// End-of-day style exposure totals over raw columns of 20M rows
+TRADEBOOK_BENCHMARK(ColumnKernels) {
+    const std::size_t rows = 20000000;
+    std::vector<double> notional(rows);
+    std::vector<std::uint8_t> side(rows);
+    std::vector<std::uint8_t> assetClass(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        notional[i] = static_cast<double>(1000 + (i * 7919) % 1000000);
+        side[i] = static_cast<std::uint8_t>(i & 1);
+        assetClass[i] = static_cast<std::uint8_t>(i % AssetClassCount);
+    }
+    std::cout << "  kernels: " << Kernels::ActiveInstructionSet() << "\n";
+
+    auto start = Clock::now();
+    double total = Kernels::Sum(notional.data(), rows);
+    Report("Sum/rows=20M", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    double buys = Kernels::SumWhereEquals(notional.data(), side.data(), rows, 0);
+    Report("SumWhereEquals/rows=20M", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    auto range = Kernels::MinMax(notional.data(), rows);
+    Report("MinMax/rows=20M", Millis(Clock::now() - start), "ms");
+
+    std::uint64_t counts[Kernels::KeyBuckets] = {};
+    start = Clock::now();
+    Kernels::CountByKey(assetClass.data(), rows, counts);
+    Report("CountByKey/rows=20M", Millis(Clock::now() - start), "ms");
+
+    double sums[Kernels::KeyBuckets] = {};
+    start = Clock::now();
+    Kernels::SumByKey(notional.data(), assetClass.data(), rows, sums);
+    Report("SumByKey/rows=20M", Millis(Clock::now() - start), "ms");
+
+    KeepAlive(static_cast<std::uint64_t>(total + buys + range.Max + sums[0]) + counts[1]);
+}
+
+// Notional by side through the repository-fed store versus walking GetAll
+TRADEBOOK_BENCHMARK(ColumnarStoreVsGetAll) {
+    const std::size_t bookSize = 1000000;
+    auto repo = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+    auto store = std::make_shared<ColumnarTradeStore>();
+    repo->AddListener(store);
+
+    auto now = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < bookSize; ++i) {
+        repo->Save(std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity, "AAPL",
+            "CP-" + std::to_string(i % 1000), static_cast<double>(1000 + i % 5000), "USD",
+            (i & 1) ? TradeSide::Sell : TradeSide::Buy, now, now, "bench"));
+    }
+
+    auto start = Clock::now();
+    double buy = 0.0, sell = 0.0;
+    for (const auto& trade : repo->GetAll()) {
+        (trade->GetSide() == TradeSide::Buy ? buy : sell) += trade->GetNotional();
+    }
+    Report("GetAll+loop NotionalBySide/book=1M", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    auto exposure = store->NotionalBySide();
+    Report("ColumnarTradeStore NotionalBySide/book=1M", Millis(Clock::now() - start), "ms");
+
+    if (exposure.Buy != buy || exposure.Sell != sell) {
+        std::cerr << "columnar totals disagree with GetAll" << std::endl;
+    }
+    KeepAlive(static_cast<std::uint64_t>(exposure.Buy + buy));
+}
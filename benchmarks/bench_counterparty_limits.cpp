@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Risk/CounterpartyLimits.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+
+namespace {
+
+    const std::size_t CounterpartyCount = 1000000;
+
+    double BookFeed(const std::vector<TradeDto>& dtos, const std::shared_ptr<Risk::CounterpartyLimits>& limits) {
+        auto service = MakeService();
+        service->SetMetricsEnabled(false);
+        service->SetCounterpartyLimits(limits);
+        std::uint64_t booked = 0;
+        auto start = Clock::now();
+        for (const auto& dto : dtos) {
+            booked += service->TryBookTrade(dto).Succeeded() ? 1u : 0u;
+        }
+        auto elapsed = Clock::now() - start;
+        KeepAlive(booked);
+        return NanosPerOp(elapsed, dtos.size());
+    }
+
+} // namespace
+
+// Reserve and commit against 1M counterparties with limits, in random order
+// so most lookups miss the cache, against 1,000 that stay cached, and with
+// every thread on one counterparty. The end-to-end runs book across the same 1M counterparties
+// with the check on and off, alternating and keeping the best of four.
+TRADEBOOK_BENCHMARK(CounterpartyLimitCheck) {
+    std::unordered_map<std::string, double> limitFile;
+    std::vector<Symbols::SymbolId> ids;
+    limitFile.reserve(CounterpartyCount);
+    ids.reserve(CounterpartyCount);
+    for (std::size_t i = 0; i < CounterpartyCount; ++i) {
+        auto name = "CP-" + std::to_string(i);
+        ids.push_back(Symbols::Intern(name));
+        limitFile.emplace(std::move(name), 1e12);
+    }
+    auto limits = std::make_shared<Risk::CounterpartyLimits>();
+    auto start = Clock::now();
+    limits->ReloadLimits(limitFile);
+    Report("ReloadLimits/counterparties=1M", static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - start).count()), "ms");
+
+    const std::size_t iterations = 2000000;
+    std::vector<Symbols::SymbolId> order(iterations);
+    std::mt19937_64 rng(7);
+    for (auto& id : order) {
+        id = ids[std::uniform_int_distribution<std::size_t>(0, CounterpartyCount - 1)(rng)];
+    }
+    std::uint64_t accepted = 0;
+    start = Clock::now();
+    for (auto id : order) {
+        if (limits->Reserve(id, 1000.0)) {
+            limits->Commit(id, 1000.0);
+            ++accepted;
+        }
+    }
+    Report("Reserve+Commit/counterparties=1M", NanosPerOp(Clock::now() - start, iterations), "ns/trade");
+
+    // The same over 1,000 counterparties, whose counters stay in cache
+    for (auto& id : order) {
+        id = ids[std::uniform_int_distribution<std::size_t>(0, 999)(rng)];
+    }
+    start = Clock::now();
+    for (auto id : order) {
+        if (limits->Reserve(id, 1000.0)) {
+            limits->Commit(id, 1000.0);
+            ++accepted;
+        }
+    }
+    Report("Reserve+Commit/counterparties=1000", NanosPerOp(Clock::now() - start, iterations), "ns/trade");
+    KeepAlive(accepted);
+
+    unsigned threadCount = std::max(2u, std::thread::hardware_concurrency());
+    const std::size_t perThread = 500000;
+    limits->SetLimit("CP-0", 1e15);
+    start = Clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&limits, &ids, perThread]() {
+            for (std::size_t i = 0; i < perThread; ++i) {
+                if (limits->Reserve(ids[0], 1.0)) {
+                    limits->Commit(ids[0], 1.0);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Report("Reserve+Commit/one counterparty/threads=" + std::to_string(threadCount),
+           NanosPerOp(Clock::now() - start, perThread * threadCount), "ns/trade");
+
+    const std::size_t tradeCount = 200000;
+    std::vector<TradeDto> dtos;
+    dtos.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        auto dto = MakeEquityDto(i);
+        dto.Counterparty = "CP-" + std::to_string(std::uniform_int_distribution<std::size_t>(0, CounterpartyCount - 1)(rng));
+        dtos.push_back(std::move(dto));
+    }
+    double on = 1e300, off = 1e300;
+    for (int round = 0; round < 4; ++round) {
+        bool limitsFirst = round % 2 == 1;
+        double first = BookFeed(dtos, limitsFirst ? limits : nullptr);
+        double second = BookFeed(dtos, limitsFirst ? nullptr : limits);
+        on = std::min(on, limitsFirst ? first : second);
+        off = std::min(off, limitsFirst ? second : first);
+    }
+    Report("TryBookTrade/limits=off", off, "ns/trade");
+    Report("TryBookTrade/limits=on", on, "ns/trade");
+}
@@ -0,0 +1,87 @@
+#include <set>
+#include <unordered_map>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/CurrencyCode.hpp"
+#include "TradeBookEngine/Core/Analytics/ColumnarTradeStore.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Analytics;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+using TradeBookEngine::Core::Utils::ValidationUtils;
+
+namespace {
+
+    // ValidationUtils::IsValidCurrency before CurrencyCode
+    bool LegacyIsValidCurrency(const std::string& currency) {
+        static std::set<std::string> validCurrencies = {
+            "USD", "EUR", "GBP", "JPY", "CHF", "CAD", "AUD", "NZD", "SEK", "NOK", "DKK"
+        };
+        return validCurrencies.find(currency) != validCurrencies.end();
+    }
+
+    template <typename Check>
+    void Measure(const std::string& name, const std::vector<std::string>& inputs, std::size_t count, Check&& check) {
+        std::uint64_t valid = 0;
+        auto before = ThreadAllocations();
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            valid += check(inputs[i % inputs.size()]) ? 1u : 0u;
+        }
+        auto elapsed = Clock::now() - start;
+        auto after = ThreadAllocations();
+        Report(name, NanosPerOp(elapsed, count));
+        Report(name + " allocations/op",
+               static_cast<double>(after.Allocations - before.Allocations) / static_cast<double>(count), "allocs");
+        KeepAlive(valid);
+    }
+
+    double Millis(Clock::duration elapsed) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000.0;
+    }
+
+} // namespace
+
+// Currency validation on a mixed feed, and per-currency exposure over a book
+TRADEBOOK_BENCHMARK(CurrencyCodes) {
+    const std::size_t count = 5000000;
+    std::vector<std::string> inputs = {"USD", "EUR", "JPY", "DKK", "INR", "XYZ", "usd", "GBP"};
+
+    Measure("IsValidCurrency/legacy std::set", inputs, count, [](const std::string& currency) {
+        return LegacyIsValidCurrency(currency);
+    });
+    Measure("IsValidCurrency/CurrencyCode", inputs, count, [](const std::string& currency) {
+        return ValidationUtils::IsValidCurrency(currency);
+    });
+
+    const std::size_t bookSize = 500000;
+    const char* currencies[] = {"USD", "EUR", "GBP", "JPY", "CHF", "CAD", "AUD", "HKD", "SGD", "INR"};
+    auto repo = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+    auto store = std::make_shared<ColumnarTradeStore>();
+    repo->AddListener(store);
+    auto service = MakeService(repo);
+    std::vector<TradeDto> dtos;
+    dtos.reserve(bookSize);
+    for (std::size_t i = 0; i < bookSize; ++i) {
+        dtos.push_back(MakeEquityDto(i));
+        dtos.back().Currency = currencies[i % 10];
+    }
+    service->BookTrades(dtos);
+
+    // The string-keyed way: walk the book and hash each currency
+    auto start = Clock::now();
+    std::unordered_map<std::string, double> byName;
+    repo->ForEach(TradePredicate(), [&byName](const Trade& trade) {
+        byName[trade.GetCurrency()] += trade.GetNotional();
+        return true;
+    });
+    Report("Notional by currency/ForEach + string map", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    auto byIndex = store->NotionalByCurrency();
+    Report("Notional by currency/columnar ISO index", Millis(Clock::now() - start), "ms");
+
+    KeepAlive(static_cast<std::uint64_t>(byName["USD"] + byIndex[static_cast<std::size_t>(CurrencyCode("USD").IsoIndex())]));
+}
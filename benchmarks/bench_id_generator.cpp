@@ -0,0 +1,50 @@
+#include <thread>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Utils;
+
+TRADEBOOK_BENCHMARK(IdGeneration) {
+    const std::size_t iterations = 1000000;
+
+    {
+        auto& generator = SnowflakeIdGenerator::Default();
+        std::uint64_t sink = 0;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            sink ^= generator.Next();
+        }
+        Report("SnowflakeIdGenerator::Next", NanosPerOp(Clock::now() - start, iterations));
+        KeepAlive(sink);
+    }
+
+    {
+        std::size_t totalLength = 0;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            totalLength += IdGenerator::GenerateTradeId().size();
+        }
+        Report("IdGenerator::GenerateTradeId", NanosPerOp(Clock::now() - start, iterations));
+        KeepAlive(totalLength);
+    }
+
+    std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    {
+        std::vector<std::thread> workers;
+        auto start = Clock::now();
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([iterations]() {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    IdGenerator::GenerateTradeId();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        Report("IdGenerator::GenerateTradeId/threads=" + std::to_string(threads),
+               NanosPerOp(Clock::now() - start, iterations * threads));
+    }
+}
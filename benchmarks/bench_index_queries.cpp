@@ -0,0 +1,33 @@
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+// GetByCounterparty with a fixed ~100-trade result as the book grows;
+// indexed lookups should stay flat
+TRADEBOOK_BENCHMARK(CounterpartyQuery) {
+    const std::size_t tradesPerCounterparty = 100;
+    auto now = std::chrono::system_clock::now();
+
+    for (std::size_t bookSize : {std::size_t{10000}, std::size_t{100000}, std::size_t{1000000}}) {
+        auto repo = std::unique_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        std::size_t counterparties = bookSize / tradesPerCounterparty;
+        for (std::size_t i = 0; i < bookSize; ++i) {
+            repo->Save(std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity, "AAPL",
+                "CP-" + std::to_string(i % counterparties), 1000.0, "USD", TradeSide::Buy, now, now, "bench"));
+        }
+
+        const std::size_t queries = 2000;
+        std::size_t found = 0;
+        auto start = Clock::now();
+        for (std::size_t q = 0; q < queries; ++q) {
+            found += repo->GetByCounterparty("CP-" + std::to_string((q * 31) % counterparties)).size();
+        }
+        Report("GetByCounterparty/book=" + std::to_string(bookSize), NanosPerOp(Clock::now() - start, queries), "ns/query");
+        if (found != queries * tradesPerCounterparty) {
+            std::cerr << "unexpected result size " << found << std::endl;
+        }
+    }
+}
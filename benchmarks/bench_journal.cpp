@@ -0,0 +1,83 @@
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Repositories/JournalTradeRepository.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Repositories;
+
+namespace {
+
+    // Journals go to TRADEBOOK_JOURNAL_DIR so the benchmark can target a real
+    // disk; the temp directory is often tmpfs, where fdatasync is free
+    std::filesystem::path JournalDirectory() {
+        const char* configured = std::getenv("TRADEBOOK_JOURNAL_DIR");
+        return configured ? std::filesystem::path(configured) : std::filesystem::temp_directory_path();
+    }
+
+    void MeasureJournal(const std::string& label, std::size_t threads, std::size_t batchSize,
+                        std::chrono::microseconds commitDelay, const std::vector<TradeDto>& dtos) {
+        auto path = JournalDirectory() / "tradebook_bench.journal";
+        std::filesystem::remove(path);
+
+        JournalOptions options;
+        options.Path = path.string();
+        options.CommitDelay = commitDelay;
+        auto journal = std::make_shared<JournalTradeRepository>(options);
+        auto service = MakeService(journal);
+
+        std::size_t perThread = dtos.size() / threads;
+        std::vector<std::thread> workers;
+        auto start = Clock::now();
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&service, &dtos, t, perThread, batchSize]() {
+                const TradeDto* first = dtos.data() + t * perThread;
+                for (std::size_t i = 0; i < perThread; i += batchSize) {
+                    if (batchSize == 1) {
+                        service->BookTrade(first[i]);
+                    } else {
+                        service->BookTrades(first + i, std::min(batchSize, perThread - i));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto elapsed = Clock::now() - start;
+
+        auto stats = journal->GetStats();
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        Report(label, static_cast<double>(perThread * threads) / seconds, "trades/s");
+        Report(label + " records/commit",
+               stats.Commits == 0 ? 0.0 : static_cast<double>(stats.Records) / static_cast<double>(stats.Commits),
+               "records", Better::Higher);
+
+        service.reset();
+        journal.reset();
+        std::filesystem::remove(path);
+    }
+
+} // namespace
+
+// Durable booking throughput through JournalTradeRepository. Every BookTrade
+// returns only after its record is synced; concurrent callers share syncs.
+TRADEBOOK_BENCHMARK(Journal) {
+    const std::size_t tradeCount = 64000;
+    std::vector<TradeDto> dtos;
+    dtos.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        dtos.push_back(MakeEquityDto(i));
+    }
+
+    std::cout << "  journal directory: " << JournalDirectory().string() << "\n";
+    MeasureJournal("BookTrade/threads=1", 1, 1, std::chrono::microseconds(0),
+                   std::vector<TradeDto>(dtos.begin(), dtos.begin() + 4000));
+    MeasureJournal("BookTrade/threads=64", 64, 1, std::chrono::microseconds(0), dtos);
+    MeasureJournal("BookTrade/threads=64/delay=100us", 64, 1, std::chrono::microseconds(100), dtos);
+    MeasureJournal("BookTrades/threads=4/batch=256", 4, 256, std::chrono::microseconds(0), dtos);
+}
@@ -0,0 +1,152 @@
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "BenchCommon.hpp"
+
+namespace TradeBookEngine {
+namespace Bench {
+
+    std::vector<BenchmarkCase>& Registry() {
+        static std::vector<BenchmarkCase> cases;
+        return cases;
+    }
+
+    namespace {
+
+        struct Result {
+            std::string Benchmark;
+            std::string Name;
+            double Value;
+            std::string Unit;
+            Better Direction;
+        };
+
+        std::vector<Result>& Results() {
+            static std::vector<Result> results;
+            return results;
+        }
+
+        const char* CurrentBenchmark = "";
+
+        std::string JsonString(const std::string& text) {
+            std::string out = "\"";
+            for (char c : text) {
+                switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out += escaped;
+                    } else {
+                        out += c;
+                    }
+                }
+            }
+            return out + "\"";
+        }
+
+        // Unless the benchmark said otherwise, rates ("trades/s",
+        // "lookups/s") improve upwards; times, sizes and allocation counts
+        // improve downwards
+        bool HigherIsBetter(const Result& result) {
+            if (result.Direction != Better::ByUnit) {
+                return result.Direction == Better::Higher;
+            }
+            const auto& unit = result.Unit;
+            return unit.size() >= 2 && unit.compare(unit.size() - 2, 2, "/s") == 0;
+        }
+
+        bool WriteJson(const std::string& path) {
+            std::ofstream out(path);
+            if (!out) {
+                return false;
+            }
+            char timestamp[32];
+            std::time_t now = std::time(nullptr);
+            std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            out << "{\n";
+            out << "  \"schema\": 1,\n";
+            out << "  \"timestamp\": " << JsonString(timestamp) << ",\n";
+#if defined(__VERSION__)
+            out << "  \"compiler\": " << JsonString(__VERSION__) << ",\n";
+#elif defined(_MSC_FULL_VER)
+            out << "  \"compiler\": " << JsonString("MSVC " + std::to_string(_MSC_FULL_VER)) << ",\n";
+#endif
+#ifdef NDEBUG
+            out << "  \"assertions\": false,\n";
+#else
+            out << "  \"assertions\": true,\n";
+#endif
+            out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+            out << "  \"results\": [";
+            const auto& results = Results();
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const auto& result = results[i];
+                out << (i == 0 ? "\n" : ",\n")
+                    << "    {\"benchmark\": " << JsonString(result.Benchmark)
+                    << ", \"name\": " << JsonString(result.Name)
+                    << ", \"value\": " << std::setprecision(17) << std::defaultfloat << result.Value
+                    << ", \"unit\": " << JsonString(result.Unit)
+                    << ", \"better\": \"" << (HigherIsBetter(result) ? "higher" : "lower") << "\"}";
+            }
+            out << "\n  ]\n}\n";
+            return static_cast<bool>(out);
+        }
+
+    } // namespace
+
+    void RecordResult(const std::string& name, double value, const std::string& unit, Better better) {
+        Results().push_back(Result{CurrentBenchmark, name, value, unit, better});
+    }
+
+} // namespace Bench
+} // namespace TradeBookEngine
+
+using namespace TradeBookEngine::Bench;
+
+// Usage: tradebook_bench [--list] [--json results.json] [name-filter]
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            for (const auto& benchmark : Registry()) {
+                std::cout << benchmark.Name << "\n";
+            }
+            return 0;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    int ran = 0;
+    for (const auto& benchmark : Registry()) {
+        if (filter && std::strstr(benchmark.Name, filter) == nullptr) {
+            continue;
+        }
+        std::cout << "[" << benchmark.Name << "]\n";
+        CurrentBenchmark = benchmark.Name;
+        benchmark.Run();
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::cerr << "No benchmark matches '" << (filter ? filter : "") << "'" << std::endl;
+        return 1;
+    }
+    if (jsonPath && !WriteJson(jsonPath)) {
+        std::cerr << "Cannot write " << jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
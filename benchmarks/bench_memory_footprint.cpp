@@ -0,0 +1,117 @@
+#include <unordered_map>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/SymbolTable.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+
+namespace {
+
+    // Field layout of Trade before reference data was interned
+    struct LegacyTrade {
+        std::string TradeId;
+        AssetClass Asset;
+        std::string InstrumentId;
+        std::string Counterparty;
+        double Notional;
+        std::string Currency;
+        TradeSide Side;
+        std::chrono::system_clock::time_point TradeDate;
+        std::chrono::system_clock::time_point SettlementDate;
+        std::unordered_map<std::string, std::string> Additional;
+        std::string IdempotencyKey;
+        std::string CorrelationId;
+        std::string CreatedBy;
+        std::chrono::system_clock::time_point CreatedAt;
+        TradeStatus Status;
+    };
+
+    struct ReferenceData {
+        std::vector<std::string> Counterparties;
+        std::vector<std::string> Instruments;
+        std::vector<std::string> Users;
+    };
+
+    ReferenceData MakeReferenceData() {
+        ReferenceData data;
+        for (int i = 0; i < 500; ++i) {
+            data.Counterparties.push_back("Counterparty Bank International " + std::to_string(i));
+        }
+        for (int i = 0; i < 5000; ++i) {
+            auto digits = std::to_string(100000000 + i);
+            data.Instruments.push_back("US" + digits + "0");
+        }
+        for (int i = 0; i < 20; ++i) {
+            data.Users.push_back("allocation-engine-eu-" + std::to_string(i));
+        }
+        return data;
+    }
+
+} // namespace
+
+// Heap bytes per trade for the legacy string layout against interned symbols
+TRADEBOOK_BENCHMARK(TradeMemoryFootprint) {
+    const std::size_t tradeCount = 200000;
+    auto data = MakeReferenceData();
+    auto now = std::chrono::system_clock::now();
+
+    std::vector<std::string> tradeIds;
+    tradeIds.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        tradeIds.push_back(Utils::IdGenerator::GenerateTradeId());
+    }
+
+    {
+        std::vector<std::shared_ptr<LegacyTrade>> trades;
+        trades.reserve(tradeCount);
+        auto before = ThreadAllocations();
+        for (std::size_t i = 0; i < tradeCount; ++i) {
+            auto trade = std::make_shared<LegacyTrade>();
+            trade->TradeId = tradeIds[i];
+            trade->InstrumentId = data.Instruments[i % data.Instruments.size()];
+            trade->Counterparty = data.Counterparties[i % data.Counterparties.size()];
+            trade->Currency = "USD";
+            trade->CreatedBy = data.Users[i % data.Users.size()];
+            trade->TradeDate = trade->SettlementDate = trade->CreatedAt = now;
+            trade->Additional["Exchange"] = "NASDAQ";
+            trades.push_back(std::move(trade));
+        }
+        auto after = ThreadAllocations();
+        Report("LegacyTrade sizeof", static_cast<double>(sizeof(LegacyTrade)), "bytes");
+        Report("LegacyTrade heap/trade",
+               static_cast<double>(after.Bytes - before.Bytes) / static_cast<double>(tradeCount), "bytes");
+        Report("LegacyTrade allocations/trade",
+               static_cast<double>(after.Allocations - before.Allocations) / static_cast<double>(tradeCount), "allocs");
+    }
+
+    {
+        auto& symbols = Symbols::SymbolTable::Instance();
+        std::size_t symbolBytesBefore = symbols.MemoryUsage();
+
+        std::vector<std::shared_ptr<Trade>> trades;
+        trades.reserve(tradeCount);
+        auto before = ThreadAllocations();
+        for (std::size_t i = 0; i < tradeCount; ++i) {
+            auto trade = std::make_shared<Trade>(tradeIds[i], AssetClass::Equity,
+                data.Instruments[i % data.Instruments.size()],
+                data.Counterparties[i % data.Counterparties.size()], 1000.0, "USD", TradeSide::Buy,
+                now, now, data.Users[i % data.Users.size()]);
+            trade->AddAdditionalData("Exchange", "NASDAQ");
+            trades.push_back(std::move(trade));
+        }
+        auto after = ThreadAllocations();
+        std::size_t symbolBytes = symbols.MemoryUsage() - symbolBytesBefore;
+
+        Report("Trade sizeof", static_cast<double>(sizeof(Trade)), "bytes");
+        Report("Trade heap/trade (incl. new symbols)",
+               static_cast<double>(after.Bytes - before.Bytes) / static_cast<double>(tradeCount), "bytes");
+        Report("Trade allocations/trade (incl. new symbols)",
+               static_cast<double>(after.Allocations - before.Allocations) / static_cast<double>(tradeCount), "allocs");
+        Report("SymbolTable growth for " + std::to_string(tradeCount) + " trades",
+               static_cast<double>(symbolBytes) / 1024.0, "KiB");
+    }
+}
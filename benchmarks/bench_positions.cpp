@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Analytics/PositionKeeper.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Analytics;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+namespace {
+
+    double Millis(Clock::duration elapsed) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000.0;
+    }
+
+    double BookFeed(const std::vector<TradeDto>& dtos, bool keepPositions) {
+        auto repo = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        if (keepPositions) {
+            repo->AddListener(std::make_shared<PositionKeeper>());
+        }
+        auto service = MakeService(repo);
+        service->SetMetricsEnabled(false);
+        std::uint64_t booked = 0;
+        auto start = Clock::now();
+        for (const auto& dto : dtos) {
+            booked += service->TryBookTrade(dto).Succeeded() ? 1u : 0u;
+        }
+        auto elapsed = Clock::now() - start;
+        KeepAlive(booked);
+        return NanosPerOp(elapsed, dtos.size());
+    }
+
+} // namespace
+
+// What keeping positions adds to a booking: the listener call on its own,
+// then whole bookings with and without it, alternating the order of the
+// runs and keeping the best of four
+TRADEBOOK_BENCHMARK(PositionKeeperBooking) {
+    {
+        const std::size_t count = 200000;
+        auto now = std::chrono::system_clock::now();
+        std::vector<std::shared_ptr<Trade>> trades;
+        trades.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            trades.push_back(std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity,
+                "EQ-" + std::to_string(i % 500), "CP-" + std::to_string(i % 10000), 1000.0, "USD",
+                (i & 1) ? TradeSide::Sell : TradeSide::Buy, now, now, "bench"));
+        }
+        PositionKeeper positions;
+        std::shared_ptr<Trade> none;
+        auto start = Clock::now();
+        for (const auto& trade : trades) {
+            positions.OnTradeSaved(trade, none);
+        }
+        Report("OnTradeSaved", NanosPerOp(Clock::now() - start, count), "ns/trade");
+        KeepAlive(static_cast<std::uint64_t>(positions.ByCurrency("USD").Trades));
+    }
+
+    const std::size_t tradeCount = 200000;
+    std::vector<TradeDto> dtos;
+    dtos.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        dtos.push_back(MakeEquityDto(i, 10000));
+    }
+    double with = 1e300, without = 1e300;
+    for (int round = 0; round < 4; ++round) {
+        bool positionsFirst = round % 2 == 1;
+        double first = BookFeed(dtos, positionsFirst);
+        double second = BookFeed(dtos, !positionsFirst);
+        with = std::min(with, positionsFirst ? first : second);
+        without = std::min(without, positionsFirst ? second : first);
+    }
+    Report("TryBookTrade/positions=off", without, "ns/trade");
+    Report("TryBookTrade/positions=on", with, "ns/trade");
+}
+
+// Net notional per counterparty from the keeper versus walking GetAll
+TRADEBOOK_BENCHMARK(PositionKeeperVsGetAll) {
+    const std::size_t bookSize = 1000000;
+    const std::size_t counterparties = 10000;
+    auto repo = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+    auto positions = std::make_shared<PositionKeeper>();
+    repo->AddListener(positions);
+
+    auto now = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < bookSize; ++i) {
+        repo->Save(std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity,
+            "EQ-" + std::to_string(i % 5000), "CP-" + std::to_string(i % counterparties),
+            static_cast<double>(1000 + i % 5000), "USD", (i & 1) ? TradeSide::Sell : TradeSide::Buy, now, now,
+            "bench"));
+    }
+
+    auto start = Clock::now();
+    std::unordered_map<std::string, double> byCounterparty;
+    for (const auto& trade : repo->GetAll()) {
+        double notional = trade->GetNotional();
+        byCounterparty[trade->GetCounterparty()] += trade->GetSide() == TradeSide::Buy ? notional : -notional;
+    }
+    Report("GetAll+loop net by counterparty/book=1M", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    auto snapshot = positions->Snapshot();
+    Report("PositionKeeper Snapshot/book=1M", Millis(Clock::now() - start), "ms");
+
+    const std::size_t lookups = 1000000;
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < counterparties; ++i) {
+        names.push_back("CP-" + std::to_string(i));
+    }
+    double sink = 0.0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        sink += positions->ByCounterparty(names[i % counterparties]).NetNotional;
+    }
+    Report("PositionKeeper ByCounterparty", NanosPerOp(Clock::now() - start, lookups), "ns/lookup");
+
+    const auto& entries = snapshot.Of(PositionDimension::Counterparty);
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        sink += positions->Get(PositionDimension::Counterparty, entries[i % entries.size()].Key).NetNotional;
+    }
+    Report("PositionKeeper Get by SymbolId", NanosPerOp(Clock::now() - start, lookups), "ns/lookup");
+
+    if (entries.size() != byCounterparty.size()) {
+        std::cerr << "position keeper disagrees with GetAll" << std::endl;
+    }
+    KeepAlive(static_cast<std::uint64_t>(sink) + entries.size());
+}
@@ -0,0 +1,66 @@
+#include <stdexcept>
+
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Services;
+
+namespace {
+
+    // Every (100 / rejectPercent)-th trade lacks its Exchange and is rejected
+    std::vector<TradeDto> MakeFeed(std::size_t count, std::size_t rejectPercent) {
+        std::vector<TradeDto> dtos;
+        dtos.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto dto = MakeEquityDto(i);
+            if ((i * rejectPercent) % 100 + rejectPercent >= 100) {
+                dto.Additional = AttributeMap();
+            }
+            dtos.push_back(std::move(dto));
+        }
+        return dtos;
+    }
+
+    template <typename Book>
+    void MeasureFeed(const std::string& label, const std::vector<TradeDto>& dtos, Book&& book) {
+        auto service = MakeService();
+        std::uint64_t rejected = 0;
+        auto start = Clock::now();
+        for (const auto& dto : dtos) {
+            rejected += book(*service, dto) ? 0u : 1u;
+        }
+        Report(label, NanosPerOp(Clock::now() - start, dtos.size()), "ns/trade");
+        KeepAlive(rejected);
+    }
+
+} // namespace
+
+// BookTrade with try/catch against TryBookTrade on feeds with a rising
+// share of rejected trades. "+message" also renders each rejection's text.
+TRADEBOOK_BENCHMARK(RejectPaths) {
+    const std::size_t tradeCount = 100000;
+    for (std::size_t rejectPercent : {0u, 10u, 30u, 50u, 100u}) {
+        auto dtos = MakeFeed(tradeCount, rejectPercent);
+        std::string suffix = "/reject=" + std::to_string(rejectPercent) + "%";
+
+        MeasureFeed("BookTrade+catch" + suffix, dtos, [](TradeService& service, const TradeDto& dto) {
+            try {
+                service.BookTrade(dto);
+                return true;
+            } catch (const std::invalid_argument&) {
+                return false;
+            }
+        });
+        MeasureFeed("TryBookTrade" + suffix, dtos, [](TradeService& service, const TradeDto& dto) {
+            return service.TryBookTrade(dto).Succeeded();
+        });
+        MeasureFeed("TryBookTrade+message" + suffix, dtos, [](TradeService& service, const TradeDto& dto) {
+            auto outcome = service.TryBookTrade(dto);
+            if (!outcome.Succeeded()) {
+                KeepAlive(outcome.Error.Message().size());
+            }
+            return outcome.Succeeded();
+        });
+    }
+}
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <thread>
+
+#include "BenchCommon.hpp"
+
+extern "C" TradeBookEngine::Core::Interfaces::ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+namespace {
+
+    std::shared_ptr<Trade> MakeTrade(std::size_t index) {
+        auto now = std::chrono::system_clock::now();
+        return std::make_shared<Trade>("T-" + std::to_string(index), AssetClass::Equity, "AAPL",
+            "CP-" + std::to_string(index % 100), 1000.0, "USD", TradeSide::Buy, now, now, "bench");
+    }
+
+    // Readers hammer GetById while one writer keeps saving new trades
+    double LookupsPerSecond(ITradeRepository& repo, std::size_t readers, std::size_t bookSize) {
+        for (std::size_t i = 0; i < bookSize; ++i) {
+            repo.Save(MakeTrade(i));
+        }
+
+        std::atomic<bool> stop{false};
+        std::atomic<std::size_t> lookups{0};
+
+        std::thread writer([&]() {
+            std::size_t next = bookSize;
+            while (!stop.load(std::memory_order_relaxed)) {
+                repo.Save(MakeTrade(next++));
+            }
+        });
+
+        std::vector<std::thread> threads;
+        for (std::size_t r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r]() {
+                std::size_t local = 0;
+                std::size_t index = r * 7919;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    repo.GetById("T-" + std::to_string(index % bookSize));
+                    index += 104729;
+                    ++local;
+                }
+                lookups.fetch_add(local);
+            });
+        }
+
+        auto duration = std::chrono::milliseconds(300);
+        std::this_thread::sleep_for(duration);
+        stop.store(true);
+        writer.join();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        return static_cast<double>(lookups.load()) / std::chrono::duration<double>(duration).count();
+    }
+
+} // namespace
+
+TRADEBOOK_BENCHMARK(RepositoryLookupScaling) {
+    const std::size_t bookSize = 100000;
+    std::size_t maxReaders = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t readers = 1; readers <= maxReaders; readers *= 2) {
+        auto single = std::unique_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        Report("InMemory/readers=" + std::to_string(readers),
+               LookupsPerSecond(*single, readers, bookSize), "lookups/s");
+
+        auto sharded = std::unique_ptr<ITradeRepository>(CreateShardedTradeRepository(64));
+        Report("Sharded64/readers=" + std::to_string(readers),
+               LookupsPerSecond(*sharded, readers, bookSize), "lookups/s");
+    }
+}
@@ -0,0 +1,85 @@
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+namespace {
+
+    double Millis(Clock::duration elapsed) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) / 1000.0;
+    }
+
+    const std::size_t BookSize = 1000000;
+    const int SettlementDays = 250;
+
+    // A book of Booked trades spread evenly over SettlementDays days
+    std::shared_ptr<ITradeRepository> MakeBook(Calendars::Day firstDay) {
+        auto repo = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        for (std::size_t i = 0; i < BookSize; ++i) {
+            auto settlement = Calendars::HolidayCalendar::FromDay(firstDay + static_cast<int>(i % SettlementDays));
+            auto trade = std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity,
+                "EQ-" + std::to_string(i % 5000), "CP-" + std::to_string(i % 10000), 1000.0, "USD", TradeSide::Buy,
+                settlement - std::chrono::hours(48), settlement + std::chrono::hours(i % 24), "bench");
+            trade->SetStatus(TradeStatus::Booked);
+            repo->Save(trade);
+        }
+        return repo;
+    }
+
+} // namespace
+
+// End-of-day settlement of one day's trades out of a 1M-trade book spread
+// over 250 days: the settlement-day index against walking GetAll, each
+// sweeping a different day
+TRADEBOOK_BENCHMARK(SettlementSweep) {
+    const Calendars::Day firstDay = 20000;
+    auto repo = MakeBook(firstDay);
+    auto service = MakeService(repo);
+
+    auto start = Clock::now();
+    std::size_t scanned = 0;
+    auto dueDay = firstDay;
+    for (const auto& trade : repo->GetAll()) {
+        if (trade->GetStatus() == TradeStatus::Booked &&
+            Calendars::HolidayCalendar::ToDay(trade->GetSettlementDate()) == dueDay &&
+            repo->TransitionStatus(trade->GetTradeId(), TradeStatus::Settled, IsValidTransition).Outcome ==
+                TransitionOutcome::Applied) {
+            ++scanned;
+        }
+    }
+    Report("GetAll+filter settle one day/book=1M", Millis(Clock::now() - start), "ms");
+
+    start = Clock::now();
+    std::size_t swept = service->SettleDueTrades(Calendars::HolidayCalendar::FromDay(firstDay + 1));
+    Report("SettleDueTrades one day/book=1M", Millis(Clock::now() - start), "ms");
+
+    if (scanned != swept || swept != BookSize / SettlementDays) {
+        std::cerr << "settlement sweeps disagree" << std::endl;
+    }
+
+    // Single changes on trades that are not due, spread over the book: the
+    // unchecked UpdateStatus, then the rule-checked CancelTrade on others
+    const std::size_t transitions = 200000;
+    std::vector<std::string> updateIds, cancelIds;
+    updateIds.reserve(transitions);
+    cancelIds.reserve(transitions);
+    for (std::size_t i = 0; i < transitions; ++i) {
+        updateIds.push_back("T-" + std::to_string(i * (BookSize / transitions) + 2));
+        cancelIds.push_back("T-" + std::to_string(i * (BookSize / transitions) + 3));
+    }
+    std::uint64_t applied = 0;
+    start = Clock::now();
+    for (const auto& id : updateIds) {
+        applied += repo->UpdateStatus(id, TradeStatus::Cancelled) ? 1u : 0u;
+    }
+    Report("UpdateStatus", NanosPerOp(Clock::now() - start, transitions), "ns/trade");
+    start = Clock::now();
+    for (const auto& id : cancelIds) {
+        applied += service->CancelTrade(id).Outcome == TransitionOutcome::Applied ? 1u : 0u;
+    }
+    Report("CancelTrade", NanosPerOp(Clock::now() - start, transitions), "ns/trade");
+    KeepAlive(applied + swept);
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <filesystem>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Repositories/SnapshotTradeRepository.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Repositories;
+
+extern "C" {
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+}
+
+// Cold start from a snapshot against rebuilding the book trade by trade, as
+// a log replay does. TRADEBOOK_SNAPSHOT_BOOK sets the book size (default 1M).
+TRADEBOOK_BENCHMARK(Snapshot) {
+    const char* configured = std::getenv("TRADEBOOK_SNAPSHOT_BOOK");
+    const std::size_t bookSize = configured ? std::strtoull(configured, nullptr, 10) : 1000000;
+    const std::string book = "/book=" + std::to_string(bookSize);
+    auto path = (std::filesystem::temp_directory_path() / "tradebook_bench.snapshot").string();
+
+    auto now = std::chrono::system_clock::now();
+    auto start = Clock::now();
+    auto source = std::unique_ptr<ITradeRepository>(CreateShardedTradeRepository(16));
+    for (std::size_t i = 0; i < bookSize; ++i) {
+        auto trade = std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity, "EQ-" + std::to_string(i % 500),
+            "CP-" + std::to_string(i % 1000), 1.0, "USD", TradeSide::Buy, now, now, "bench");
+        trade->SetIdempotencyKey("key-" + std::to_string(i));
+        trade->AddAdditionalData("Exchange", "NASDAQ");
+        source->Save(trade);
+    }
+    Report("Rebuild by Save" + book, NanosPerOp(Clock::now() - start, 1) / 1e6, "ms");
+
+    start = Clock::now();
+    auto info = WriteTradeSnapshot(*source, path);
+    Report("WriteTradeSnapshot" + book, NanosPerOp(Clock::now() - start, 1) / 1e6, "ms");
+    Report("Snapshot size" + book, static_cast<double>(info.Bytes) / (1024.0 * 1024.0), "MiB");
+    source.reset();
+
+    start = Clock::now();
+    auto repo = std::make_unique<SnapshotTradeRepository>(path);
+    bool found = repo->GetById("T-" + std::to_string(bookSize / 2)) != nullptr;
+    Report("Open + first GetById" + book, NanosPerOp(Clock::now() - start, 1) / 1e6, "ms");
+
+    const std::size_t lookups = 100000;
+    std::vector<std::string> ids;
+    ids.reserve(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        ids.push_back("T-" + std::to_string((i * 7919) % bookSize));
+    }
+    start = Clock::now();
+    std::size_t hits = 0;
+    for (const auto& id : ids) {
+        hits += repo->GetById(id) ? 1u : 0u;
+    }
+    Report("GetById from snapshot" + book, NanosPerOp(Clock::now() - start, lookups));
+
+    start = Clock::now();
+    double total = 0.0;
+    repo->ForEach(TradePredicate(), [&total](const Trade& trade) {
+        total += trade.GetNotional();
+        return true;
+    });
+    Report("ForEach from snapshot" + book, NanosPerOp(Clock::now() - start, 1) / 1e6, "ms");
+    KeepAlive(hits + static_cast<std::uint64_t>(total) + (found ? 1 : 0));
+
+    repo.reset();
+    std::filesystem::remove(path);
+}
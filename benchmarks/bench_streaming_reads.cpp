@@ -0,0 +1,57 @@
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Interfaces;
+
+// Total notional over a 1M-trade book: GetAll() against ForEach and a paged
+// cursor, with the heap bytes each one allocates
+TRADEBOOK_BENCHMARK(StreamingReads) {
+    const std::size_t bookSize = 1000000;
+    auto repo = std::unique_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+    auto now = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < bookSize; ++i) {
+        repo->Save(std::make_shared<Trade>("T-" + std::to_string(i), AssetClass::Equity, "AAPL",
+            "CP-" + std::to_string(i % 1000), 1.0, "USD", TradeSide::Buy, now, now, "bench"));
+    }
+
+    auto measure = [](const std::string& name, auto&& scan) {
+        auto before = ThreadAllocations();
+        auto start = Clock::now();
+        double total = scan();
+        auto elapsed = Clock::now() - start;
+        auto after = ThreadAllocations();
+        Report(name, NanosPerOp(elapsed, 1) / 1e6, "ms");
+        Report(name + " heap", static_cast<double>(after.Bytes - before.Bytes) / (1024.0 * 1024.0), "MiB");
+        KeepAlive(static_cast<std::uint64_t>(total));
+    };
+
+    measure("GetAll/book=1M", [&repo]() {
+        double total = 0.0;
+        for (const auto& trade : repo->GetAll()) {
+            total += trade->GetNotional();
+        }
+        return total;
+    });
+
+    measure("ForEach/book=1M", [&repo]() {
+        double total = 0.0;
+        repo->ForEach(TradePredicate(), [&total](const Trade& trade) {
+            total += trade.GetNotional();
+            return true;
+        });
+        return total;
+    });
+
+    measure("TradeCursor/page=10000/book=1M", [&repo]() {
+        double total = 0.0;
+        TradeCursor cursor(*repo, 10000);
+        while (cursor.Next([&total](const Trade& trade) {
+            total += trade.GetNotional();
+            return true;
+        })) {
+        }
+        return total;
+    });
+}
@@ -0,0 +1,89 @@
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include "BenchCommon.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Utils;
+
+namespace {
+
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    // The stream-based conversions DateTimeUtils used before FormatIso8601
+    // and ParseIso8601, kept as the baseline
+    std::string LegacyToString(const TimePoint& timePoint) {
+        auto seconds = std::chrono::system_clock::to_time_t(timePoint);
+        std::stringstream ss;
+        ss << std::put_time(std::gmtime(&seconds), "%Y-%m-%dT%H:%M:%SZ");
+        return ss.str();
+    }
+
+    TimePoint LegacyFromString(const std::string& text) {
+        std::tm tm = {};
+        std::stringstream ss(text);
+        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    }
+
+    template <typename Convert>
+    void Measure(const std::string& name, std::size_t count, Convert&& convert) {
+        std::uint64_t sink = 0;
+        auto before = ThreadAllocations();
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            sink += convert(i);
+        }
+        auto elapsed = Clock::now() - start;
+        auto after = ThreadAllocations();
+        Report(name, NanosPerOp(elapsed, count));
+        Report(name + " allocations/op",
+               static_cast<double>(after.Allocations - before.Allocations) / static_cast<double>(count), "allocs");
+        KeepAlive(sink);
+    }
+
+} // namespace
+
+// Formatting and parsing a day of trade timestamps, one every 0.86 s, as an
+// import or export does
+TRADEBOOK_BENCHMARK(Timestamps) {
+    const std::size_t count = 100000;
+    const TimePoint base = TimePoint(std::chrono::seconds(1709164800));  // 2024-02-29T00:00:00Z
+    std::vector<TimePoint> times;
+    std::vector<std::string> secondsText;
+    std::vector<std::string> microsText;
+    times.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        times.push_back(base + std::chrono::microseconds(static_cast<std::int64_t>(i) * 863999));
+        secondsText.push_back(LegacyToString(times.back()));
+        char buffer[DateTimeUtils::MaxIso8601Length];
+        std::size_t length = DateTimeUtils::FormatIso8601(times.back(), buffer, sizeof(buffer),
+                                                          TimestampPrecision::Microseconds);
+        microsText.emplace_back(buffer, length);
+    }
+
+    Measure("ToString/legacy stringstream", count, [&times](std::size_t i) {
+        return LegacyToString(times[i]).size();
+    });
+    Measure("DateTimeUtils::ToString", count, [&times](std::size_t i) {
+        return DateTimeUtils::ToString(times[i]).size();
+    });
+    Measure("FormatIso8601/us", count, [&times](std::size_t i) {
+        char buffer[DateTimeUtils::MaxIso8601Length];
+        return DateTimeUtils::FormatIso8601(times[i], buffer, sizeof(buffer), TimestampPrecision::Microseconds);
+    });
+
+    Measure("FromString/legacy get_time", count, [&secondsText](std::size_t i) {
+        return static_cast<std::uint64_t>(LegacyFromString(secondsText[i]).time_since_epoch().count());
+    });
+    Measure("DateTimeUtils::FromString", count, [&secondsText](std::size_t i) {
+        return static_cast<std::uint64_t>(DateTimeUtils::FromString(secondsText[i]).time_since_epoch().count());
+    });
+    Measure("ParseIso8601/us", count, [&microsText](std::size_t i) {
+        TimePoint parsed;
+        DateTimeUtils::ParseIso8601(microsText[i].data(), microsText[i].size(), parsed);
+        return static_cast<std::uint64_t>(parsed.time_since_epoch().count());
+    });
+}
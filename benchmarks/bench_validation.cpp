@@ -0,0 +1,60 @@
+#include "BenchCommon.hpp"
+
+using namespace TradeBookEngine::Bench;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+
+namespace {
+
+    template <typename Validate>
+    void MeasureValidation(const std::string& label, const std::vector<TradeDto>& dtos, Validate&& validate) {
+        const std::size_t rounds = 20;
+        std::uint64_t rejected = 0;
+        auto before = ThreadAllocations();
+        auto start = Clock::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (const auto& dto : dtos) {
+                rejected += validate(dto) ? 0u : 1u;
+            }
+        }
+        auto elapsed = Clock::now() - start;
+        auto after = ThreadAllocations();
+
+        std::size_t checks = rounds * dtos.size();
+        Report(label, NanosPerOp(elapsed, checks), "ns/trade");
+        Report(label + " allocations/trade",
+               static_cast<double>(after.Allocations - before.Allocations) / static_cast<double>(checks), "allocs");
+        KeepAlive(rejected);
+    }
+
+} // namespace
+
+// TradeService::ValidateTrade for valid and invalid trades. Valid trades go
+// through the indexed validator's Check and should not allocate; rejected
+// trades pay for rendering the message.
+TRADEBOOK_BENCHMARK(Validation) {
+    const std::size_t tradeCount = 50000;
+    std::vector<TradeDto> valid;
+    std::vector<TradeDto> invalid;
+    valid.reserve(tradeCount);
+    invalid.reserve(tradeCount);
+    for (std::size_t i = 0; i < tradeCount; ++i) {
+        auto dto = MakeEquityDto(i);
+        if (i % 2 == 1) {
+            dto.AssetClass = AssetClass::Bond;
+            dto.Additional.SetMaturityDate("2035-06-30");
+            dto.Additional.SetCreditRating("AA");
+        }
+        valid.push_back(dto);
+        dto.Additional = AttributeMap();
+        invalid.push_back(dto);
+    }
+
+    auto service = MakeService();
+    MeasureValidation("ValidateTrade/valid", valid, [&service](const TradeDto& dto) {
+        return service->ValidateTrade(dto).empty();
+    });
+    MeasureValidation("ValidateTrade/invalid", invalid, [&service](const TradeDto& dto) {
+        return service->ValidateTrade(dto).empty();
+    });
+}
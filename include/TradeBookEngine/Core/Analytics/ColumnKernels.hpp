@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Analytics {
+namespace Kernels {
+
+    // Reductions over contiguous columns. Sum, SumWhereEquals and MinMax
+    // pick the widest instruction set the CPU supports on first use (AVX2,
+    // then SSE2, then portable scalar code), so results may differ from a
+    // left-to-right scalar sum in the last bits. CountByKey and SumByKey are
+    // scalar on every CPU.
+
+    // Number of distinct values a one-byte key column can hold
+    constexpr std::size_t KeyBuckets = 256;
+
+    struct MinMaxResult {
+        double Min;
+        double Max;
+    };
+
+    double Sum(const double* values, std::size_t count);
+
+    // Sum of values[i] where keys[i] == key
+    double SumWhereEquals(const double* values, const std::uint8_t* keys,
+                          std::size_t count, std::uint8_t key);
+
+    // Min is +infinity and Max is -infinity when count is zero
+    MinMaxResult MinMax(const double* values, std::size_t count);
+
+    // Adds the occurrences of each key into counts[KeyBuckets]
+    void CountByKey(const std::uint8_t* keys, std::size_t count, std::uint64_t* counts);
+
+    // Adds values[i] into sums[keys[i]]; sums has KeyBuckets entries
+    void SumByKey(const double* values, const std::uint8_t* keys,
+                  std::size_t count, double* sums);
+
+    // "avx2", "sse2" or "scalar": what Sum, SumWhereEquals and MinMax run
+    const char* ActiveInstructionSet();
+
+} // namespace Kernels
+} // namespace Analytics
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../Interfaces/ITradeRepositoryListener.hpp"
+#include "../CurrencyCode.hpp"
+#include "ColumnKernels.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Analytics {
+
+    using Enums::AssetClassCount;
+    using Enums::TradeStatusCount;
+    using Models::IsoCurrencyCount;
+
+    // Currency column value for trades whose currency is not ISO-4217
+    constexpr std::uint8_t NonIsoCurrencyKey = 255;
+    static_assert(IsoCurrencyCount <= NonIsoCurrencyKey, "ISO currency indexes must fit the key column");
+
+    // Read-only view of the columns; row i of every array describes the same
+    // trade. Valid only inside ColumnarTradeStore::Read.
+    struct ColumnView {
+        std::size_t Rows;
+        const double* Notional;
+        const std::uint8_t* Side;        // Enums::TradeSide
+        const std::uint8_t* AssetClass;  // Enums::AssetClass
+        const std::uint8_t* Status;      // Enums::TradeStatus
+        const std::uint8_t* Currency;    // CurrencyCode::IsoIndex, or NonIsoCurrencyKey
+        const std::int32_t* TradeDay;      // Days since 1970-01-01 UTC
+        const std::int32_t* SettlementDay; // Days since 1970-01-01 UTC
+    };
+
+    struct SideExposure {
+        double Buy;
+        double Sell;
+    };
+
+    // Structure-of-arrays copy of the scan-relevant trade fields, kept in
+    // sync by registering it as a repository listener:
+    //
+    //   auto store = std::make_shared<ColumnarTradeStore>();
+    //   repo->AddListener(store);
+    //
+    // Attach it before trades are booked, or seed it with Rebuild. Rows are
+    // keyed by trade id, not by Trade object, so repositories that hand out
+    // a fresh copy per query or notification keep it in sync. Deletes swap
+    // the last row into the hole, so row order is not stable.
+    class ColumnarTradeStore : public Interfaces::ITradeRepositoryListener {
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::vector<double> m_notional;
+        std::vector<std::uint8_t> m_side;
+        std::vector<std::uint8_t> m_assetClass;
+        std::vector<std::uint8_t> m_status;
+        std::vector<std::uint8_t> m_currency;
+        std::vector<std::int32_t> m_tradeDay;
+        std::vector<std::int32_t> m_settlementDay;
+        // Row ownership, for O(1) updates and swap-removal
+        std::vector<std::string> m_owner;
+        std::unordered_map<std::string, std::size_t> m_rowOf;
+
+        void UpsertLocked(const Models::Trade& trade);
+        void RemoveLocked(const std::string& tradeId);
+        ColumnView ViewLocked() const;
+
+    public:
+        ColumnarTradeStore() = default;
+        ColumnarTradeStore(const ColumnarTradeStore&) = delete;
+        ColumnarTradeStore& operator=(const ColumnarTradeStore&) = delete;
+
+        // Replaces the contents with the given trades
+        void Rebuild(const std::vector<std::shared_ptr<Models::Trade>>& trades);
+
+        void OnTradeSaved(const std::shared_ptr<Models::Trade>& trade,
+                          const std::shared_ptr<Models::Trade>& replaced) override;
+        void OnTradeDeleted(const std::shared_ptr<Models::Trade>& trade) override;
+        void OnTradeStatusChanged(const std::shared_ptr<Models::Trade>& trade,
+                                  Enums::TradeStatus previousStatus) override;
+
+        std::size_t Size() const;
+
+        // Runs fn(const ColumnView&) under a shared lock; writers wait until
+        // it returns
+        template <typename Fn>
+        auto Read(Fn&& fn) const {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            return fn(ViewLocked());
+        }
+
+        // Aggregates over every row
+        double TotalNotional() const;
+        SideExposure NotionalBySide() const;
+        std::array<double, AssetClassCount> NotionalByAssetClass() const;
+        std::array<double, TradeStatusCount> NotionalByStatus() const;
+        // Indexed by CurrencyCode::IsoIndex; non-ISO currencies are left out
+        std::array<double, IsoCurrencyCount> NotionalByCurrency() const;
+        std::array<std::uint64_t, TradeStatusCount> CountByStatus() const;
+        Kernels::MinMaxResult NotionalRange() const;
+    };
+
+} // namespace Analytics
+} // namespace Core
+} // namespace TradeBookEngine
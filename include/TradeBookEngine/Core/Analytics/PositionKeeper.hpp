@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../Interfaces/ITradeRepositoryListener.hpp"
+#include "../SymbolTable.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Analytics {
+
+    enum class PositionDimension {
+        Counterparty,
+        Instrument,
+        Currency
+    };
+
+    constexpr std::size_t PositionDimensionCount = 3;
+
+    // Notionals are summed as booked, without currency conversion
+    struct Position {
+        double NetNotional = 0.0;    // Buys minus sells
+        double GrossNotional = 0.0;  // Buys plus sells
+        std::int64_t Trades = 0;
+    };
+
+    struct PositionEntry {
+        Symbols::SymbolId Key;
+        Position Value;
+
+        const std::string& Name() const { return Symbols::Resolve(Key); }
+    };
+
+    // Every position at one instant, in no particular order. Each trade is
+    // either reflected in all three dimensions or in none.
+    struct PositionSnapshot {
+        std::array<std::vector<PositionEntry>, PositionDimensionCount> Entries;
+
+        const std::vector<PositionEntry>& Of(PositionDimension dimension) const {
+            return Entries[static_cast<std::size_t>(dimension)];
+        }
+    };
+
+    // Net and gross notional and trade counts per counterparty, instrument
+    // and currency, kept up to date by registering it as a repository
+    // listener:
+    //
+    //   auto positions = std::make_shared<PositionKeeper>();
+    //   repo->AddListener(positions);
+    //
+    // Pending, Booked and Settled trades count; a status change to Cancelled
+    // or Failed takes the trade out and a change back puts it in again.
+    // Positions live in lock stripes chosen by key, so a booking locks only
+    // the three stripes it touches. Snapshot takes every stripe in order.
+    class PositionKeeper : public Interfaces::ITradeRepositoryListener {
+    public:
+        static constexpr std::size_t StripeCount = 64;
+
+    private:
+        struct alignas(64) Stripe {
+            std::mutex Mutex;
+            std::unordered_map<Symbols::SymbolId, Position> Positions;
+        };
+
+        // One trade's contribution to one position, or its removal
+        struct Change {
+            std::size_t Stripe;
+            Symbols::SymbolId Key;
+            double Net;
+            double Gross;
+            std::int64_t Trades;
+        };
+
+        // Stripe d * StripeCount + s holds dimension d
+        std::unique_ptr<Stripe[]> m_stripes;
+
+        static std::size_t StripeOf(PositionDimension dimension, Symbols::SymbolId key);
+        static std::size_t AddChanges(const Models::Trade& trade, std::int64_t sign, Change* changes);
+        static void ApplyLocked(Stripe& stripe, const Change& change);
+        void Apply(Change* changes, std::size_t count);
+
+    public:
+        PositionKeeper();
+        PositionKeeper(const PositionKeeper&) = delete;
+        PositionKeeper& operator=(const PositionKeeper&) = delete;
+
+        static bool Counts(Enums::TradeStatus status);
+
+        // Replaces the contents with the given trades
+        void Rebuild(const std::vector<std::shared_ptr<Models::Trade>>& trades);
+
+        void OnTradeSaved(const std::shared_ptr<Models::Trade>& trade,
+                          const std::shared_ptr<Models::Trade>& replaced) override;
+        void OnTradeDeleted(const std::shared_ptr<Models::Trade>& trade) override;
+        void OnTradeStatusChanged(const std::shared_ptr<Models::Trade>& trade,
+                                  Enums::TradeStatus previousStatus) override;
+
+        // Zero position for keys with no counting trades
+        Position Get(PositionDimension dimension, Symbols::SymbolId key) const;
+        Position Get(PositionDimension dimension, std::string_view key) const;
+        Position ByCounterparty(std::string_view counterparty) const {
+            return Get(PositionDimension::Counterparty, counterparty);
+        }
+        Position ByInstrument(std::string_view instrumentId) const {
+            return Get(PositionDimension::Instrument, instrumentId);
+        }
+        Position ByCurrency(std::string_view currency) const {
+            return Get(PositionDimension::Currency, currency);
+        }
+
+        PositionSnapshot Snapshot() const;
+    };
+
+} // namespace Analytics
+} // namespace Core
+} // namespace TradeBookEngine
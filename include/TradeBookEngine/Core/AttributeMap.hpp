@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SymbolTable.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Models {
+
+    // 16-byte string value. Up to 15 bytes are stored inline; longer values
+    // take one exact-size heap block. The last byte holds the inline length,
+    // or HeapTag when the first bytes hold a pointer and a 32-bit length.
+    class SmallString {
+    public:
+        static constexpr std::size_t InlineCapacity = 15;
+
+        SmallString() noexcept { std::memset(m_bytes, 0, sizeof(m_bytes)); }
+        explicit SmallString(std::string_view text) : SmallString() { Assign(text); }
+        SmallString(const SmallString& other) : SmallString() { Assign(other.View()); }
+        SmallString(SmallString&& other) noexcept {
+            std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            std::memset(other.m_bytes, 0, sizeof(other.m_bytes));
+        }
+        ~SmallString() { Release(); }
+
+        SmallString& operator=(const SmallString& other) {
+            Assign(other.View());
+            return *this;
+        }
+        SmallString& operator=(SmallString&& other) noexcept {
+            if (this != &other) {
+                Release();
+                std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+                std::memset(other.m_bytes, 0, sizeof(other.m_bytes));
+            }
+            return *this;
+        }
+        SmallString& operator=(std::string_view text) {
+            Assign(text);
+            return *this;
+        }
+
+        std::string_view View() const {
+            if (IsHeap()) {
+                return std::string_view(HeapData(), HeapSize());
+            }
+            return std::string_view(m_bytes, static_cast<unsigned char>(m_bytes[TagByte]));
+        }
+        operator std::string_view() const { return View(); }
+        std::string str() const { return std::string(View()); }
+        std::size_t size() const { return View().size(); }
+        bool empty() const { return size() == 0; }
+
+    private:
+        static constexpr std::size_t TagByte = 15;
+        static constexpr unsigned char HeapTag = 0xFF;
+
+        alignas(8) char m_bytes[16];
+
+        bool IsHeap() const { return static_cast<unsigned char>(m_bytes[TagByte]) == HeapTag; }
+        char* HeapData() const {
+            char* data;
+            std::memcpy(&data, m_bytes, sizeof(data));
+            return data;
+        }
+        std::uint32_t HeapSize() const {
+            std::uint32_t size;
+            std::memcpy(&size, m_bytes + sizeof(char*), sizeof(size));
+            return size;
+        }
+        void Assign(std::string_view text);
+        void Release() noexcept;
+    };
+
+    inline bool operator==(const SmallString& lhs, std::string_view rhs) { return lhs.View() == rhs; }
+    inline bool operator==(std::string_view lhs, const SmallString& rhs) { return lhs == rhs.View(); }
+    inline bool operator!=(const SmallString& lhs, std::string_view rhs) { return lhs.View() != rhs; }
+    inline bool operator!=(std::string_view lhs, const SmallString& rhs) { return lhs != rhs.View(); }
+    inline std::ostream& operator<<(std::ostream& os, const SmallString& value) { return os << value.View(); }
+
+    // Small flat map of extra trade fields keyed by interned names. The first
+    // InlineCapacity entries live inside the object, so the usual one or two
+    // attributes cost no allocation; larger maps move to a heap vector.
+    // Lookups compare 32-bit key ids linearly. The keys in Symbols::WellKnown
+    // have typed accessors that need no string lookup at all.
+    class AttributeMap {
+    public:
+        struct Entry {
+            Symbols::SymbolId KeyId = Symbols::EmptySymbol;
+            SmallString Value;
+
+            const std::string& Key() const { return Symbols::Resolve(KeyId); }
+        };
+
+        static constexpr std::size_t InlineCapacity = 2;
+
+        AttributeMap() = default;
+        AttributeMap(const AttributeMap&) = default;
+        AttributeMap& operator=(const AttributeMap&) = default;
+        AttributeMap(AttributeMap&& other) noexcept;
+        AttributeMap& operator=(AttributeMap&& other) noexcept;
+
+        // Inserts an empty value when the key is missing
+        SmallString& operator[](std::string_view key) { return operator[](Symbols::Intern(key)); }
+        SmallString& operator[](Symbols::SymbolId key);
+
+        void Set(std::string_view key, std::string_view value) { operator[](key) = value; }
+        void Set(Symbols::SymbolId key, std::string_view value) { operator[](key) = value; }
+
+        const SmallString* Find(Symbols::SymbolId key) const;
+        // Never interns: a name the symbol table has not seen cannot be present
+        const SmallString* Find(std::string_view key) const;
+
+        // Empty when the key is missing
+        std::string_view Get(Symbols::SymbolId key) const {
+            const SmallString* value = Find(key);
+            return value ? value->View() : std::string_view();
+        }
+        std::string_view Get(std::string_view key) const {
+            const SmallString* value = Find(key);
+            return value ? value->View() : std::string_view();
+        }
+
+        bool Contains(Symbols::SymbolId key) const { return Find(key) != nullptr; }
+        bool Contains(std::string_view key) const { return Find(key) != nullptr; }
+
+        std::string_view Exchange() const { return Get(Symbols::WellKnown::Exchange); }
+        std::string_view MaturityDate() const { return Get(Symbols::WellKnown::MaturityDate); }
+        std::string_view CreditRating() const { return Get(Symbols::WellKnown::CreditRating); }
+        void SetExchange(std::string_view value) { Set(Symbols::WellKnown::Exchange, value); }
+        void SetMaturityDate(std::string_view value) { Set(Symbols::WellKnown::MaturityDate, value); }
+        void SetCreditRating(std::string_view value) { Set(Symbols::WellKnown::CreditRating, value); }
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        const Entry* begin() const { return Data(); }
+        const Entry* end() const { return Data() + m_size; }
+
+    private:
+        std::array<Entry, InlineCapacity> m_inline;
+        // Holds every entry once the map outgrows the inline slots
+        std::vector<Entry> m_overflow;
+        std::uint32_t m_size = 0;
+
+        const Entry* Data() const { return m_size <= InlineCapacity ? m_inline.data() : m_overflow.data(); }
+        Entry* Data() { return m_size <= InlineCapacity ? m_inline.data() : m_overflow.data(); }
+    };
+
+} // namespace Models
+} // namespace Core
+} // namespace TradeBookEngine
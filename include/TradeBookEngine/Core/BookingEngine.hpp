@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TradeService.hpp"
+#include "Concurrency/BoundedQueue.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Services {
+
+    // Which DTO field picks the worker. Trades with equal keys always go to
+    // the same worker and are booked in submission order.
+    enum class PartitionKey {
+        Counterparty,
+        InstrumentId,
+        IdempotencyKey
+    };
+
+    using BookingCallback = std::function<void(const BookingResult&)>;
+
+    struct BookingEngineOptions {
+        // 0 uses std::thread::hardware_concurrency
+        std::size_t WorkerCount = 0;
+        // Per worker; rounded up to a power of two
+        std::size_t QueueCapacity = 16384;
+        // Most trades a worker passes to one BookTrades call
+        std::size_t MaxBatchSize = 256;
+        PartitionKey Partition = PartitionKey::Counterparty;
+        // Worker i is pinned to CpuAffinity[i % size]; empty leaves
+        // scheduling to the OS. Ignored where pinning is unsupported.
+        std::vector<int> CpuAffinity;
+        // Creates the repository a worker owns; in-memory by default
+        std::function<std::shared_ptr<Interfaces::ITradeRepository>(std::size_t worker)> RepositoryFactory;
+        // Runs on each worker's TradeService before the worker starts, for
+        // validators, settlement calendars and allocation
+        std::function<void(TradeService&)> ConfigureService;
+    };
+
+    struct BookingWorkerStats {
+        std::size_t QueueDepth;
+        std::uint64_t Submitted;
+        std::uint64_t Booked;
+        std::uint64_t Duplicates;
+        std::uint64_t Rejected;
+        // Submitted in a BookTrades call that threw. Such a batch may be
+        // partly or fully booked: a publish failure comes after the save.
+        std::uint64_t Failed;
+        std::uint64_t Batches;  // BookTrades calls
+        bool Pinned;            // CPU affinity was applied
+    };
+
+    // Books trades on a fixed set of worker threads. Each submitted DTO is
+    // hashed on its partition key to one worker, pushed onto that worker's
+    // bounded lock-free queue and booked by the worker through its own
+    // TradeService and repository. A worker is the only writer to its
+    // repository, so bookings on different workers never contend; queries
+    // fan out across the workers' repositories.
+    //
+    // Idempotency keys are checked per worker: a retry is recognised when it
+    // carries the same partition key as the original, which is always true
+    // for a resubmitted DTO.
+    //
+    // The event publisher is shared by all workers and must be thread-safe.
+    class BookingEngine {
+    public:
+        BookingEngine(std::shared_ptr<Interfaces::IEventPublisher> eventPublisher,
+                      BookingEngineOptions options = BookingEngineOptions());
+        // Books everything already submitted, then stops the workers
+        ~BookingEngine();
+
+        BookingEngine(const BookingEngine&) = delete;
+        BookingEngine& operator=(const BookingEngine&) = delete;
+
+        // Waits while the worker's queue is full. The future throws if the
+        // repository or publisher failed; rejections are results. A thrown
+        // batch may still have been booked, in part or in full, so look the
+        // trade up (or resubmit with the same idempotency key) before
+        // booking it again.
+        std::future<BookingResult> Submit(Models::TradeDto tradeDto);
+        // Calls onBooked on the worker thread, without a future's shared
+        // state. A storage or publishing failure arrives as a Rejected result
+        // whose Error holds the exception message; as with the future, the
+        // trade may have been booked.
+        void Submit(Models::TradeDto tradeDto, BookingCallback onBooked);
+        // Non-blocking Submit; false if the worker's queue is full
+        bool TrySubmit(Models::TradeDto& tradeDto, BookingCallback onBooked);
+
+        // Blocks until every trade submitted before the call is booked
+        void Flush();
+
+        std::size_t WorkerCount() const { return m_workers.size(); }
+        std::size_t WorkerFor(const Models::TradeDto& tradeDto) const;
+
+        // Queries over all workers' repositories
+        std::shared_ptr<Models::Trade> GetTrade(const std::string& tradeId);
+        std::vector<std::shared_ptr<Models::Trade>> GetTradesByCounterparty(const std::string& counterparty);
+        // One worker's trades at a time; the visitor may stop the scan
+        void ForEachTrade(const Interfaces::TradeVisitor& visitor,
+                          const Interfaces::TradePredicate& predicate = Interfaces::TradePredicate());
+
+        std::vector<BookingWorkerStats> GetStats() const;
+
+        // Booking metrics of every worker's TradeService, merged
+        Metrics::BookingMetricsSnapshot GetMetricsSnapshot() const;
+
+    private:
+        // Exactly one of the two is set
+        struct Completion {
+            std::unique_ptr<std::promise<BookingResult>> Promise;
+            BookingCallback Callback;
+        };
+
+        struct Request {
+            Models::TradeDto Dto;
+            Completion Done;
+        };
+
+        struct Worker {
+            explicit Worker(std::size_t capacity) : Queue(capacity) {}
+
+            std::shared_ptr<Interfaces::ITradeRepository> Repository;
+            std::unique_ptr<TradeService> Service;
+            Concurrency::BoundedQueue<Request> Queue;
+
+            std::atomic<std::uint64_t> Submitted{0};
+            std::atomic<std::uint64_t> Completed{0};
+            std::atomic<std::uint64_t> Booked{0};
+            std::atomic<std::uint64_t> Duplicates{0};
+            std::atomic<std::uint64_t> Rejected{0};
+            std::atomic<std::uint64_t> Failed{0};
+            std::atomic<std::uint64_t> Batches{0};
+            std::atomic<bool> Idle{false};
+            bool Pinned = false;
+
+            std::mutex WakeMutex;
+            std::condition_variable Wake;
+            std::thread Thread;
+        };
+
+        BookingEngineOptions m_options;
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::atomic<bool> m_stopping{false};
+
+        void Enqueue(Worker& worker, Request&& request);
+        void Notify(Worker& worker);
+        void Run(Worker& worker);
+        void BookBatch(Worker& worker, const std::vector<Models::TradeDto>& dtos,
+                       std::vector<Completion>& completions);
+    };
+
+} // namespace Services
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Trade.hpp"
+#include "TradeDto.hpp"
+#include "Validators/IAssetValidator.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Services {
+
+    enum class BookingStatus {
+        Booked,     // A new trade was created
+        Duplicate,  // The idempotency key matched an existing trade
+        Rejected    // Validation failed; see Error
+    };
+
+    struct BookingResult {
+        BookingStatus Status;
+        std::shared_ptr<Models::Trade> Trade;
+        std::string Error;
+
+        BookingResult()
+            : Status(BookingStatus::Rejected) {
+        }
+
+        bool Succeeded() const { return Status != BookingStatus::Rejected; }
+    };
+
+    // Why a booking was rejected. The values are stable: FFI callers receive
+    // them from TryBookTradeC.
+    enum class BookingErrorCode : std::int32_t {
+        None = 0,
+        EmptyInstrumentId = 1,
+        EmptyCounterparty = 2,
+        NonPositiveNotional = 3,
+        EmptyCurrency = 4,
+        AssetValidation = 5,  // The asset class validator rejected it; see ValidationErrors
+        LimitBreached = 6,    // The counterparty's exposure would exceed its limit
+        TradeDateOutOfRange = 7,  // No SettlementDate, and TradeDate plus the lag is off the calendar
+        Internal = 100        // Storage or publishing failed (C layer only)
+    };
+
+    // Structured rejection, filled without allocating. A plain value: it
+    // does not refer to the DTO or the service, so it can outlive both.
+    // Message() renders the text from the code and the error bits alone,
+    // with one fixed message per library ValidationError bit; BookTrade and
+    // ValidateTrade use the validator's own wording instead.
+    struct BookingError {
+        BookingErrorCode Code = BookingErrorCode::None;
+        const char* Field = "";  // DTO field at fault, e.g. "Additional.Exchange"
+        Validators::ValidationErrorMask ValidationErrors = Validators::ValidationError::None;
+
+        explicit operator bool() const { return Code != BookingErrorCode::None; }
+
+        std::string Message() const;
+    };
+
+    // Result of TryBookTrade: the trade when booked or a duplicate, the
+    // error when rejected
+    struct BookingOutcome {
+        BookingStatus Status = BookingStatus::Rejected;
+        std::shared_ptr<Models::Trade> Trade;
+        BookingError Error;
+
+        bool Succeeded() const { return Status != BookingStatus::Rejected; }
+    };
+
+} // namespace Services
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Calendars {
+
+    // Days since 1970-01-01 (UTC)
+    using Day = std::int32_t;
+
+    // Weekend days as a bit mask, bit 0 = Sunday ... bit 6 = Saturday
+    using WeekendMask = std::uint8_t;
+    constexpr WeekendMask SaturdaySunday = (1u << 0) | (1u << 6);
+
+    enum class RollConvention {
+        Following,         // Next business day
+        Preceding,         // Previous business day
+        ModifiedFollowing  // Following, unless that leaves the month
+    };
+
+    class CalendarError : public std::runtime_error {
+    public:
+        explicit CalendarError(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    // Business-day calendar with precomputed tables over a fixed range of
+    // days. Construction counts the business days before every day in the
+    // range and lists the business days in order, so adding business days,
+    // counting them and rolling are array lookups however far apart the
+    // dates are. Queries outside the range throw std::out_of_range.
+    //
+    // Immutable once built; safe to share between threads.
+    class HolidayCalendar {
+    public:
+        static constexpr Day DefaultFirstDay = -25567;  // 1900-01-01
+        static constexpr Day DefaultLastDay = 84005;    // 2199-12-31
+
+        HolidayCalendar(std::string code, const std::vector<Day>& holidays,
+                        WeekendMask weekend = SaturdaySunday,
+                        Day firstDay = DefaultFirstDay, Day lastDay = DefaultLastDay);
+
+        // Saturdays and Sundays only, over the default range
+        static const HolidayCalendar& WeekendsOnly();
+
+        // Reads the text format below. The code comes from a "code:" line,
+        // or codeIfMissing. Throws CalendarError naming sourceName and the
+        // line on a malformed entry.
+        //
+        //   # comment
+        //   code: USD
+        //   weekend: Sat Sun
+        //   2025-12-25 Christmas Day
+        static std::shared_ptr<const HolidayCalendar> Parse(std::istream& input, const std::string& codeIfMissing,
+                                                            const std::string& sourceName);
+        // The code defaults to the file name without its extension
+        static std::shared_ptr<const HolidayCalendar> LoadFile(const std::string& path);
+
+        const std::string& Code() const { return m_code; }
+        Day FirstDay() const { return m_firstDay; }
+        Day LastDay() const { return m_lastDay; }
+        WeekendMask Weekend() const { return m_weekend; }
+
+        bool IsBusinessDay(Day day) const;
+        // Steps |businessDays| business days forwards or backwards. Zero
+        // returns day unchanged, even if it is a holiday.
+        Day AddBusinessDays(Day day, int businessDays) const;
+        // Whether AddBusinessDays(day, businessDays) stays inside the range
+        bool CanAddBusinessDays(Day day, int businessDays) const;
+        // Business days in [from, to); negative when to is before from
+        int BusinessDaysBetween(Day from, Day to) const;
+        Day Roll(Day day, RollConvention convention = RollConvention::Following) const;
+
+        // Time-point overloads work on the UTC date and keep the time of day
+        bool IsBusinessDay(std::chrono::system_clock::time_point time) const;
+        std::chrono::system_clock::time_point AddBusinessDays(std::chrono::system_clock::time_point time,
+                                                              int businessDays) const;
+        int BusinessDaysBetween(std::chrono::system_clock::time_point from,
+                                std::chrono::system_clock::time_point to) const;
+        std::chrono::system_clock::time_point Roll(std::chrono::system_clock::time_point time,
+                                                   RollConvention convention = RollConvention::Following) const;
+
+        static Day ToDay(std::chrono::system_clock::time_point time);
+        static std::chrono::system_clock::time_point FromDay(Day day);
+
+    private:
+        std::string m_code;
+        Day m_firstDay;
+        Day m_lastDay;
+        WeekendMask m_weekend;
+        // m_before[i] = business days in [m_firstDay, m_firstDay + i); one
+        // entry past the range so counts up to m_lastDay + 1 work
+        std::vector<std::int32_t> m_before;
+        std::vector<Day> m_businessDays;
+
+        std::size_t IndexOf(Day day) const;
+        Day BusinessDayAt(std::int64_t ordinal) const;
+    };
+
+    // Calendars by code, usually the currency whose settlement they govern.
+    // Lookups take a shared lock, so calendars can be reloaded while
+    // trades are booked; holders of an older calendar keep it alive.
+    class CalendarRegistry {
+    public:
+        // Replaces any calendar with the same code
+        void Add(std::shared_ptr<const HolidayCalendar> calendar);
+        std::shared_ptr<const HolidayCalendar> LoadFile(const std::string& path);
+        // Loads every *.cal file in directory; returns how many were loaded
+        std::size_t LoadDirectory(const std::string& directory);
+
+        // Null if no calendar has the code
+        std::shared_ptr<const HolidayCalendar> Find(const std::string& code) const;
+        std::vector<std::string> Codes() const;
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<std::string, std::shared_ptr<const HolidayCalendar>> m_calendars;
+    };
+
+} // namespace Calendars
+} // namespace Core
+} // namespace TradeBookEngine
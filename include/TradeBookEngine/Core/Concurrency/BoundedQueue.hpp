@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Concurrency {
+
+    // Bounded lock-free multi-producer queue over a power-of-two ring
+    // (Vyukov's sequence-numbered cells). Each cell carries a sequence
+    // number that tells producers and consumers whose turn it is, so a push
+    // or pop is one CAS on the shared cursor plus one release store.
+    //
+    // Any number of threads may pop; producers rely on that to drop the
+    // oldest element when the ring is full.
+    template <typename T>
+    class BoundedQueue {
+    private:
+        static constexpr std::size_t CacheLine = 64;
+
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+            T* Value() { return std::launder(reinterpret_cast<T*>(&storage)); }
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        std::size_t m_mask;
+        alignas(CacheLine) std::atomic<std::size_t> m_enqueuePos;
+        alignas(CacheLine) std::atomic<std::size_t> m_dequeuePos;
+
+        static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+            std::size_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        explicit BoundedQueue(std::size_t capacity)
+            : m_cells(new Cell[RoundUpToPowerOfTwo(capacity)])
+            , m_mask(RoundUpToPowerOfTwo(capacity) - 1)
+            , m_enqueuePos(0)
+            , m_dequeuePos(0) {
+            for (std::size_t i = 0; i <= m_mask; ++i) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~BoundedQueue() {
+            std::optional<T> discarded;
+            while (TryPop(discarded)) {
+            }
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        template <typename U>
+        bool TryPush(U&& value) {
+            std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = m_cells[pos & m_mask];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        new (&cell.storage) T(std::forward<U>(value));
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // Full
+                } else {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Moves the oldest element into out; T need not be default-constructible
+        bool TryPop(std::optional<T>& out) {
+            std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = m_cells[pos & m_mask];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        T* value = cell.Value();
+                        out.emplace(std::move(*value));
+                        value->~T();
+                        cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // Empty
+                } else {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Approximate while producers or consumers are active
+        std::size_t Size() const {
+            std::size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+            std::size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        std::size_t Capacity() const { return m_mask + 1; }
+    };
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace TradeBookEngine
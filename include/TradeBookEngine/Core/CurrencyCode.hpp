@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Models {
+
+    // Active ISO-4217 codes, including funds and X-codes such as XAU and XXX
+    constexpr std::size_t IsoCurrencyCount = 182;
+
+    // Three-letter currency code packed into 15 bits, five per letter with
+    // A = 1, so packed values sort alphabetically and zero is the empty
+    // code. Any three letters A-Z pack; IsIso4217 says whether they name an
+    // ISO-4217 currency. Anything else, lower case included, gives the
+    // empty code.
+    class CurrencyCode {
+    public:
+        constexpr CurrencyCode() noexcept : m_packed(0) {}
+        constexpr explicit CurrencyCode(std::string_view text) noexcept : m_packed(Pack(text)) {}
+
+        static constexpr CurrencyCode FromPacked(std::uint16_t packed) noexcept {
+            CurrencyCode code;
+            code.m_packed = packed;
+            return code;
+        }
+
+        constexpr std::uint16_t Packed() const noexcept { return m_packed; }
+        constexpr bool Empty() const noexcept { return m_packed == 0; }
+
+        // One bitset probe
+        bool IsIso4217() const noexcept;
+        // Alphabetical position among the ISO-4217 codes, in
+        // [0, IsoCurrencyCount), or -1; for tables indexed by currency
+        int IsoIndex() const noexcept;
+        // Inverse of IsoIndex
+        static CurrencyCode FromIsoIndex(std::size_t index) noexcept;
+
+        // Writes the three letters and a terminator; an empty code writes ""
+        void CopyTo(char (&text)[4]) const noexcept;
+        // Fits the small-string buffer, so it never allocates
+        std::string ToString() const;
+
+        friend constexpr bool operator==(CurrencyCode a, CurrencyCode b) noexcept { return a.m_packed == b.m_packed; }
+        friend constexpr bool operator!=(CurrencyCode a, CurrencyCode b) noexcept { return a.m_packed != b.m_packed; }
+        friend constexpr bool operator<(CurrencyCode a, CurrencyCode b) noexcept { return a.m_packed < b.m_packed; }
+
+    private:
+        std::uint16_t m_packed;
+
+        static constexpr std::uint16_t Pack(std::string_view text) noexcept {
+            if (text.size() != 3) {
+                return 0;
+            }
+            unsigned packed = 0;
+            for (char c : text) {
+                if (c < 'A' || c > 'Z') {
+                    return 0;
+                }
+                packed = (packed << 5) | static_cast<unsigned>(c - 'A' + 1);
+            }
+            return static_cast<std::uint16_t>(packed);
+        }
+    };
+
+    static_assert(sizeof(CurrencyCode) == 2, "CurrencyCode must stay two bytes");
+
+    inline std::ostream& operator<<(std::ostream& out, CurrencyCode code) {
+        char text[4];
+        code.CopyTo(text);
+        return out << text;
+    }
+
+} // namespace Models
+} // namespace Core
+} // namespace TradeBookEngine
+
+namespace std {
+    template <>
+    struct hash<TradeBookEngine::Core::Models::CurrencyCode> {
+        std::size_t operator()(TradeBookEngine::Core::Models::CurrencyCode code) const noexcept {
+            return code.Packed();
+        }
+    };
+} // namespace std
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace TradeBookEngine {
 namespace Core {
 namespace Enums {
@@ -12,6 +14,9 @@ namespace Enums {
         Currency
     };
 
+    // Number of AssetClass values, for tables indexed by asset class
+    constexpr std::size_t AssetClassCount = 5;
+
     enum class TradeStatus {
         Pending,
         Booked,
@@ -20,6 +25,26 @@ namespace Enums {
         Failed
     };
 
+    constexpr std::size_t TradeStatusCount = 5;
+
+    // Pending -> Booked -> Settled, with Cancelled and Failed reachable from
+    // Pending and Booked. A Failed trade can still settle or be cancelled;
+    // Settled and Cancelled are final.
+    constexpr bool IsValidTransition(TradeStatus from, TradeStatus to) {
+        switch (from) {
+        case TradeStatus::Pending:
+            return to == TradeStatus::Booked || to == TradeStatus::Cancelled || to == TradeStatus::Failed;
+        case TradeStatus::Booked:
+            return to == TradeStatus::Settled || to == TradeStatus::Cancelled || to == TradeStatus::Failed;
+        case TradeStatus::Failed:
+            return to == TradeStatus::Settled || to == TradeStatus::Cancelled;
+        case TradeStatus::Settled:
+        case TradeStatus::Cancelled:
+            break;
+        }
+        return false;
+    }
+
     enum class TradeSide {
         Buy,
         Sell
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <chrono>
+#include <memory>
 #include "../Trade.hpp"
 
 namespace TradeBookEngine {
@@ -20,7 +21,7 @@ namespace Events {
                         const std::string& correlationId = "");
 
         // Getters
-        std::shared_ptr<Models::Trade> GetTrade() const { return m_trade; }
+        const std::shared_ptr<Models::Trade>& GetTrade() const { return m_trade; }
         const std::chrono::system_clock::time_point& GetTimestamp() const { return m_timestamp; }
         const std::string& GetEventId() const { return m_eventId; }
         const std::string& GetCorrelationId() const { return m_correlationId; }
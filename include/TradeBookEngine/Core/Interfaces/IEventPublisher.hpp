@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "../Events/TradeBookedEvent.hpp"
 
 namespace TradeBookEngine {
@@ -12,8 +13,16 @@ namespace Interfaces {
         virtual ~IEventPublisher() = default;
         
         virtual void Publish(const Events::TradeBookedEvent& event) = 0;
+
+        // Publishes a batch of events in order. Override to amortise
+        // per-event costs such as flushes or network round trips.
+        virtual void PublishBatch(const std::vector<Events::TradeBookedEvent>& events) {
+            for (const auto& event : events) {
+                Publish(event);
+            }
+        }
     };
 
 } // namespace Interfaces
 } // namespace Core
-} // namespace TradeBookEngine
\ No newline at end of file
+} // namespace TradeBookEngine
@@ -2,12 +2,54 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <cstddef>
 #include "../Trade.hpp"
+#include "../Calendars/HolidayCalendar.hpp"
+#include "ITradeRepositoryListener.hpp"
 
 namespace TradeBookEngine {
 namespace Core {
 namespace Interfaces {
 
+    enum class ReservationStatus {
+        Reserved,   // The caller now owns the key and must Save or release it
+        Existing,   // A trade already holds the key; see Existing
+        Pending     // Another caller holds the reservation (non-blocking calls only)
+    };
+
+    struct IdempotencyReservation {
+        ReservationStatus Status;
+        std::shared_ptr<Models::Trade> Existing;
+    };
+
+    // Says whether a trade may move from one status to another, for example
+    // Enums::IsValidTransition. Only consulted when the status would change.
+    using StatusTransitionRule = bool (*)(Enums::TradeStatus from, Enums::TradeStatus to);
+
+    enum class TransitionOutcome {
+        Applied,    // The trade moved to the new status
+        Unchanged,  // The trade already had it
+        Refused,    // The rule does not allow the move from its current status
+        NotFound    // No trade has the id
+    };
+
+    struct StatusTransition {
+        TransitionOutcome Outcome = TransitionOutcome::NotFound;
+        // Status the decision was made on; Pending when the trade was not found
+        Enums::TradeStatus Previous = Enums::TradeStatus::Pending;
+
+        bool Succeeded() const {
+            return Outcome == TransitionOutcome::Applied || Outcome == TransitionOutcome::Unchanged;
+        }
+    };
+
+    using TradePredicate = std::function<bool(const Models::Trade&)>;
+    // Returns false to stop the scan
+    using TradeVisitor = std::function<bool(const Models::Trade&)>;
+
     class ITradeRepository {
     public:
         virtual ~ITradeRepository() = default;
@@ -19,8 +61,238 @@ namespace Interfaces {
         virtual std::vector<std::shared_ptr<Models::Trade>> GetAll() = 0;
         virtual bool Exists(const std::string& tradeId) = 0;
         virtual void Delete(const std::string& tradeId) = 0;
+
+        // Secondary-index queries. The defaults scan GetAll(); indexed
+        // implementations answer them in O(result size).
+        virtual std::vector<std::shared_ptr<Models::Trade>> GetByInstrument(const std::string& instrumentId) {
+            return Filter([&instrumentId](const Models::Trade& trade) {
+                return trade.GetInstrumentId() == instrumentId;
+            });
+        }
+
+        virtual std::vector<std::shared_ptr<Models::Trade>> GetByAssetClass(Enums::AssetClass assetClass) {
+            return Filter([assetClass](const Models::Trade& trade) {
+                return trade.GetAssetClass() == assetClass;
+            });
+        }
+
+        virtual std::vector<std::shared_ptr<Models::Trade>> GetByStatus(Enums::TradeStatus status) {
+            return Filter([status](const Models::Trade& trade) {
+                return trade.GetStatus() == status;
+            });
+        }
+
+        // Changes a stored trade's status and keeps the status index in step.
+        // Returns false if no trade has the given id.
+        virtual bool UpdateStatus(const std::string& tradeId, Enums::TradeStatus status) {
+            auto trade = GetById(tradeId);
+            if (!trade) {
+                return false;
+            }
+            trade->SetStatus(status);
+            return true;
+        }
+
+        // Checks the trade's current status against rule and changes it in
+        // one step, so of two racing transitions only one can apply; a null
+        // rule allows any move. Implementations with listeners notify them
+        // of applied transitions only.
+        //
+        // The default compare-and-swaps the trade's status but, like the
+        // default UpdateStatus, leaves indexes and listeners alone.
+        virtual StatusTransition TransitionStatus(const std::string& tradeId, Enums::TradeStatus status,
+                                                  StatusTransitionRule rule) {
+            StatusTransition result;
+            auto trade = GetById(tradeId);
+            if (!trade) {
+                return result;
+            }
+            auto current = trade->GetStatus();
+            do {
+                result.Previous = current;
+                if (current == status) {
+                    result.Outcome = TransitionOutcome::Unchanged;
+                    return result;
+                }
+                if (rule && !rule(current, status)) {
+                    result.Outcome = TransitionOutcome::Refused;
+                    return result;
+                }
+            } while (!trade->CompareExchangeStatus(current, status));
+            result.Outcome = TransitionOutcome::Applied;
+            return result;
+        }
+
+        // One entry per id, in order. Each trade is checked on its own: a
+        // refused or missing trade does not stop the others.
+        virtual std::vector<StatusTransition> TransitionStatuses(const std::vector<std::string>& tradeIds,
+                                                                 Enums::TradeStatus status,
+                                                                 StatusTransitionRule rule) {
+            std::vector<StatusTransition> result;
+            result.reserve(tradeIds.size());
+            for (const auto& tradeId : tradeIds) {
+                result.push_back(TransitionStatus(tradeId, status, rule));
+            }
+            return result;
+        }
+
+        // Trades settling on the UTC day containing date, whatever their
+        // status. The default scans GetAll(); indexed implementations keep a
+        // bucket per settlement day.
+        virtual std::vector<std::shared_ptr<Models::Trade>> GetBySettlementDate(
+            std::chrono::system_clock::time_point date) {
+            auto day = Calendars::HolidayCalendar::ToDay(date);
+            return Filter([day](const Models::Trade& trade) {
+                return Calendars::HolidayCalendar::ToDay(trade.GetSettlementDate()) == day;
+            });
+        }
+
+        // Atomically claims an idempotency key or returns the trade that holds
+        // it. A reservation is fulfilled by saving a trade with the key, or
+        // given up with ReleaseIdempotencyKey. If another caller holds the
+        // reservation this blocks until it is fulfilled or released, so
+        // concurrent submissions of one key never book two trades.
+        //
+        // The default is a plain lookup and is only safe for single writers.
+        virtual IdempotencyReservation ReserveIdempotencyKey(const std::string& idempotencyKey) {
+            auto existing = GetByIdempotencyKey(idempotencyKey);
+            return IdempotencyReservation{
+                existing ? ReservationStatus::Existing : ReservationStatus::Reserved, existing};
+        }
+
+        virtual void ReleaseIdempotencyKey(const std::string& idempotencyKey) {
+            (void)idempotencyKey;
+        }
+
+        // Non-blocking batch form of ReserveIdempotencyKey, one entry per key.
+        // Keys reserved by another caller come back as Pending. Keys must be
+        // distinct.
+        virtual std::vector<IdempotencyReservation> TryReserveIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) {
+            std::vector<IdempotencyReservation> result;
+            result.reserve(idempotencyKeys.size());
+            for (auto& existing : GetByIdempotencyKeys(idempotencyKeys)) {
+                auto status = existing ? ReservationStatus::Existing : ReservationStatus::Reserved;
+                result.push_back(IdempotencyReservation{status, std::move(existing)});
+            }
+            return result;
+        }
+
+        // Registers a listener for every subsequent Save, Delete and status
+        // change. Existing trades are not replayed. Register listeners before
+        // the repository is shared between threads.
+        virtual void AddListener(std::shared_ptr<ITradeRepositoryListener> listener) {
+            (void)listener;
+            throw std::logic_error("This repository does not support listeners");
+        }
+
+        // Batch operations. The defaults fall back to the per-trade calls;
+        // implementations should override them to take their lock once.
+        virtual void SaveBatch(const std::vector<std::shared_ptr<Models::Trade>>& trades) {
+            for (const auto& trade : trades) {
+                Save(trade);
+            }
+        }
+
+        // Returns one entry per key, nullptr where no trade holds the key.
+        virtual std::vector<std::shared_ptr<Models::Trade>> GetByIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) {
+            std::vector<std::shared_ptr<Models::Trade>> result;
+            result.reserve(idempotencyKeys.size());
+            for (const auto& key : idempotencyKeys) {
+                result.push_back(GetByIdempotencyKey(key));
+            }
+            return result;
+        }
+
+        // Streaming reads. Trades matching predicate (every trade when it is
+        // empty) are passed to visitor by reference, without building a
+        // result vector. The bundled repositories hold their lock for one
+        // bounded chunk at a time, so the visitor must not call back into the
+        // repository, and trades saved or deleted during the scan may or may
+        // not be seen; every other trade is visited exactly once.
+        virtual void ForEach(const TradePredicate& predicate, const TradeVisitor& visitor) {
+            for (const auto& trade : GetAll()) {
+                if ((!predicate || predicate(*trade)) && !visitor(*trade)) {
+                    return;
+                }
+            }
+        }
+
+        // Visits up to pageSize matching trades from continuationToken (empty
+        // to start) and returns the token to resume from, or an empty string
+        // once the scan is complete. Tokens are opaque and only valid for the
+        // repository that issued them. If visitor stops early, the token
+        // resumes after the last visited trade.
+        virtual std::string ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                                     const TradePredicate& predicate, const TradeVisitor& visitor) {
+            if (pageSize == 0) {
+                throw std::invalid_argument("Page size must be positive");
+            }
+            // Fallback: the token is an offset into GetAll()
+            std::size_t offset = continuationToken.empty() ? 0 : std::stoul(continuationToken);
+            auto trades = GetAll();
+            std::size_t visited = 0;
+            while (offset < trades.size()) {
+                const auto& trade = *trades[offset++];
+                if (predicate && !predicate(trade)) {
+                    continue;
+                }
+                if (!visitor(trade) || ++visited == pageSize) {
+                    break;
+                }
+            }
+            return offset < trades.size() ? std::to_string(offset) : std::string();
+        }
+
+    private:
+        template <typename Predicate>
+        std::vector<std::shared_ptr<Models::Trade>> Filter(Predicate predicate) {
+            std::vector<std::shared_ptr<Models::Trade>> result;
+            for (auto& trade : GetAll()) {
+                if (predicate(*trade)) {
+                    result.push_back(std::move(trade));
+                }
+            }
+            return result;
+        }
+    };
+
+    // Pages through a repository with ReadPage. The token can be saved and
+    // handed to a new cursor to continue later.
+    class TradeCursor {
+    private:
+        ITradeRepository* m_repository;
+        std::size_t m_pageSize;
+        TradePredicate m_predicate;
+        std::string m_token;
+        bool m_done;
+
+    public:
+        TradeCursor(ITradeRepository& repository, std::size_t pageSize,
+                    TradePredicate predicate = TradePredicate(),
+                    std::string continuationToken = std::string())
+            : m_repository(&repository)
+            , m_pageSize(pageSize)
+            , m_predicate(std::move(predicate))
+            , m_token(std::move(continuationToken))
+            , m_done(false) {
+        }
+
+        // Visits the next page. Returns true while more pages may follow.
+        bool Next(const TradeVisitor& visitor) {
+            if (m_done) {
+                return false;
+            }
+            m_token = m_repository->ReadPage(m_token, m_pageSize, m_predicate, visitor);
+            m_done = m_token.empty();
+            return !m_done;
+        }
+
+        bool Done() const { return m_done; }
+        const std::string& ContinuationToken() const { return m_token; }
     };
 
 } // namespace Interfaces
 } // namespace Core
-} // namespace TradeBookEngine
\ No newline at end of file
+} // namespace TradeBookEngine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include "../Trade.hpp"
+#include "../Enums.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Interfaces {
+
+    // Receives every change a repository applies, for derived views such as
+    // columnar stores or positions. Calls are made while the repository holds
+    // the write lock covering the trade, so changes to one trade arrive in
+    // order; calls for trades in different shards may arrive concurrently.
+    // Keep handlers short and never call back into the repository.
+    class ITradeRepositoryListener {
+    public:
+        virtual ~ITradeRepositoryListener() = default;
+
+        // replaced is the trade previously stored under the same id, if any
+        virtual void OnTradeSaved(const std::shared_ptr<Models::Trade>& trade,
+                                  const std::shared_ptr<Models::Trade>& replaced) = 0;
+        virtual void OnTradeDeleted(const std::shared_ptr<Models::Trade>& trade) = 0;
+        virtual void OnTradeStatusChanged(const std::shared_ptr<Models::Trade>& trade,
+                                          Enums::TradeStatus previousStatus) = 0;
+    };
+
+} // namespace Interfaces
+} // namespace Core
+} // namespace TradeBookEngine
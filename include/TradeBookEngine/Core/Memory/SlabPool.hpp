@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Memory {
+
+    struct SlabPoolStats {
+        std::size_t SlabBytes;   // Bytes reserved from the system heap
+        std::size_t DepotBlocks; // Free blocks parked in the shared depot
+    };
+
+    // Size-class allocator for the booking path. Blocks of up to
+    // MaxBlockSize bytes come from 64 KiB slabs, in 32-byte size classes.
+    // Each thread keeps its own free list per class, so allocation and
+    // release are a few instructions without locks or atomics. A thread
+    // that frees more than it allocates hands batches back to a shared
+    // depot, and a thread's remaining blocks move there when it exits.
+    // Slabs are never returned to the system.
+    class SlabPool {
+    public:
+        static constexpr std::size_t MaxBlockSize = 512;
+
+        // Larger requests fall through to ::operator new
+        static void* Allocate(std::size_t bytes);
+        // bytes must match the Allocate call
+        static void Deallocate(void* block, std::size_t bytes) noexcept;
+
+        static SlabPoolStats GetStats();
+    };
+
+    // Standard allocator over SlabPool, for allocate_shared and node-based
+    // containers
+    template <typename T>
+    class PoolAllocator {
+    public:
+        using value_type = T;
+
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "SlabPool blocks are only aligned to max_align_t");
+
+        PoolAllocator() noexcept = default;
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(SlabPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            SlabPool::Deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+    };
+
+    // make_shared with the object and its control block in one pool block
+    template <typename T, typename... Args>
+    std::shared_ptr<T> MakePooled(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+
+} // namespace Memory
+} // namespace Core
+} // namespace TradeBookEngine
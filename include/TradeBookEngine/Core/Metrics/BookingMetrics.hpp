@@ -0,0 +1,351 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRADEBOOK_METRICS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define TRADEBOOK_METRICS_TSC 1
+#endif
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Metrics {
+
+    // Timestamp in ticks: the time-stamp counter where the CPU has one (a few
+    // nanoseconds to read, no system call), steady_clock nanoseconds elsewhere.
+    // Only differences between ticks read on the same machine are meaningful.
+    inline std::uint64_t ReadTicks() {
+#if defined(TRADEBOOK_METRICS_TSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Tick rate measured against steady_clock since the library was loaded.
+    // The first call in a process younger than 10 ms waits until then.
+    double TicksPerNanosecond();
+
+    // Log-linear histogram of tick counts: values below 16 get a bucket each,
+    // and every power of two above is split into 16 equal buckets, so a
+    // bucket is never wider than 1/16 of its lower bound. Values of 2^40
+    // ticks or more (minutes) share the last bucket.
+    //
+    // Written by one thread and read by any: each update is a relaxed load
+    // and store rather than a locked read-modify-write.
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned SubBucketBits = 4;
+        static constexpr std::size_t SubBuckets = std::size_t{1} << SubBucketBits;
+        static constexpr unsigned MaxExponent = 39;
+        static constexpr std::size_t BucketCount = (MaxExponent - SubBucketBits + 2) * SubBuckets;
+
+        static std::size_t BucketFor(std::uint64_t ticks) {
+            if (ticks < SubBuckets) {
+                return static_cast<std::size_t>(ticks);
+            }
+            unsigned exponent = HighestBit(ticks);
+            if (exponent > MaxExponent) {
+                return BucketCount - 1;
+            }
+            auto mantissa = static_cast<std::size_t>(ticks >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+            return (exponent - SubBucketBits + 1) * SubBuckets + mantissa;
+        }
+
+        // Smallest value that lands in the bucket
+        static std::uint64_t BucketLowerBound(std::size_t bucket) {
+            if (bucket < SubBuckets) {
+                return bucket;
+            }
+            auto exponent = static_cast<unsigned>(bucket / SubBuckets) + SubBucketBits - 1;
+            return static_cast<std::uint64_t>(SubBuckets + bucket % SubBuckets) << (exponent - SubBucketBits);
+        }
+
+        void Record(std::uint64_t ticks) {
+            Bump(m_buckets[BucketFor(ticks)], 1);
+            Bump(m_sum, ticks);
+            if (ticks > m_max.load(std::memory_order_relaxed)) {
+                m_max.store(ticks, std::memory_order_relaxed);
+            }
+        }
+
+        std::uint64_t Bucket(std::size_t bucket) const { return m_buckets[bucket].load(std::memory_order_relaxed); }
+        std::uint64_t Sum() const { return m_sum.load(std::memory_order_relaxed); }
+        std::uint64_t Max() const { return m_max.load(std::memory_order_relaxed); }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, BucketCount> m_buckets{};
+        std::atomic<std::uint64_t> m_sum{0};
+        std::atomic<std::uint64_t> m_max{0};
+
+        static void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        static unsigned HighestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+            unsigned bit = 0;
+            while (value >>= 1) {
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+    };
+
+    // Merged copy of one or more histograms, converted to nanoseconds on read
+    struct HistogramSnapshot {
+        std::vector<std::uint64_t> Buckets = std::vector<std::uint64_t>(LatencyHistogram::BucketCount);
+        std::uint64_t Count = 0;
+        std::uint64_t SumTicks = 0;
+        std::uint64_t MaxTicks = 0;
+        double TicksPerNanosecond = 1.0;
+
+        void Add(const LatencyHistogram& histogram);
+        void Add(const HistogramSnapshot& other);
+
+        double MeanNanos() const;
+        double MaxNanos() const;
+        // Midpoint of the bucket holding the given percentile (0-100), or 0 if empty
+        double PercentileNanos(double percentile) const;
+    };
+
+    // Time this thread has spent blocked on locks taken through LockTimed
+    struct LockWaitCounters {
+        std::uint64_t Ticks = 0;
+        std::uint64_t Waits = 0;
+    };
+
+    inline LockWaitCounters& ThreadLockWaits() {
+        thread_local LockWaitCounters counters;
+        return counters;
+    }
+
+    // Locks mutex, charging any time spent blocked to ThreadLockWaits().
+    // An uncontended acquisition is a single try_lock and reads no clock.
+    template <typename Mutex>
+    std::unique_lock<Mutex> LockTimed(Mutex& mutex) {
+        std::unique_lock<Mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            auto start = ReadTicks();
+            lock.lock();
+            auto& waits = ThreadLockWaits();
+            waits.Ticks += ReadTicks() - start;
+            ++waits.Waits;
+        }
+        return lock;
+    }
+
+    // Timed sections of the booking path. Single bookings (BookTrade,
+    // TryBookTrade) record the first six per trade; BookTrades records
+    // Validation and Conversion per trade and the Batch stages per call.
+    // Only sampled calls are timed, so stage counts are sample sizes.
+    enum class BookingStage : std::size_t {
+        IdempotencyLookup,  // Reserving the idempotency key
+        Validation,         // CheckTrade: field and asset class checks, settlement date
+        Conversion,         // ConvertToTrade
+        LimitCheck,         // Reserving the notional against the counterparty limit
+        RepositorySave,
+        Publish,
+        Total,              // Whole TryBookTrade call
+        BatchReservation,   // TryReserveIdempotencyKeys for the batch
+        BatchSave,          // SaveBatch
+        BatchPublish,       // PublishBatch
+        BatchTotal          // Whole BookTrades call
+    };
+
+    constexpr std::size_t BookingStageCount = 11;
+
+    const char* BookingStageName(BookingStage stage);
+
+    // Rejections are counted by BookingErrorCode; slot 0 holds codes outside
+    // 1..RejectReasonCount-1
+    constexpr std::size_t RejectReasonCount = 8;
+
+    const char* RejectReasonName(std::size_t reason);
+
+    struct BookingMetricsSnapshot {
+        std::array<HistogramSnapshot, BookingStageCount> Stages;
+        std::uint64_t Booked = 0;
+        std::uint64_t IdempotentHits = 0;
+        std::uint64_t Rejected = 0;
+        std::array<std::uint64_t, RejectReasonCount> RejectsByReason{};
+        std::uint64_t LockWaits = 0;          // Contended repository lock acquisitions
+        std::uint64_t LockWaitTicks = 0;      // Time blocked in them
+        std::size_t Threads = 0;              // Threads that have booked
+        double TicksPerNanosecond = 1.0;
+
+        const HistogramSnapshot& Stage(BookingStage stage) const { return Stages[static_cast<std::size_t>(stage)]; }
+        double LockWaitNanos() const { return static_cast<double>(LockWaitTicks) / TicksPerNanosecond; }
+
+        // Folds in another snapshot, e.g. from another service
+        void Merge(const BookingMetricsSnapshot& other);
+
+        // Multi-line report: counters, then one row of percentiles per stage
+        std::string ToText() const;
+    };
+
+    // Counters one thread updates while booking through one service
+    struct alignas(64) ThreadBookingMetrics {
+        std::array<LatencyHistogram, BookingStageCount> Stages;
+        std::atomic<std::uint64_t> Booked{0};
+        std::atomic<std::uint64_t> IdempotentHits{0};
+        std::array<std::atomic<std::uint64_t>, RejectReasonCount> RejectsByReason{};
+        std::atomic<std::uint64_t> LockWaits{0};
+        std::atomic<std::uint64_t> LockWaitTicks{0};
+        std::uint32_t SampleCountdown = 0;  // Owner thread only
+
+        // True for the first call and then once every interval calls
+        bool SampleNext(std::uint32_t interval) {
+            if (SampleCountdown == 0) {
+                SampleCountdown = interval - 1;
+                return true;
+            }
+            --SampleCountdown;
+            return false;
+        }
+
+        void Record(BookingStage stage, std::uint64_t ticks) {
+            Stages[static_cast<std::size_t>(stage)].Record(ticks);
+        }
+
+        static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        void AddReject(std::int32_t code) {
+            auto reason = code > 0 && static_cast<std::size_t>(code) < RejectReasonCount
+                ? static_cast<std::size_t>(code) : std::size_t{0};
+            Add(RejectsByReason[reason], 1);
+        }
+    };
+
+    // Booking metrics of one service. Each booking thread writes its own
+    // ThreadBookingMetrics block, found through a small thread-local cache,
+    // so recording takes no lock and shares no cache line; Snapshot merges
+    // the blocks. A block outlives its thread and is reused by the next
+    // thread that gets the same id.
+    class BookingMetrics {
+    public:
+        BookingMetrics();
+        BookingMetrics(const BookingMetrics&) = delete;
+        BookingMetrics& operator=(const BookingMetrics&) = delete;
+
+        ThreadBookingMetrics& Local() {
+            for (const auto& entry : t_cache) {
+                if (entry.Owner == m_id) {
+                    return *entry.Block;
+                }
+            }
+            return Register();
+        }
+
+        BookingMetricsSnapshot Snapshot() const;
+
+    private:
+        struct CacheEntry {
+            std::uint64_t Owner = 0;  // Ids are never reused, so a stale entry cannot match
+            ThreadBookingMetrics* Block = nullptr;
+        };
+
+        static thread_local std::array<CacheEntry, 4> t_cache;
+        static thread_local std::size_t t_nextEvict;
+
+        const std::uint64_t m_id;
+        mutable std::mutex m_mutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<ThreadBookingMetrics>>> m_blocks;
+
+        ThreadBookingMetrics& Register();
+    };
+
+    // Times consecutive stages of one booking: each Lap charges the time
+    // since the previous lap (or construction) to a stage. On destruction
+    // the span from construction to the last lap goes to totalStage, and
+    // the repository lock waits incurred meanwhile to the block's counters.
+    // An untimed timer reads no clock and only counts lock waits; a null
+    // block turns everything off.
+    class StageTimer {
+    public:
+        StageTimer(ThreadBookingMetrics* block, BookingStage totalStage, bool timed = true)
+            : m_block(block)
+            , m_totalStage(totalStage)
+            , m_timed(block != nullptr && timed) {
+            if (m_block) {
+                if (m_timed) {
+                    m_start = m_last = ReadTicks();
+                }
+                const auto& waits = ThreadLockWaits();
+                m_lockWaitTicks = waits.Ticks;
+                m_lockWaits = waits.Waits;
+            }
+        }
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+
+        ~StageTimer() { Finish(); }
+
+        void Lap(BookingStage stage) {
+            if (m_timed) {
+                auto now = ReadTicks();
+                m_block->Record(stage, now - m_last);
+                m_last = now;
+            }
+        }
+
+        // Moves the start of the next stage to now without charging the
+        // time since the last lap to any stage
+        void Mark() {
+            if (m_timed) {
+                m_last = ReadTicks();
+            }
+        }
+
+        // Records the total now; later laps are ignored
+        void Finish() {
+            if (!m_block) {
+                return;
+            }
+            if (m_timed) {
+                m_block->Record(m_totalStage, m_last - m_start);
+            }
+            const auto& waits = ThreadLockWaits();
+            if (waits.Waits != m_lockWaits) {
+                ThreadBookingMetrics::Add(m_block->LockWaits, waits.Waits - m_lockWaits);
+                ThreadBookingMetrics::Add(m_block->LockWaitTicks, waits.Ticks - m_lockWaitTicks);
+            }
+            m_block = nullptr;
+            m_timed = false;
+        }
+
+        ThreadBookingMetrics* Block() const { return m_block; }
+
+    private:
+        ThreadBookingMetrics* m_block;
+        BookingStage m_totalStage;
+        bool m_timed;
+        std::uint64_t m_start = 0;
+        std::uint64_t m_last = 0;
+        std::uint64_t m_lockWaitTicks = 0;
+        std::uint64_t m_lockWaits = 0;
+    };
+
+} // namespace Metrics
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../Interfaces/IEventPublisher.hpp"
+#include "../Concurrency/BoundedQueue.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Publishers {
+
+    // What Publish does when the queue is full
+    enum class BackpressurePolicy {
+        Block,      // Wait for the dispatcher to make room
+        DropOldest, // Evict the oldest queued event to make room
+        FailFast    // Reject the new event with EventQueueFullError
+    };
+
+    class EventQueueFullError : public std::runtime_error {
+    public:
+        EventQueueFullError() : std::runtime_error("Event queue is full") {}
+    };
+
+    struct AsyncPublisherStats {
+        std::size_t QueueDepth;
+        std::size_t Capacity;
+        std::uint64_t Enqueued;
+        std::uint64_t Published;
+        std::uint64_t Dropped;          // Evicted under DropOldest
+        std::uint64_t Rejected;         // Refused under FailFast
+        std::uint64_t PublishFailures;  // Events the inner publisher threw on
+    };
+
+    // Decorator that moves publishing off the booking thread. Publish only
+    // enqueues into a bounded lock-free ring; a dedicated dispatcher thread
+    // drains it and forwards events to the inner publisher in batches.
+    class AsyncEventPublisher : public Interfaces::IEventPublisher {
+    private:
+        std::shared_ptr<Interfaces::IEventPublisher> m_inner;
+        Concurrency::BoundedQueue<Events::TradeBookedEvent> m_queue;
+        BackpressurePolicy m_policy;
+        std::size_t m_maxBatchSize;
+
+        std::atomic<std::uint64_t> m_enqueued{0};
+        std::atomic<std::uint64_t> m_published{0};
+        std::atomic<std::uint64_t> m_dropped{0};
+        std::atomic<std::uint64_t> m_rejected{0};
+        std::atomic<std::uint64_t> m_publishFailures{0};
+
+        std::atomic<bool> m_stopping{false};
+        std::atomic<bool> m_dispatcherIdle{false};
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        std::thread m_dispatcher;
+
+        void Enqueue(const Events::TradeBookedEvent& event);
+        void DispatchLoop();
+        std::size_t Drain(std::vector<Events::TradeBookedEvent>& batch);
+
+    public:
+        AsyncEventPublisher(std::shared_ptr<Interfaces::IEventPublisher> inner,
+                            std::size_t capacity = 65536,
+                            BackpressurePolicy policy = BackpressurePolicy::Block,
+                            std::size_t maxBatchSize = 256);
+
+        // Drains everything already queued, then stops the dispatcher
+        ~AsyncEventPublisher() override;
+
+        AsyncEventPublisher(const AsyncEventPublisher&) = delete;
+        AsyncEventPublisher& operator=(const AsyncEventPublisher&) = delete;
+
+        void Publish(const Events::TradeBookedEvent& event) override;
+        void PublishBatch(const std::vector<Events::TradeBookedEvent>& events) override;
+
+        // Blocks until every event enqueued before the call has been handed
+        // to the inner publisher (or dropped)
+        void Flush();
+
+        AsyncPublisherStats GetStats() const;
+    };
+
+} // namespace Publishers
+} // namespace Core
+} // namespace TradeBookEngine
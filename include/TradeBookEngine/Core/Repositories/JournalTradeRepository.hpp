@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../Interfaces/ITradeRepository.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Repositories {
+
+    struct JournalOptions {
+        std::string Path;
+        // How long the writer waits for more records before syncing a batch.
+        // Zero syncs as soon as the previous sync finishes, which still
+        // groups every record appended while that sync was in flight.
+        std::chrono::microseconds CommitDelay{0};
+        // A batch is written at once when it reaches this many bytes
+        std::size_t MaxBatchBytes = 4 * 1024 * 1024;
+        // false skips fdatasync: commits survive a process crash but not an
+        // OS crash or power loss
+        bool SyncOnCommit = true;
+        // Shards of the in-memory repository that serves reads
+        std::size_t ShardCount = 16;
+    };
+
+    struct JournalStats {
+        std::uint64_t Commits;           // Write + sync rounds
+        std::uint64_t Records;           // Records made durable
+        std::uint64_t Bytes;             // Bytes made durable
+        std::uint64_t RecoveredRecords;  // Records replayed at open
+        std::uint64_t TruncatedBytes;    // Torn tail dropped at open
+    };
+
+    class JournalError : public std::runtime_error {
+    public:
+        explicit JournalError(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    // Durable repository: every Save, SaveBatch, Delete and status change is
+    // appended to a binary write-ahead log and returns only once the record
+    // is synced. A writer thread commits whatever concurrent callers have
+    // appended with one write and one fdatasync (group commit). Reads,
+    // reservations and listeners are served by an in-memory sharded
+    // repository, which the constructor rebuilds by replaying the log.
+    //
+    // Records are [u32 length][u32 CRC-32C][type][payload]. A crash can only
+    // tear the last record, so replay truncates a short or corrupt record
+    // that runs to the end of the file (or a zero-filled tail), losing only
+    // commits that were never acknowledged. A corrupt record with more
+    // records after it makes the constructor throw JournalError and leaves
+    // the file untouched for repair.
+    //
+    // Mutations reach the in-memory repository, and so readers and
+    // listeners, in log order once their record is durable, just before the
+    // commit is acknowledged. A commit that fails to write leaves no trace
+    // there: the trade is not visible, its idempotency key is still only
+    // reserved and listeners never hear of it. After a write or sync failure
+    // every later mutation throws JournalError.
+    class JournalTradeRepository : public Interfaces::ITradeRepository {
+    public:
+        explicit JournalTradeRepository(JournalOptions options);
+
+        // Commits everything appended so far, then stops the writer
+        ~JournalTradeRepository() override;
+
+        JournalTradeRepository(const JournalTradeRepository&) = delete;
+        JournalTradeRepository& operator=(const JournalTradeRepository&) = delete;
+
+        void Save(std::shared_ptr<Models::Trade> trade) override;
+        void SaveBatch(const std::vector<std::shared_ptr<Models::Trade>>& trades) override;
+        void Delete(const std::string& tradeId) override;
+        bool UpdateStatus(const std::string& tradeId, Enums::TradeStatus status) override;
+        // Only applied transitions are logged; a batch is one commit
+        Interfaces::StatusTransition TransitionStatus(const std::string& tradeId, Enums::TradeStatus status,
+                                                      Interfaces::StatusTransitionRule rule) override;
+        std::vector<Interfaces::StatusTransition> TransitionStatuses(const std::vector<std::string>& tradeIds,
+                                                                     Enums::TradeStatus status,
+                                                                     Interfaces::StatusTransitionRule rule) override;
+
+        std::shared_ptr<Models::Trade> GetById(const std::string& tradeId) override;
+        std::shared_ptr<Models::Trade> GetByIdempotencyKey(const std::string& idempotencyKey) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByCounterparty(const std::string& counterparty) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetAll() override;
+        bool Exists(const std::string& tradeId) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByInstrument(const std::string& instrumentId) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByAssetClass(Enums::AssetClass assetClass) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByStatus(Enums::TradeStatus status) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetBySettlementDate(
+            std::chrono::system_clock::time_point date) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) override;
+
+        Interfaces::IdempotencyReservation ReserveIdempotencyKey(const std::string& idempotencyKey) override;
+        void ReleaseIdempotencyKey(const std::string& idempotencyKey) override;
+        std::vector<Interfaces::IdempotencyReservation> TryReserveIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) override;
+
+        void AddListener(std::shared_ptr<Interfaces::ITradeRepositoryListener> listener) override;
+        void ForEach(const Interfaces::TradePredicate& predicate, const Interfaces::TradeVisitor& visitor) override;
+        std::string ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                             const Interfaces::TradePredicate& predicate,
+                             const Interfaces::TradeVisitor& visitor) override;
+
+        JournalStats GetStats() const;
+
+    private:
+        enum class OpType : std::uint8_t { Save, Delete, Status };
+
+        // A logged mutation, applied to m_memory once its record is durable
+        struct PendingOp {
+            OpType Type;
+            std::shared_ptr<Models::Trade> Trade;  // Save only
+            std::string TradeId;
+            Enums::TradeStatus Status;
+            std::uint64_t Sequence;
+        };
+
+        // A trade as the last record still in flight leaves it
+        struct PendingState {
+            bool Exists;
+            Enums::TradeStatus Status;
+            std::uint64_t Sequence;
+        };
+
+        JournalOptions m_options;
+        std::shared_ptr<Interfaces::ITradeRepository> m_memory;
+        int m_fd;
+
+        // Guards the pending batch, the sequence counters and the log order
+        mutable std::mutex m_mutex;
+        std::condition_variable m_work;
+        std::condition_variable m_durable;
+        std::string m_pending;
+        std::vector<PendingOp> m_pendingOps;
+        std::unordered_map<std::string, PendingState> m_pendingState;
+        std::uint64_t m_opSequence;
+        std::uint64_t m_appendedBytes;
+        std::uint64_t m_durableBytes;
+        std::string m_failure;
+        bool m_stopping;
+        std::thread m_writer;
+
+        std::atomic<std::uint64_t> m_commits{0};
+        std::atomic<std::uint64_t> m_records{0};
+        std::uint64_t m_recoveredRecords;
+        std::uint64_t m_truncatedBytes;
+
+        void Recover();
+        // Applies one checksummed record; false if it cannot be decoded
+        bool Replay(const char* payload, std::size_t payloadSize);
+        void WriterLoop();
+        void ApplyLocked(std::vector<PendingOp>& ops);
+        // Caller holds m_mutex. Appends the record and queues its mutation.
+        void LogSave(const std::shared_ptr<Models::Trade>& trade);
+        void LogDelete(const std::string& tradeId);
+        void LogStatus(const std::string& tradeId, Enums::TradeStatus status);
+        void Queue(PendingOp op, bool exists);
+        // Caller holds m_mutex. Status after every appended record; false if
+        // the trade does not exist.
+        bool CurrentStatus(const std::string& tradeId, Enums::TradeStatus& status) const;
+        Interfaces::StatusTransition DecideLocked(const std::string& tradeId, Enums::TradeStatus status,
+                                                  Interfaces::StatusTransitionRule rule) const;
+        template <typename Append>
+        void Commit(Append&& append);
+    };
+
+} // namespace Repositories
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../Interfaces/ITradeRepository.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Repositories {
+
+    class SnapshotError : public std::runtime_error {
+    public:
+        explicit SnapshotError(const std::string& message) : std::runtime_error(message) {}
+    };
+
+    struct SnapshotInfo {
+        std::uint64_t Trades;
+        std::uint64_t Strings;  // Distinct strings in the string section
+        std::uint64_t Bytes;
+    };
+
+    // Writes every trade in repository to a snapshot file. The file is
+    // written beside path and renamed over it once synced, so readers never
+    // see a partial snapshot.
+    SnapshotInfo WriteTradeSnapshot(Interfaces::ITradeRepository& repository, const std::string& path);
+
+    // Parsed view over a mapped snapshot; defined in SnapshotTradeRepository.cpp
+    class SnapshotImage;
+
+    // Repository served from a memory-mapped snapshot. Opening maps the file
+    // and checks its header, so start-up cost does not grow with the book.
+    // Snapshot trades are read in place: hash indexes in the file answer
+    // GetById and GetByIdempotencyKey, and a Trade is built only for the
+    // trades a query returns. Counterparty, instrument, asset class and
+    // status queries scan the fixed-size records of the snapshot.
+    //
+    // Saves go to an in-memory sharded overlay. A snapshot trade that is
+    // saved again, deleted or has its status changed is hidden by a
+    // tombstone bit, and the overlay copy, if any, takes its place. Nothing
+    // after the snapshot is durable; write a new snapshot to keep it.
+    //
+    // Writers are serialised by one lock and notify listeners under it.
+    // Listeners see changes made after they register, never the snapshot.
+    class SnapshotTradeRepository : public Interfaces::ITradeRepository {
+    public:
+        // Throws SnapshotError if the file is missing or not a valid snapshot
+        explicit SnapshotTradeRepository(const std::string& snapshotPath, std::size_t overlayShards = 16);
+        ~SnapshotTradeRepository() override;
+
+        SnapshotTradeRepository(const SnapshotTradeRepository&) = delete;
+        SnapshotTradeRepository& operator=(const SnapshotTradeRepository&) = delete;
+
+        void Save(std::shared_ptr<Models::Trade> trade) override;
+        void SaveBatch(const std::vector<std::shared_ptr<Models::Trade>>& trades) override;
+        void Delete(const std::string& tradeId) override;
+        bool UpdateStatus(const std::string& tradeId, Enums::TradeStatus status) override;
+        Interfaces::StatusTransition TransitionStatus(const std::string& tradeId, Enums::TradeStatus status,
+                                                      Interfaces::StatusTransitionRule rule) override;
+        std::vector<Interfaces::StatusTransition> TransitionStatuses(const std::vector<std::string>& tradeIds,
+                                                                     Enums::TradeStatus status,
+                                                                     Interfaces::StatusTransitionRule rule) override;
+
+        std::shared_ptr<Models::Trade> GetById(const std::string& tradeId) override;
+        std::shared_ptr<Models::Trade> GetByIdempotencyKey(const std::string& idempotencyKey) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByCounterparty(const std::string& counterparty) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetAll() override;
+        bool Exists(const std::string& tradeId) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByInstrument(const std::string& instrumentId) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByAssetClass(Enums::AssetClass assetClass) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByStatus(Enums::TradeStatus status) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetBySettlementDate(
+            std::chrono::system_clock::time_point date) override;
+        std::vector<std::shared_ptr<Models::Trade>> GetByIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) override;
+
+        Interfaces::IdempotencyReservation ReserveIdempotencyKey(const std::string& idempotencyKey) override;
+        void ReleaseIdempotencyKey(const std::string& idempotencyKey) override;
+        std::vector<Interfaces::IdempotencyReservation> TryReserveIdempotencyKeys(
+            const std::vector<std::string>& idempotencyKeys) override;
+
+        void AddListener(std::shared_ptr<Interfaces::ITradeRepositoryListener> listener) override;
+        // Snapshot trades first, then the overlay
+        void ForEach(const Interfaces::TradePredicate& predicate, const Interfaces::TradeVisitor& visitor) override;
+        std::string ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                             const Interfaces::TradePredicate& predicate,
+                             const Interfaces::TradeVisitor& visitor) override;
+
+        // Trades in the mapped file, including hidden ones
+        std::size_t SnapshotTradeCount() const;
+
+    private:
+        std::unique_ptr<SnapshotImage> m_image;
+        std::shared_ptr<Interfaces::ITradeRepository> m_overlay;
+
+        // Writers hold it exclusively; readers share it while they consult
+        // the tombstones
+        mutable std::shared_mutex m_mutex;
+        std::vector<std::uint64_t> m_hidden;  // One bit per snapshot record
+        std::vector<std::shared_ptr<Interfaces::ITradeRepositoryListener>> m_listeners;
+
+        bool IsHidden(std::size_t record) const;
+        void Hide(std::size_t record);
+        // Visible snapshot record for tradeId, or SIZE_MAX
+        std::size_t FindVisible(const std::string& tradeId) const;
+        std::shared_ptr<Models::Trade> FindVisibleByKey(const std::string& idempotencyKey) const;
+        std::shared_ptr<Models::Trade> CurrentTrade(const std::string& tradeId) const;
+        void SaveLocked(const std::shared_ptr<Models::Trade>& trade);
+        Interfaces::StatusTransition TransitionLocked(const std::string& tradeId, Enums::TradeStatus status,
+                                                      Interfaces::StatusTransitionRule rule);
+
+        template <typename Match>
+        void CollectSnapshot(Match&& match, std::vector<std::shared_ptr<Models::Trade>>& out) const;
+        template <typename Visit>
+        bool ScanSnapshot(std::size_t& record, Visit&& visit) const;
+    };
+
+} // namespace Repositories
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../Interfaces/ITradeRepositoryListener.hpp"
+#include "../SymbolTable.hpp"
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Risk {
+
+    struct CounterpartyUsage {
+        bool HasLimit;     // False when neither a limit nor a default applies
+        double Limit;
+        double Exposure;   // Notional of open trades and bookings in flight
+    };
+
+    // Pre-trade credit limits on the gross notional each counterparty has
+    // open. TradeService::SetCounterpartyLimits turns the check on: a booking
+    // reserves its notional before the trade is saved, commits it once the
+    // save succeeds and releases it otherwise. Register the same object as a
+    // listener on the repository so that exposure falls again when a trade
+    // is settled, cancelled, failed or deleted:
+    //
+    //   auto limits = std::make_shared<Risk::CounterpartyLimits>();
+    //   limits->ReloadLimits({{"Goldman Sachs", 5e8}});
+    //   repo->AddListener(limits);
+    //   service->SetCounterpartyLimits(limits);
+    //
+    // Pending and Booked trades hold exposure. Notionals are summed without
+    // currency conversion and counted in hundredths, so a release cancels its
+    // reservation exactly.
+    //
+    // Counters live in fixed-size chunks indexed by SymbolId, allocated on
+    // first use and never moved, so finding a counterparty is two loads and
+    // reserving is one compare-and-swap loop. Limits can be changed while
+    // bookings run; each booking sees either the old or the new limit of its
+    // counterparty.
+    class CounterpartyLimits : public Interfaces::ITradeRepositoryListener {
+    public:
+        CounterpartyLimits();
+        ~CounterpartyLimits() override;
+        CounterpartyLimits(const CounterpartyLimits&) = delete;
+        CounterpartyLimits& operator=(const CounterpartyLimits&) = delete;
+
+        static bool HoldsExposure(Enums::TradeStatus status);
+
+        // Applies to counterparties without a limit of their own. Unlimited
+        // unless set; a negative value turns it off again.
+        void SetDefaultLimit(double limit);
+        // Throws std::invalid_argument for a negative or non-finite limit
+        void SetLimit(std::string_view counterparty, double limit);
+        void ClearLimit(std::string_view counterparty);
+        // Replaces every counterparty limit; counterparties left out fall
+        // back to the default. Nothing changes if any limit is invalid.
+        void ReloadLimits(const std::unordered_map<std::string, double>& limits);
+
+        // Adds notional to the counterparty's exposure unless that would take
+        // it over its limit. Safe from any number of threads.
+        bool Reserve(Symbols::SymbolId counterparty, double notional);
+        // The booking that reserved notional was saved. Exposure already
+        // counts the reservation, so nothing changes; keeping no separate
+        // in-flight counter saves two atomic updates per booking.
+        void Commit(Symbols::SymbolId, double) {}
+        // The booking that reserved notional failed
+        void Release(Symbols::SymbolId counterparty, double notional);
+
+        // Starts pulling the counterparty's counters into cache. With a
+        // million counterparties Reserve is one cache miss; issuing this as
+        // soon as the id is known overlaps the miss with other work.
+        void Prefetch(Symbols::SymbolId counterparty) const {
+#if defined(__GNUC__)
+            const Slot* chunk = m_chunks[counterparty >> ChunkBits].load(std::memory_order_acquire);
+            if (chunk) {
+                __builtin_prefetch(&chunk[counterparty & ChunkMask], 1);
+            }
+#else
+            (void)counterparty;
+#endif
+        }
+
+        CounterpartyUsage GetUsage(std::string_view counterparty) const;
+
+        // Recomputes exposure from the given trades, dropping reservations.
+        // Limits are kept. Call before booking starts.
+        void Rebuild(const std::vector<std::shared_ptr<Models::Trade>>& trades);
+
+        // Bookings add exposure through Reserve, so a save only gives back
+        // the exposure of the trade it replaced
+        void OnTradeSaved(const std::shared_ptr<Models::Trade>& trade,
+                          const std::shared_ptr<Models::Trade>& replaced) override;
+        void OnTradeDeleted(const std::shared_ptr<Models::Trade>& trade) override;
+        void OnTradeStatusChanged(const std::shared_ptr<Models::Trade>& trade,
+                                  Enums::TradeStatus previousStatus) override;
+
+    private:
+        // Sixteen bytes, so a slot never straddles two cache lines
+        struct alignas(16) Slot {
+            std::atomic<std::int64_t> Limit;
+            std::atomic<std::int64_t> Exposure;
+        };
+
+        static constexpr unsigned ChunkBits = 12;
+        static constexpr std::size_t ChunkSize = std::size_t{1} << ChunkBits;
+        static constexpr std::size_t ChunkMask = ChunkSize - 1;
+        // Covers every id the symbol table can hand out
+        static constexpr std::size_t MaxChunks = std::size_t{1} << 16;
+
+        std::unique_ptr<std::atomic<Slot*>[]> m_chunks;
+        std::atomic<std::int64_t> m_defaultLimit;
+        // Serialises limit changes and remembers which counterparties have one
+        std::mutex m_limitMutex;
+        std::unordered_set<Symbols::SymbolId> m_limited;
+
+        Slot* Find(Symbols::SymbolId counterparty) const;
+        Slot& Get(Symbols::SymbolId counterparty);
+        void SetLimitLocked(Symbols::SymbolId counterparty, std::int64_t limit);
+        void AddExposure(const Models::Trade& trade, std::int64_t sign);
+    };
+
+} // namespace Risk
+} // namespace Core
+} // namespace TradeBookEngine
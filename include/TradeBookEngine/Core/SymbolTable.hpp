@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Symbols {
+
+    using SymbolId = std::uint32_t;
+
+    // Id of the empty string, interned up front
+    constexpr SymbolId EmptySymbol = 0;
+
+    // Attribute keys interned up front in this order, so code can test for
+    // them without a lookup
+    namespace WellKnown {
+        constexpr SymbolId Exchange = 1;
+        constexpr SymbolId MaturityDate = 2;
+        constexpr SymbolId CreditRating = 3;
+    } // namespace WellKnown
+
+    // Process-wide interning table for strings that repeat across trades
+    // (instruments, counterparties, currencies, users). Each distinct string
+    // is stored once and named by a dense 32-bit id, so trades can hold ids
+    // and compare them as integers.
+    //
+    // Interning takes a shared lock on the hit path and an exclusive lock to
+    // add a string. Resolve is lock-free: strings live in fixed-size chunks
+    // that are never moved or freed, so a resolved reference stays valid for
+    // the life of the process.
+    class SymbolTable {
+    public:
+        static SymbolTable& Instance();
+
+        SymbolId Intern(std::string_view text);
+
+        // Looks a string up without adding it
+        bool Find(std::string_view text, SymbolId& id) const;
+
+        const std::string& Resolve(SymbolId id) const {
+            const std::string* chunk = m_chunks[id >> ChunkBits].load(std::memory_order_acquire);
+            return chunk[id & ChunkMask];
+        }
+
+        std::size_t Size() const;
+
+        // Bytes held by the table: chunks, string heap buffers and the lookup map
+        std::size_t MemoryUsage() const;
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+    private:
+        static constexpr unsigned ChunkBits = 12;
+        static constexpr std::size_t ChunkSize = std::size_t{1} << ChunkBits;
+        static constexpr std::size_t ChunkMask = ChunkSize - 1;
+        // 2^28 symbols; the chunk directory itself is 512 KiB
+        static constexpr std::size_t MaxChunks = std::size_t{1} << 16;
+
+        SymbolTable();
+        ~SymbolTable();
+
+        mutable std::shared_mutex m_mutex;
+        // Keys view the interned strings themselves
+        std::unordered_map<std::string_view, SymbolId> m_ids;
+        std::unique_ptr<std::atomic<std::string*>[]> m_chunks;
+        std::size_t m_size;
+        std::size_t m_heapBytes;
+    };
+
+    inline SymbolId Intern(std::string_view text) {
+        return SymbolTable::Instance().Intern(text);
+    }
+
+    inline const std::string& Resolve(SymbolId id) {
+        return SymbolTable::Instance().Resolve(id);
+    }
+
+} // namespace Symbols
+} // namespace Core
+} // namespace TradeBookEngine
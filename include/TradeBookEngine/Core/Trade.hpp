@@ -2,8 +2,11 @@
 
 #include <string>
 #include <chrono>
-#include <unordered_map>
+#include <atomic>
 #include "Enums.hpp"
+#include "SymbolTable.hpp"
+#include "AttributeMap.hpp"
+#include "CurrencyCode.hpp"
 
 namespace TradeBookEngine {
 namespace Core {
@@ -11,21 +14,37 @@ namespace Models {
 
     class Trade {
     private:
+        // Trades are shared with callers and events while the repository
+        // changes their status, so it is atomic; copies take its value
+        struct AtomicStatus {
+            std::atomic<Enums::TradeStatus> Value;
+
+            explicit AtomicStatus(Enums::TradeStatus status) : Value(status) {}
+            AtomicStatus(const AtomicStatus& other) : Value(other.Value.load(std::memory_order_acquire)) {}
+            AtomicStatus& operator=(const AtomicStatus& other) {
+                Value.store(other.Value.load(std::memory_order_acquire), std::memory_order_release);
+                return *this;
+            }
+        };
+
         std::string m_tradeId;
         Enums::AssetClass m_assetClass;
-        std::string m_instrumentId;
-        std::string m_counterparty;
+        // Packed copy of the currency for integer keys; fills padding
+        CurrencyCode m_currencyCode;
+        // Repeating reference data is interned; the getters resolve the text
+        Symbols::SymbolId m_instrumentId;
+        Symbols::SymbolId m_counterparty;
+        Symbols::SymbolId m_currency;
+        Symbols::SymbolId m_createdBy;
         double m_notional;
-        std::string m_currency;
         Enums::TradeSide m_side;
         std::chrono::system_clock::time_point m_tradeDate;
         std::chrono::system_clock::time_point m_settlementDate;
-        std::unordered_map<std::string, std::string> m_additional;
+        AttributeMap m_additional;
         std::string m_idempotencyKey;
         std::string m_correlationId;
-        std::string m_createdBy;
         std::chrono::system_clock::time_point m_createdAt;
-        Enums::TradeStatus m_status;
+        AtomicStatus m_status;
 
     public:
         // Constructor
@@ -43,27 +62,46 @@ namespace Models {
         // Getters
         const std::string& GetTradeId() const { return m_tradeId; }
         Enums::AssetClass GetAssetClass() const { return m_assetClass; }
-        const std::string& GetInstrumentId() const { return m_instrumentId; }
-        const std::string& GetCounterparty() const { return m_counterparty; }
+        const std::string& GetInstrumentId() const { return Symbols::Resolve(m_instrumentId); }
+        const std::string& GetCounterparty() const { return Symbols::Resolve(m_counterparty); }
         double GetNotional() const { return m_notional; }
-        const std::string& GetCurrency() const { return m_currency; }
+        const std::string& GetCurrency() const { return Symbols::Resolve(m_currency); }
+        // Empty unless the currency is three letters A-Z
+        CurrencyCode GetCurrencyCode() const { return m_currencyCode; }
         Enums::TradeSide GetSide() const { return m_side; }
         const std::chrono::system_clock::time_point& GetTradeDate() const { return m_tradeDate; }
         const std::chrono::system_clock::time_point& GetSettlementDate() const { return m_settlementDate; }
-        const std::unordered_map<std::string, std::string>& GetAdditional() const { return m_additional; }
+        const AttributeMap& GetAdditional() const { return m_additional; }
         const std::string& GetIdempotencyKey() const { return m_idempotencyKey; }
         const std::string& GetCorrelationId() const { return m_correlationId; }
-        const std::string& GetCreatedBy() const { return m_createdBy; }
+        const std::string& GetCreatedBy() const { return Symbols::Resolve(m_createdBy); }
         const std::chrono::system_clock::time_point& GetCreatedAt() const { return m_createdAt; }
-        Enums::TradeStatus GetStatus() const { return m_status; }
+        Enums::TradeStatus GetStatus() const { return m_status.Value.load(std::memory_order_acquire); }
+
+        // Interned ids, for integer comparisons and index keys
+        Symbols::SymbolId GetInstrumentSymbol() const { return m_instrumentId; }
+        Symbols::SymbolId GetCounterpartySymbol() const { return m_counterparty; }
+        Symbols::SymbolId GetCurrencySymbol() const { return m_currency; }
+        Symbols::SymbolId GetCreatedBySymbol() const { return m_createdBy; }
 
         // Setters
-        void SetStatus(Enums::TradeStatus status) { m_status = status; }
+        // Unconditional; lifecycle changes go through the repository's
+        // TransitionStatus so its indexes and listeners stay in step
+        void SetStatus(Enums::TradeStatus status) { m_status.Value.store(status, std::memory_order_release); }
+        // Sets status only if the current one is still expected; otherwise
+        // loads the current one into expected and returns false
+        bool CompareExchangeStatus(Enums::TradeStatus& expected, Enums::TradeStatus status) {
+            return m_status.Value.compare_exchange_strong(expected, status, std::memory_order_acq_rel,
+                                                          std::memory_order_acquire);
+        }
         void SetIdempotencyKey(const std::string& key) { m_idempotencyKey = key; }
         void SetCorrelationId(const std::string& id) { m_correlationId = id; }
+        // For restoring persisted trades; booking stamps the time itself
+        void SetCreatedAt(const std::chrono::system_clock::time_point& createdAt) { m_createdAt = createdAt; }
         void AddAdditionalData(const std::string& key, const std::string& value) {
             m_additional[key] = value;
         }
+        void SetAdditional(const AttributeMap& additional) { m_additional = additional; }
     };
 
 } // namespace Models
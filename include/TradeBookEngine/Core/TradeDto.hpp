@@ -2,8 +2,8 @@
 
 #include <string>
 #include <chrono>
-#include <unordered_map>
 #include "Enums.hpp"
+#include "AttributeMap.hpp"
 
 namespace TradeBookEngine {
 namespace Core {
@@ -24,7 +24,7 @@ namespace Models {
         std::chrono::system_clock::time_point SettlementDate;
         
         // Additional metadata
-        std::unordered_map<std::string, std::string> Additional;
+        AttributeMap Additional;
         
         // Processing metadata
         std::string IdempotencyKey;
@@ -1,37 +1,152 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
 #include "Trade.hpp"
 #include "TradeDto.hpp"
+#include "BookingResult.hpp"
 #include "Interfaces/ITradeRepository.hpp"
 #include "Interfaces/IEventPublisher.hpp"
 #include "Validators/IAssetValidator.hpp"
+#include "Calendars/HolidayCalendar.hpp"
+#include "Metrics/BookingMetrics.hpp"
+#include "Risk/CounterpartyLimits.hpp"
 
 namespace TradeBookEngine {
 namespace Core {
 namespace Services {
 
+    // Where booked Trade objects are allocated
+    enum class TradeAllocation {
+        Heap,   // std::make_shared
+        Pooled  // Per-thread slab pool (Memory::SlabPool)
+    };
+
     class TradeService {
     private:
         std::shared_ptr<Interfaces::ITradeRepository> m_repository;
         std::shared_ptr<Interfaces::IEventPublisher> m_eventPublisher;
-        std::vector<std::shared_ptr<Validators::IAssetValidator>> m_validators;
+        // Indexed by AssetClass; empty slots skip asset-specific validation
+        std::array<std::shared_ptr<Validators::IAssetValidator>, Enums::AssetClassCount> m_validators;
+        TradeAllocation m_tradeAllocation;
+        std::shared_ptr<const Calendars::CalendarRegistry> m_settlementCalendars;
+        int m_settlementLag;
+        std::unique_ptr<Metrics::BookingMetrics> m_metrics;
+        bool m_metricsEnabled;
+        std::uint32_t m_metricsSampleInterval;
+        std::shared_ptr<Risk::CounterpartyLimits> m_limits;
 
     public:
         TradeService(std::shared_ptr<Interfaces::ITradeRepository> repository,
                     std::shared_ptr<Interfaces::IEventPublisher> eventPublisher);
 
+        // Registers the validator for its asset class. The first validator
+        // registered for a class is the one used.
         void AddValidator(std::shared_ptr<Validators::IAssetValidator> validator);
+
+        // Runs the checks BookTrade applies, without booking. Returns an empty
+        // string for a valid trade, which costs no heap allocation, or the
+        // rejection message.
+        std::string ValidateTrade(const Models::TradeDto& tradeDto) const;
+
+        // Pooled trades avoid the global heap on the booking path; their
+        // memory is recycled through the pool rather than returned to the system
+        void SetTradeAllocation(TradeAllocation allocation) { m_tradeAllocation = allocation; }
+
+        // Trades booked without a SettlementDate settle settlementLag business
+        // days after their TradeDate, on the calendar registered under their
+        // currency, or on weekdays if there is none. Calendars cover
+        // 1900-2199 by default; trades whose settlement date would fall
+        // outside are rejected with BookingErrorCode::TradeDateOutOfRange.
+        // Set before booking starts; a null registry turns derivation off.
+        void SetSettlementCalendars(std::shared_ptr<const Calendars::CalendarRegistry> calendars,
+                                    int settlementLag = 2);
+
+        // Booking outcome counters and per-stage latency histograms are
+        // recorded by default, per thread; see Metrics::BookingStage. Set
+        // before booking starts.
+        void SetMetricsEnabled(bool enabled) { m_metricsEnabled = enabled; }
+
+        // Each thread times the stages of one call in every interval (16 by
+        // default); reading the clock six times costs more than the rest of
+        // the instrumentation. Counters always see every booking.
+        void SetMetricsSampleInterval(std::uint32_t interval) { m_metricsSampleInterval = interval > 0 ? interval : 1; }
+
+        // Bookings whose notional would take their counterparty over its
+        // limit are rejected with BookingErrorCode::LimitBreached. The check
+        // runs after validation, just before the trade is saved. Set before
+        // booking starts; null turns it off. Services booking into the same
+        // book should share one CounterpartyLimits.
+        void SetCounterpartyLimits(std::shared_ptr<Risk::CounterpartyLimits> limits) { m_limits = std::move(limits); }
+
+        // Merges what every booking thread has recorded so far
+        Metrics::BookingMetricsSnapshot GetMetricsSnapshot() const { return m_metrics->Snapshot(); }
         
+        // Throws std::invalid_argument if the trade is rejected
         std::shared_ptr<Models::Trade> BookTrade(const Models::TradeDto& tradeDto);
+
+        // BookTrade without exceptions for rejected trades: the outcome holds
+        // the trade or a BookingError whose message is only built on request.
+        // Storage and publishing failures still throw.
+        BookingOutcome TryBookTrade(const Models::TradeDto& tradeDto);
+
+        // Books a batch of trades with one idempotency lookup, one repository
+        // save and one publish call. Never throws for invalid trades; each
+        // input gets a result at the same position.
+        std::vector<BookingResult> BookTrades(const Models::TradeDto* tradeDtos, std::size_t count);
+        std::vector<BookingResult> BookTrades(const std::vector<Models::TradeDto>& tradeDtos);
+
+        // Lifecycle changes. Each moves the trade only if
+        // Enums::IsValidTransition allows it from the status the trade has at
+        // that moment, deciding atomically in the repository: of a Settle and
+        // a Cancel racing on one trade exactly one applies and the other is
+        // Refused. A trade that already has the status comes back Unchanged.
+        Interfaces::StatusTransition SettleTrade(const std::string& tradeId);
+        Interfaces::StatusTransition CancelTrade(const std::string& tradeId);
+        Interfaces::StatusTransition FailTrade(const std::string& tradeId);
+
+        // Bulk forms with one repository call; each id gets a result at the
+        // same position
+        std::vector<Interfaces::StatusTransition> SettleTrades(const std::vector<std::string>& tradeIds);
+        std::vector<Interfaces::StatusTransition> CancelTrades(const std::vector<std::string>& tradeIds);
+        std::vector<Interfaces::StatusTransition> FailTrades(const std::vector<std::string>& tradeIds);
+
+        // End-of-day sweep: settles the Booked trades whose SettlementDate
+        // falls on the UTC day containing date and returns how many it
+        // settled. Only that day's trades are looked at; Failed trades are
+        // left for SettleTrade.
+        std::size_t SettleDueTrades(std::chrono::system_clock::time_point date);
+
         std::shared_ptr<Models::Trade> GetTrade(const std::string& tradeId);
         std::vector<std::shared_ptr<Models::Trade>> GetTradesByCounterparty(const std::string& counterparty);
+        std::vector<std::shared_ptr<Models::Trade>> GetTradesByInstrument(const std::string& instrumentId);
+        std::vector<std::shared_ptr<Models::Trade>> GetTradesByAssetClass(Enums::AssetClass assetClass);
+        std::vector<std::shared_ptr<Models::Trade>> GetTradesByStatus(Enums::TradeStatus status);
+        std::vector<std::shared_ptr<Models::Trade>> GetTradesBySettlementDate(std::chrono::system_clock::time_point date);
         std::vector<std::shared_ptr<Models::Trade>> GetAllTrades();
 
+        // Streaming alternatives to GetAllTrades that never copy the book
+        // into a vector; see ITradeRepository::ForEach and ReadPage
+        void ForEachTrade(const Interfaces::TradeVisitor& visitor,
+                          const Interfaces::TradePredicate& predicate = Interfaces::TradePredicate());
+        Interfaces::TradeCursor OpenTradeCursor(std::size_t pageSize,
+                                                const Interfaces::TradePredicate& predicate = Interfaces::TradePredicate(),
+                                                const std::string& continuationToken = std::string());
+
     private:
-        void ValidateTrade(const Models::TradeDto& tradeDto);
-        std::shared_ptr<Models::Trade> ConvertToTrade(const Models::TradeDto& tradeDto);
+        // Also resolves the settlement date ConvertToTrade should use, so the
+        // calendar is looked up once per booking
+        BookingError CheckTrade(const Models::TradeDto& tradeDto,
+                                std::chrono::system_clock::time_point& settlementDate) const;
+        std::shared_ptr<Models::Trade> ConvertToTrade(const Models::TradeDto& tradeDto,
+                                                      std::chrono::system_clock::time_point settlementDate);
+        bool SettlementDateFor(const Models::TradeDto& tradeDto,
+                               std::chrono::system_clock::time_point& settlementDate) const;
+        std::string RejectionMessage(const BookingError& error, const Models::TradeDto& tradeDto) const;
     };
 
 } // namespace Services
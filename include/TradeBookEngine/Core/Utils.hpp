@@ -3,21 +3,98 @@
 #include <string>
 #include <chrono>
 #include <random>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "CurrencyCode.hpp"
 
 namespace TradeBookEngine {
 namespace Core {
 namespace Utils {
 
+    // Lock-free generator of 64-bit, time-ordered ids:
+    //   41 bits  milliseconds since 2024-01-01T00:00:00Z
+    //   10 bits  node (process/shard) id
+    //   12 bits  sequence within the millisecond
+    // Ids are unique within a process and increase with generation time.
+    // When a millisecond's sequence is exhausted the id borrows from the next
+    // millisecond rather than waiting for the clock.
+    class SnowflakeIdGenerator {
+    public:
+        static constexpr int SequenceBits = 12;
+        static constexpr int NodeBits = 10;
+        static constexpr std::uint16_t MaxNodeId = (1u << NodeBits) - 1;
+        static constexpr std::int64_t EpochMilliseconds = 1704067200000LL;
+
+        // Characters written by Encode; 11 digits of 6 bits cover 64 bits
+        static constexpr std::size_t EncodedLength = 11;
+
+        explicit SnowflakeIdGenerator(std::uint16_t nodeId = 0);
+
+        std::uint64_t Next();
+        void SetNodeId(std::uint16_t nodeId);
+
+        // Fixed-width text form whose byte order matches numeric order
+        static void Encode(std::uint64_t id, char* out);
+        static bool Decode(const char* text, std::size_t length, std::uint64_t& id);
+        static std::chrono::system_clock::time_point TimestampOf(std::uint64_t id);
+
+        // Process-wide generator used by IdGenerator
+        static SnowflakeIdGenerator& Default();
+
+    private:
+        // (milliseconds since epoch << SequenceBits) | sequence
+        std::atomic<std::uint64_t> m_state;
+        std::atomic<std::uint64_t> m_nodeBits;
+    };
+
     class IdGenerator {
     public:
+        // "TRD-" / "EVT-" followed by an encoded snowflake id; 15 characters,
+        // short enough for the small-string buffer of common std::string ABIs
         static std::string GenerateTradeId();
+        static std::string GenerateEventId();
         static std::string GenerateCorrelationId();
     };
 
+    enum class TimestampPrecision {
+        Seconds,       // 2024-03-01T09:30:00Z
+        Milliseconds,  // 2024-03-01T09:30:00.123Z
+        Microseconds   // 2024-03-01T09:30:00.123456Z
+    };
+
     class DateTimeUtils {
     public:
+        // Buffer size that fits any timestamp FormatIso8601 writes, with a NUL
+        static constexpr std::size_t MaxIso8601Length = 28;
+
+        // UTC "YYYY-MM-DDTHH:MM:SS[.fff[fff]]Z", seconds precision
         static std::string ToString(const std::chrono::system_clock::time_point& timePoint);
+        // Parses what ParseIso8601 accepts; throws std::invalid_argument otherwise
         static std::chrono::system_clock::time_point FromString(const std::string& timeStr);
+
+        // Locale-free, thread-safe and allocation-free forms of ToString and
+        // FromString. FormatIso8601 writes UTC text and a NUL into buffer,
+        // truncating toward the past, and returns the length, or 0 if the
+        // buffer is too small or the year is outside 0000-9999.
+        static std::size_t FormatIso8601(const std::chrono::system_clock::time_point& timePoint,
+                                         char* buffer, std::size_t size,
+                                         TimestampPrecision precision = TimestampPrecision::Seconds);
+        // Accepts "YYYY-MM-DDTHH:MM:SS", up to nine fraction digits, then "Z"
+        // or a "+HH:MM"/"-HH:MM" offset. Returns false, leaving timePoint
+        // alone, for anything else, including out-of-range fields.
+        static bool ParseIso8601(const char* text, std::size_t length,
+                                 std::chrono::system_clock::time_point& timePoint);
+
+        // Days since 1970-01-01 for a proleptic Gregorian date, and back
+        static std::int64_t DaysFromCivil(std::int64_t year, unsigned month, unsigned day);
+        static void CivilFromDays(std::int64_t days, std::int64_t& year, unsigned& month, unsigned& day);
+        static unsigned DaysInMonth(std::int64_t year, unsigned month);
+
+        // Skips Saturdays and Sundays (UTC); see Calendars::HolidayCalendar
+        // for holidays. Negative counts step backwards. Only covers
+        // 1900-01-01 to 2199-12-31: throws std::out_of_range when the start
+        // date or the result falls outside.
         static std::chrono::system_clock::time_point AddBusinessDays(
             const std::chrono::system_clock::time_point& startDate, 
             int businessDays
@@ -26,7 +103,9 @@ namespace Utils {
 
     class ValidationUtils {
     public:
+        // Any active ISO-4217 code; a table probe, no allocation
         static bool IsValidCurrency(const std::string& currency);
+        static bool IsValidCurrency(Models::CurrencyCode currency) { return currency.IsIso4217(); }
         static bool IsValidNotional(double notional);
         static bool IsValidCounterparty(const std::string& counterparty);
         static bool IsValidInstrumentId(const std::string& instrumentId);
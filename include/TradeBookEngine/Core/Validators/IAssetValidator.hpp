@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "../TradeDto.hpp"
@@ -9,6 +10,22 @@ namespace TradeBookEngine {
 namespace Core {
 namespace Validators {
 
+    // One bit per validation failure, so a check can report several at once
+    // without building messages
+    using ValidationErrorMask = std::uint32_t;
+
+    namespace ValidationError {
+        constexpr ValidationErrorMask None = 0;
+        constexpr ValidationErrorMask WrongAssetClass = 1u << 0;
+        constexpr ValidationErrorMask InvalidInstrumentId = 1u << 1;
+        constexpr ValidationErrorMask InvalidNotional = 1u << 2;
+        constexpr ValidationErrorMask MissingExchange = 1u << 3;
+        constexpr ValidationErrorMask MissingMaturityDate = 1u << 4;
+        constexpr ValidationErrorMask MissingCreditRating = 1u << 5;
+        // Validators outside the library number their own bits from here
+        constexpr ValidationErrorMask FirstCustom = 1u << 16;
+    } // namespace ValidationError
+
     class IAssetValidator {
     public:
         virtual ~IAssetValidator() = default;
@@ -16,8 +33,16 @@ namespace Validators {
         virtual bool IsValid(const Models::TradeDto& tradeDto) const = 0;
         virtual std::vector<std::string> GetValidationErrors(const Models::TradeDto& tradeDto) const = 0;
         virtual Enums::AssetClass GetSupportedAssetClass() const = 0;
+
+        // Booking-path check: returns ValidationError bits, zero when valid.
+        // Override it so valid trades are checked without allocating;
+        // messages come from GetValidationErrors, on failure only. The default
+        // falls back to GetValidationErrors.
+        virtual ValidationErrorMask Check(const Models::TradeDto& tradeDto) const {
+            return GetValidationErrors(tradeDto).empty() ? ValidationError::None : ValidationError::FirstCustom;
+        }
     };
 
 } // namespace Validators
 } // namespace Core
-} // namespace TradeBookEngine
\ No newline at end of file
+} // namespace TradeBookEngine
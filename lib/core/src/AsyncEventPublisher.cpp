@@ -0,0 +1,164 @@
+#include "../include/TradeBookEngine/Core/Publishers/AsyncEventPublisher.hpp"
+#include <chrono>
+
+using namespace TradeBookEngine::Core::Publishers;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Events;
+
+AsyncEventPublisher::AsyncEventPublisher(std::shared_ptr<IEventPublisher> inner,
+                                         std::size_t capacity,
+                                         BackpressurePolicy policy,
+                                         std::size_t maxBatchSize)
+    : m_inner(std::move(inner))
+    , m_queue(capacity)
+    , m_policy(policy)
+    , m_maxBatchSize(maxBatchSize == 0 ? 1 : maxBatchSize) {
+    m_dispatcher = std::thread([this]() { DispatchLoop(); });
+}
+
+AsyncEventPublisher::~AsyncEventPublisher() {
+    m_stopping.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wake.notify_one();
+    }
+    if (m_dispatcher.joinable()) {
+        m_dispatcher.join();
+    }
+}
+
+void AsyncEventPublisher::Publish(const TradeBookedEvent& event) {
+    Enqueue(event);
+}
+
+void AsyncEventPublisher::PublishBatch(const std::vector<TradeBookedEvent>& events) {
+    for (const auto& event : events) {
+        Enqueue(event);
+    }
+}
+
+void AsyncEventPublisher::Enqueue(const TradeBookedEvent& event) {
+    switch (m_policy) {
+    case BackpressurePolicy::Block: {
+        int spins = 0;
+        while (!m_queue.TryPush(event)) {
+            {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_wake.notify_one();
+            }
+            if (++spins < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        break;
+    }
+    case BackpressurePolicy::DropOldest:
+        while (!m_queue.TryPush(event)) {
+            std::optional<TradeBookedEvent> evicted;
+            if (m_queue.TryPop(evicted)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        break;
+    case BackpressurePolicy::FailFast:
+        if (!m_queue.TryPush(event)) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            throw EventQueueFullError();
+        }
+        break;
+    }
+
+    m_enqueued.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_dispatcherIdle.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wake.notify_one();
+    }
+}
+
+std::size_t AsyncEventPublisher::Drain(std::vector<TradeBookedEvent>& batch) {
+    std::optional<TradeBookedEvent> slot;
+    while (batch.size() < m_maxBatchSize && m_queue.TryPop(slot)) {
+        batch.push_back(std::move(*slot));
+        slot.reset();
+    }
+    return batch.size();
+}
+
+void AsyncEventPublisher::DispatchLoop() {
+    std::vector<TradeBookedEvent> batch;
+    batch.reserve(m_maxBatchSize);
+
+    for (;;) {
+        if (Drain(batch) > 0) {
+            try {
+                m_inner->PublishBatch(batch);
+                m_published.fetch_add(batch.size(), std::memory_order_relaxed);
+            } catch (...) {
+                // Nobody to report to on this thread; count and carry on
+                m_publishFailures.fetch_add(batch.size(), std::memory_order_relaxed);
+            }
+            batch.clear();
+            continue;
+        }
+
+        if (m_stopping.load(std::memory_order_acquire)) {
+            if (m_queue.Size() == 0) {
+                break;
+            }
+            continue;
+        }
+
+        // Queue looks empty: sleep until a producer wakes us. The timeout
+        // bounds the cost of a wake-up lost to the relaxed emptiness check.
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_dispatcherIdle.store(true, std::memory_order_seq_cst);
+        if (m_queue.Size() == 0 && !m_stopping.load(std::memory_order_acquire)) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        m_dispatcherIdle.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AsyncEventPublisher::Flush() {
+    std::uint64_t target = m_enqueued.load(std::memory_order_relaxed);
+    for (;;) {
+        std::uint64_t processed = m_published.load(std::memory_order_relaxed)
+                                + m_publishFailures.load(std::memory_order_relaxed)
+                                + m_dropped.load(std::memory_order_relaxed);
+        if (processed >= target) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_wake.notify_one();
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+AsyncPublisherStats AsyncEventPublisher::GetStats() const {
+    AsyncPublisherStats stats;
+    stats.QueueDepth = m_queue.Size();
+    stats.Capacity = m_queue.Capacity();
+    stats.Enqueued = m_enqueued.load(std::memory_order_relaxed);
+    stats.Published = m_published.load(std::memory_order_relaxed);
+    stats.Dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.Rejected = m_rejected.load(std::memory_order_relaxed);
+    stats.PublishFailures = m_publishFailures.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Factory function; the inner publisher is borrowed and must outlive the decorator
+extern "C" {
+    IEventPublisher* CreateAsyncEventPublisher(IEventPublisher* inner, std::size_t capacity) {
+        return new AsyncEventPublisher(
+            std::shared_ptr<IEventPublisher>(inner, [](IEventPublisher*){}), capacity);
+    }
+
+    void DestroyAsyncEventPublisher(IEventPublisher* publisher) {
+        delete publisher;
+    }
+}
@@ -0,0 +1,102 @@
+#include "../include/TradeBookEngine/Core/AttributeMap.hpp"
+#include <limits>
+#include <stdexcept>
+
+using namespace TradeBookEngine::Core;
+using namespace TradeBookEngine::Core::Models;
+
+void SmallString::Assign(std::string_view text) {
+    if (text.size() <= InlineCapacity) {
+        // text may view this string's own bytes, so copy before releasing
+        char buffer[InlineCapacity];
+        if (!text.empty()) {
+            std::memcpy(buffer, text.data(), text.size());
+        }
+        Release();
+        if (!text.empty()) {
+            std::memcpy(m_bytes, buffer, text.size());
+        }
+        m_bytes[TagByte] = static_cast<char>(text.size());
+        return;
+    }
+
+    if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("Attribute value is too long");
+    }
+    char* data = new char[text.size()];
+    std::memcpy(data, text.data(), text.size());
+    auto size = static_cast<std::uint32_t>(text.size());
+    Release();
+    std::memcpy(m_bytes, &data, sizeof(data));
+    std::memcpy(m_bytes + sizeof(char*), &size, sizeof(size));
+    m_bytes[TagByte] = static_cast<char>(HeapTag);
+}
+
+void SmallString::Release() noexcept {
+    if (IsHeap()) {
+        delete[] HeapData();
+    }
+    std::memset(m_bytes, 0, sizeof(m_bytes));
+}
+
+AttributeMap::AttributeMap(AttributeMap&& other) noexcept
+    : m_inline(std::move(other.m_inline))
+    , m_overflow(std::move(other.m_overflow))
+    , m_size(other.m_size) {
+    other.m_overflow.clear();
+    other.m_size = 0;
+}
+
+AttributeMap& AttributeMap::operator=(AttributeMap&& other) noexcept {
+    if (this != &other) {
+        m_inline = std::move(other.m_inline);
+        m_overflow = std::move(other.m_overflow);
+        m_size = other.m_size;
+        other.m_overflow.clear();
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+SmallString& AttributeMap::operator[](Symbols::SymbolId key) {
+    Entry* entries = Data();
+    for (std::uint32_t i = 0; i < m_size; ++i) {
+        if (entries[i].KeyId == key) {
+            return entries[i].Value;
+        }
+    }
+
+    if (m_size < InlineCapacity) {
+        Entry& entry = m_inline[m_size++];
+        entry.KeyId = key;
+        entry.Value = std::string_view();
+        return entry.Value;
+    }
+    if (m_size == InlineCapacity) {
+        m_overflow.reserve(InlineCapacity * 2);
+        for (auto& entry : m_inline) {
+            m_overflow.push_back(std::move(entry));
+        }
+    }
+    m_overflow.push_back(Entry{key, SmallString()});
+    ++m_size;
+    return m_overflow.back().Value;
+}
+
+const SmallString* AttributeMap::Find(Symbols::SymbolId key) const {
+    const Entry* entries = Data();
+    for (std::uint32_t i = 0; i < m_size; ++i) {
+        if (entries[i].KeyId == key) {
+            return &entries[i].Value;
+        }
+    }
+    return nullptr;
+}
+
+const SmallString* AttributeMap::Find(std::string_view key) const {
+    Symbols::SymbolId id;
+    if (m_size == 0 || !Symbols::SymbolTable::Instance().Find(key, id)) {
+        return nullptr;
+    }
+    return Find(id);
+}
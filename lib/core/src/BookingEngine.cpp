@@ -0,0 +1,331 @@
+#include "../include/TradeBookEngine/Core/BookingEngine.hpp"
+#include <chrono>
+#include <exception>
+#include <optional>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace TradeBookEngine::Core::Services;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Metrics;
+
+extern "C" {
+    ITradeRepository* CreateInMemoryTradeRepository();
+    void DestroyInMemoryTradeRepository(ITradeRepository* repository);
+}
+
+namespace {
+
+    bool PinThread(std::thread& thread, int cpu) {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<std::size_t>(cpu), &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)thread;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+} // namespace
+
+BookingEngine::BookingEngine(std::shared_ptr<IEventPublisher> eventPublisher, BookingEngineOptions options)
+    : m_options(std::move(options)) {
+    std::size_t workerCount = m_options.WorkerCount;
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+    }
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    if (m_options.MaxBatchSize == 0) {
+        m_options.MaxBatchSize = 1;
+    }
+
+    m_workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>(m_options.QueueCapacity);
+        worker->Repository = m_options.RepositoryFactory
+            ? m_options.RepositoryFactory(i)
+            : std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(), DestroyInMemoryTradeRepository);
+        worker->Service = std::make_unique<TradeService>(worker->Repository, eventPublisher);
+        if (m_options.ConfigureService) {
+            m_options.ConfigureService(*worker->Service);
+        }
+        m_workers.push_back(std::move(worker));
+    }
+
+    // Start only once every worker exists, so a failed factory leaves no
+    // thread running
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        Worker& worker = *m_workers[i];
+        worker.Thread = std::thread([this, &worker]() { Run(worker); });
+        if (!m_options.CpuAffinity.empty()) {
+            worker.Pinned = PinThread(worker.Thread, m_options.CpuAffinity[i % m_options.CpuAffinity.size()]);
+        }
+    }
+}
+
+BookingEngine::~BookingEngine() {
+    m_stopping.store(true, std::memory_order_release);
+    for (auto& worker : m_workers) {
+        std::lock_guard<std::mutex> lock(worker->WakeMutex);
+        worker->Wake.notify_one();
+    }
+    for (auto& worker : m_workers) {
+        if (worker->Thread.joinable()) {
+            worker->Thread.join();
+        }
+    }
+}
+
+std::size_t BookingEngine::WorkerFor(const TradeDto& tradeDto) const {
+    const std::string* key = &tradeDto.Counterparty;
+    switch (m_options.Partition) {
+    case PartitionKey::Counterparty:
+        break;
+    case PartitionKey::InstrumentId:
+        key = &tradeDto.InstrumentId;
+        break;
+    case PartitionKey::IdempotencyKey:
+        key = &tradeDto.IdempotencyKey;
+        break;
+    }
+    return std::hash<std::string>()(*key) % m_workers.size();
+}
+
+std::future<BookingResult> BookingEngine::Submit(TradeDto tradeDto) {
+    Request request;
+    request.Done.Promise = std::make_unique<std::promise<BookingResult>>();
+    auto future = request.Done.Promise->get_future();
+    Worker& worker = *m_workers[WorkerFor(tradeDto)];
+    request.Dto = std::move(tradeDto);
+    Enqueue(worker, std::move(request));
+    return future;
+}
+
+void BookingEngine::Submit(TradeDto tradeDto, BookingCallback onBooked) {
+    Worker& worker = *m_workers[WorkerFor(tradeDto)];
+    Enqueue(worker, Request{std::move(tradeDto), Completion{nullptr, std::move(onBooked)}});
+}
+
+bool BookingEngine::TrySubmit(TradeDto& tradeDto, BookingCallback onBooked) {
+    Worker& worker = *m_workers[WorkerFor(tradeDto)];
+    Request request{std::move(tradeDto), Completion{nullptr, std::move(onBooked)}};
+    // TryPush leaves the request untouched when the queue is full
+    if (!worker.Queue.TryPush(std::move(request))) {
+        tradeDto = std::move(request.Dto);
+        return false;
+    }
+    worker.Submitted.fetch_add(1, std::memory_order_relaxed);
+    Notify(worker);
+    return true;
+}
+
+void BookingEngine::Enqueue(Worker& worker, Request&& request) {
+    int spins = 0;
+    while (!worker.Queue.TryPush(std::move(request))) {
+        Notify(worker);
+        if (++spins < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    worker.Submitted.fetch_add(1, std::memory_order_relaxed);
+    Notify(worker);
+}
+
+void BookingEngine::Notify(Worker& worker) {
+    if (worker.Idle.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(worker.WakeMutex);
+        worker.Wake.notify_one();
+    }
+}
+
+void BookingEngine::Run(Worker& worker) {
+    std::vector<TradeDto> dtos;
+    std::vector<Completion> completions;
+    dtos.reserve(m_options.MaxBatchSize);
+    completions.reserve(m_options.MaxBatchSize);
+    std::optional<Request> slot;
+
+    for (;;) {
+        while (dtos.size() < m_options.MaxBatchSize && worker.Queue.TryPop(slot)) {
+            dtos.push_back(std::move(slot->Dto));
+            completions.push_back(std::move(slot->Done));
+            slot.reset();
+        }
+        if (!dtos.empty()) {
+            BookBatch(worker, dtos, completions);
+            dtos.clear();
+            completions.clear();
+            continue;
+        }
+
+        if (m_stopping.load(std::memory_order_acquire)) {
+            if (worker.Queue.Size() == 0) {
+                break;
+            }
+            continue;
+        }
+
+        // Same idle protocol as AsyncEventPublisher: the timeout bounds the
+        // cost of a wake-up lost to the relaxed emptiness check
+        std::unique_lock<std::mutex> lock(worker.WakeMutex);
+        worker.Idle.store(true, std::memory_order_seq_cst);
+        if (worker.Queue.Size() == 0 && !m_stopping.load(std::memory_order_acquire)) {
+            worker.Wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        worker.Idle.store(false, std::memory_order_relaxed);
+    }
+}
+
+void BookingEngine::BookBatch(Worker& worker, const std::vector<TradeDto>& dtos,
+                              std::vector<Completion>& completions) {
+    std::vector<BookingResult> results;
+    std::exception_ptr failure;
+    try {
+        results = worker.Service->BookTrades(dtos.data(), dtos.size());
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    worker.Batches.fetch_add(1, std::memory_order_relaxed);
+
+    BookingResult failed;
+    if (failure) {
+        try {
+            std::rethrow_exception(failure);
+        } catch (const std::exception& error) {
+            failed.Error = error.what();
+        } catch (...) {
+            failed.Error = "Booking failed";
+        }
+        // Not Rejected: SaveBatch may have stored the trades before the
+        // publisher threw
+        worker.Failed.fetch_add(dtos.size(), std::memory_order_relaxed);
+    } else {
+        std::uint64_t booked = 0, duplicates = 0, rejected = 0;
+        for (const auto& result : results) {
+            booked += result.Status == BookingStatus::Booked ? 1u : 0u;
+            duplicates += result.Status == BookingStatus::Duplicate ? 1u : 0u;
+            rejected += result.Status == BookingStatus::Rejected ? 1u : 0u;
+        }
+        worker.Booked.fetch_add(booked, std::memory_order_relaxed);
+        worker.Duplicates.fetch_add(duplicates, std::memory_order_relaxed);
+        worker.Rejected.fetch_add(rejected, std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < completions.size(); ++i) {
+        auto& done = completions[i];
+        if (done.Promise) {
+            if (failure) {
+                done.Promise->set_exception(failure);
+            } else {
+                done.Promise->set_value(std::move(results[i]));
+            }
+        } else if (done.Callback) {
+            try {
+                done.Callback(failure ? failed : results[i]);
+            } catch (...) {
+                // Nobody to report to on this thread, and the outcome is
+                // already counted; a throwing callback must not stop the worker
+            }
+        }
+    }
+    worker.Completed.fetch_add(completions.size(), std::memory_order_release);
+}
+
+void BookingEngine::Flush() {
+    std::vector<std::uint64_t> targets;
+    targets.reserve(m_workers.size());
+    for (const auto& worker : m_workers) {
+        targets.push_back(worker->Submitted.load(std::memory_order_relaxed));
+    }
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        Worker& worker = *m_workers[i];
+        while (worker.Completed.load(std::memory_order_acquire) < targets[i]) {
+            {
+                std::lock_guard<std::mutex> lock(worker.WakeMutex);
+                worker.Wake.notify_one();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+std::shared_ptr<Trade> BookingEngine::GetTrade(const std::string& tradeId) {
+    for (auto& worker : m_workers) {
+        if (auto trade = worker->Repository->GetById(tradeId)) {
+            return trade;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<Trade>> BookingEngine::GetTradesByCounterparty(const std::string& counterparty) {
+    if (m_options.Partition == PartitionKey::Counterparty) {
+        TradeDto probe;
+        probe.Counterparty = counterparty;
+        return m_workers[WorkerFor(probe)]->Repository->GetByCounterparty(counterparty);
+    }
+    std::vector<std::shared_ptr<Trade>> trades;
+    for (auto& worker : m_workers) {
+        auto part = worker->Repository->GetByCounterparty(counterparty);
+        trades.insert(trades.end(), part.begin(), part.end());
+    }
+    return trades;
+}
+
+void BookingEngine::ForEachTrade(const TradeVisitor& visitor, const TradePredicate& predicate) {
+    bool keepGoing = true;
+    auto visit = [&](const Trade& trade) {
+        keepGoing = visitor(trade);
+        return keepGoing;
+    };
+    for (auto& worker : m_workers) {
+        worker->Repository->ForEach(predicate, visit);
+        if (!keepGoing) {
+            return;
+        }
+    }
+}
+
+std::vector<BookingWorkerStats> BookingEngine::GetStats() const {
+    std::vector<BookingWorkerStats> stats;
+    stats.reserve(m_workers.size());
+    for (const auto& worker : m_workers) {
+        BookingWorkerStats entry;
+        entry.QueueDepth = worker->Queue.Size();
+        entry.Submitted = worker->Submitted.load(std::memory_order_relaxed);
+        entry.Booked = worker->Booked.load(std::memory_order_relaxed);
+        entry.Duplicates = worker->Duplicates.load(std::memory_order_relaxed);
+        entry.Rejected = worker->Rejected.load(std::memory_order_relaxed);
+        entry.Failed = worker->Failed.load(std::memory_order_relaxed);
+        entry.Batches = worker->Batches.load(std::memory_order_relaxed);
+        entry.Pinned = worker->Pinned;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+BookingMetricsSnapshot BookingEngine::GetMetricsSnapshot() const {
+    BookingMetricsSnapshot merged;
+    merged.TicksPerNanosecond = TicksPerNanosecond();
+    for (auto& stage : merged.Stages) {
+        stage.TicksPerNanosecond = merged.TicksPerNanosecond;
+    }
+    for (const auto& worker : m_workers) {
+        merged.Merge(worker->Service->GetMetricsSnapshot());
+    }
+    return merged;
+}
@@ -0,0 +1,226 @@
+#include "../include/TradeBookEngine/Core/Metrics/BookingMetrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+using namespace TradeBookEngine::Core::Metrics;
+
+namespace {
+
+    struct ClockAnchor {
+        std::uint64_t Ticks;
+        std::chrono::steady_clock::time_point Time;
+    };
+
+    // Taken when the library is loaded; the longer the process runs before
+    // the first snapshot, the more precise the measured tick rate
+    const ClockAnchor LoadTime{ReadTicks(), std::chrono::steady_clock::now()};
+
+    std::atomic<std::uint64_t> NextMetricsId{1};
+
+} // namespace
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Metrics {
+
+    double TicksPerNanosecond() {
+#if defined(TRADEBOOK_METRICS_TSC)
+        const auto minimum = std::chrono::milliseconds(10);
+        auto elapsed = std::chrono::steady_clock::now() - LoadTime.Time;
+        if (elapsed < minimum) {
+            std::this_thread::sleep_for(minimum - elapsed);
+        }
+        auto now = std::chrono::steady_clock::now();
+        auto ticks = ReadTicks();
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - LoadTime.Time).count();
+        return static_cast<double>(ticks - LoadTime.Ticks) / static_cast<double>(nanos);
+#else
+        return 1.0;
+#endif
+    }
+
+    void HistogramSnapshot::Add(const LatencyHistogram& histogram) {
+        for (std::size_t b = 0; b < LatencyHistogram::BucketCount; ++b) {
+            auto count = histogram.Bucket(b);
+            Buckets[b] += count;
+            Count += count;
+        }
+        SumTicks += histogram.Sum();
+        MaxTicks = std::max(MaxTicks, histogram.Max());
+    }
+
+    void HistogramSnapshot::Add(const HistogramSnapshot& other) {
+        for (std::size_t b = 0; b < LatencyHistogram::BucketCount; ++b) {
+            Buckets[b] += other.Buckets[b];
+        }
+        Count += other.Count;
+        SumTicks += other.SumTicks;
+        MaxTicks = std::max(MaxTicks, other.MaxTicks);
+    }
+
+    double HistogramSnapshot::MeanNanos() const {
+        if (Count == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(SumTicks) / static_cast<double>(Count) / TicksPerNanosecond;
+    }
+
+    double HistogramSnapshot::MaxNanos() const {
+        return static_cast<double>(MaxTicks) / TicksPerNanosecond;
+    }
+
+    double HistogramSnapshot::PercentileNanos(double percentile) const {
+        if (Count == 0) {
+            return 0.0;
+        }
+        auto rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(Count) + 0.5);
+        rank = std::min(std::max<std::uint64_t>(rank, 1), Count);
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < LatencyHistogram::BucketCount; ++b) {
+            seen += Buckets[b];
+            if (seen >= rank) {
+                auto lower = static_cast<double>(LatencyHistogram::BucketLowerBound(b));
+                auto upper = b + 1 < LatencyHistogram::BucketCount
+                    ? static_cast<double>(LatencyHistogram::BucketLowerBound(b + 1)) : lower;
+                // Single-value buckets are exact; never report beyond the maximum
+                auto value = upper - lower > 1.0 ? (lower + upper) / 2.0 : lower;
+                return std::min(value, static_cast<double>(MaxTicks)) / TicksPerNanosecond;
+            }
+        }
+        return MaxNanos();
+    }
+
+    const char* BookingStageName(BookingStage stage) {
+        switch (stage) {
+        case BookingStage::IdempotencyLookup: return "IdempotencyLookup";
+        case BookingStage::Validation: return "Validation";
+        case BookingStage::Conversion: return "Conversion";
+        case BookingStage::LimitCheck: return "LimitCheck";
+        case BookingStage::RepositorySave: return "RepositorySave";
+        case BookingStage::Publish: return "Publish";
+        case BookingStage::Total: return "Total";
+        case BookingStage::BatchReservation: return "BatchReservation";
+        case BookingStage::BatchSave: return "BatchSave";
+        case BookingStage::BatchPublish: return "BatchPublish";
+        case BookingStage::BatchTotal: return "BatchTotal";
+        }
+        return "Unknown";
+    }
+
+    const char* RejectReasonName(std::size_t reason) {
+        // Indexed by BookingErrorCode
+        static const char* const names[RejectReasonCount] = {
+            "Other", "EmptyInstrumentId", "EmptyCounterparty", "NonPositiveNotional", "EmptyCurrency",
+            "AssetValidation", "LimitBreached", "TradeDateOutOfRange"
+        };
+        return reason < RejectReasonCount ? names[reason] : "Unknown";
+    }
+
+    void BookingMetricsSnapshot::Merge(const BookingMetricsSnapshot& other) {
+        for (std::size_t s = 0; s < BookingStageCount; ++s) {
+            Stages[s].Add(other.Stages[s]);
+        }
+        Booked += other.Booked;
+        IdempotentHits += other.IdempotentHits;
+        Rejected += other.Rejected;
+        for (std::size_t r = 0; r < RejectReasonCount; ++r) {
+            RejectsByReason[r] += other.RejectsByReason[r];
+        }
+        LockWaits += other.LockWaits;
+        LockWaitTicks += other.LockWaitTicks;
+        Threads += other.Threads;
+    }
+
+    std::string BookingMetricsSnapshot::ToText() const {
+        std::ostringstream out;
+        out << "Booking metrics (" << Threads << " thread" << (Threads == 1 ? "" : "s") << ")\n";
+        out << "  booked " << Booked << ", idempotent hits " << IdempotentHits << ", rejected " << Rejected << "\n";
+        if (Rejected > 0) {
+            out << "  rejects:";
+            for (std::size_t r = 0; r < RejectReasonCount; ++r) {
+                if (RejectsByReason[r] > 0) {
+                    out << " " << RejectReasonName(r) << "=" << RejectsByReason[r];
+                }
+            }
+            out << "\n";
+        }
+        out << "  repository lock waits " << LockWaits << " (" << static_cast<std::uint64_t>(LockWaitNanos())
+            << " ns)\n";
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "  %-18s %10s %10s %10s %10s %10s %10s %10s\n",
+                      "stage (ns)", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+        out << line;
+        for (std::size_t s = 0; s < BookingStageCount; ++s) {
+            const auto& stage = Stages[s];
+            if (stage.Count == 0) {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "  %-18s %10llu %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f\n",
+                          BookingStageName(static_cast<BookingStage>(s)),
+                          static_cast<unsigned long long>(stage.Count), stage.MeanNanos(),
+                          stage.PercentileNanos(50.0), stage.PercentileNanos(90.0), stage.PercentileNanos(99.0),
+                          stage.PercentileNanos(99.9), stage.MaxNanos());
+            out << line;
+        }
+        return out.str();
+    }
+
+    thread_local std::array<BookingMetrics::CacheEntry, 4> BookingMetrics::t_cache;
+    thread_local std::size_t BookingMetrics::t_nextEvict = 0;
+
+    BookingMetrics::BookingMetrics()
+        : m_id(NextMetricsId.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    ThreadBookingMetrics& BookingMetrics::Register() {
+        auto self = std::this_thread::get_id();
+        ThreadBookingMetrics* block = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& entry : m_blocks) {
+                if (entry.first == self) {
+                    block = entry.second.get();
+                    break;
+                }
+            }
+            if (!block) {
+                m_blocks.emplace_back(self, std::make_unique<ThreadBookingMetrics>());
+                block = m_blocks.back().second.get();
+            }
+        }
+        t_cache[t_nextEvict++ % t_cache.size()] = CacheEntry{m_id, block};
+        return *block;
+    }
+
+    BookingMetricsSnapshot BookingMetrics::Snapshot() const {
+        BookingMetricsSnapshot snapshot;
+        snapshot.TicksPerNanosecond = Metrics::TicksPerNanosecond();
+        for (auto& stage : snapshot.Stages) {
+            stage.TicksPerNanosecond = snapshot.TicksPerNanosecond;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        snapshot.Threads = m_blocks.size();
+        for (const auto& entry : m_blocks) {
+            const auto& block = *entry.second;
+            for (std::size_t s = 0; s < BookingStageCount; ++s) {
+                snapshot.Stages[s].Add(block.Stages[s]);
+            }
+            snapshot.Booked += block.Booked.load(std::memory_order_relaxed);
+            snapshot.IdempotentHits += block.IdempotentHits.load(std::memory_order_relaxed);
+            for (std::size_t r = 0; r < RejectReasonCount; ++r) {
+                auto rejects = block.RejectsByReason[r].load(std::memory_order_relaxed);
+                snapshot.RejectsByReason[r] += rejects;
+                snapshot.Rejected += rejects;
+            }
+            snapshot.LockWaits += block.LockWaits.load(std::memory_order_relaxed);
+            snapshot.LockWaitTicks += block.LockWaitTicks.load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+} // namespace Metrics
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,295 @@
+#include "../include/TradeBookEngine/Core/Analytics/ColumnKernels.hpp"
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRADEBOOK_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(__SSE2__)
+#define TRADEBOOK_KERNELS_SSE2 1
+#endif
+#endif
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Analytics {
+namespace Kernels {
+
+namespace {
+
+    // Scalar tails and the portable fallback. Four accumulators break the
+    // add dependency chain even where nothing is vectorised.
+
+    double SumScalar(const double* values, std::size_t begin, std::size_t count) {
+        double a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+        std::size_t i = begin;
+        for (; i + 4 <= count; i += 4) {
+            a0 += values[i];
+            a1 += values[i + 1];
+            a2 += values[i + 2];
+            a3 += values[i + 3];
+        }
+        for (; i < count; ++i) {
+            a0 += values[i];
+        }
+        return (a0 + a1) + (a2 + a3);
+    }
+
+    double SumWhereEqualsScalar(const double* values, const std::uint8_t* keys,
+                                std::size_t begin, std::size_t count, std::uint8_t key) {
+        double a0 = 0.0, a1 = 0.0;
+        std::size_t i = begin;
+        for (; i + 2 <= count; i += 2) {
+            a0 += keys[i] == key ? values[i] : 0.0;
+            a1 += keys[i + 1] == key ? values[i + 1] : 0.0;
+        }
+        for (; i < count; ++i) {
+            a0 += keys[i] == key ? values[i] : 0.0;
+        }
+        return a0 + a1;
+    }
+
+    MinMaxResult MinMaxScalar(const double* values, std::size_t begin, std::size_t count, MinMaxResult result) {
+        for (std::size_t i = begin; i < count; ++i) {
+            result.Min = values[i] < result.Min ? values[i] : result.Min;
+            result.Max = values[i] > result.Max ? values[i] : result.Max;
+        }
+        return result;
+    }
+
+    MinMaxResult EmptyRange() {
+        return MinMaxResult{std::numeric_limits<double>::infinity(),
+                            -std::numeric_limits<double>::infinity()};
+    }
+
+#if !defined(TRADEBOOK_KERNELS_SSE2)
+    double SumPortable(const double* values, std::size_t count) {
+        return SumScalar(values, 0, count);
+    }
+
+    double SumWhereEqualsPortable(const double* values, const std::uint8_t* keys,
+                                  std::size_t count, std::uint8_t key) {
+        return SumWhereEqualsScalar(values, keys, 0, count, key);
+    }
+#endif
+
+    MinMaxResult MinMaxPortable(const double* values, std::size_t count) {
+        return MinMaxScalar(values, 0, count, EmptyRange());
+    }
+
+#if defined(TRADEBOOK_KERNELS_SSE2)
+
+    double SumSse2(const double* values, std::size_t count) {
+        __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        __m128d a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            a0 = _mm_add_pd(a0, _mm_loadu_pd(values + i));
+            a1 = _mm_add_pd(a1, _mm_loadu_pd(values + i + 2));
+            a2 = _mm_add_pd(a2, _mm_loadu_pd(values + i + 4));
+            a3 = _mm_add_pd(a3, _mm_loadu_pd(values + i + 6));
+        }
+        __m128d acc = _mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3));
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        return lanes[0] + lanes[1] + SumScalar(values, i, count);
+    }
+
+    double SumWhereEqualsSse2(const double* values, const std::uint8_t* keys,
+                              std::size_t count, std::uint8_t key) {
+        // SSE2 has no 64-bit compare, so widen each pair of key matches into
+        // an all-ones lane mask with integer negation
+        __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i m0 = _mm_set_epi64x(-static_cast<long long>(keys[i + 1] == key),
+                                        -static_cast<long long>(keys[i] == key));
+            __m128i m1 = _mm_set_epi64x(-static_cast<long long>(keys[i + 3] == key),
+                                        -static_cast<long long>(keys[i + 2] == key));
+            a0 = _mm_add_pd(a0, _mm_and_pd(_mm_castsi128_pd(m0), _mm_loadu_pd(values + i)));
+            a1 = _mm_add_pd(a1, _mm_and_pd(_mm_castsi128_pd(m1), _mm_loadu_pd(values + i + 2)));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(a0, a1));
+        return lanes[0] + lanes[1] + SumWhereEqualsScalar(values, keys, i, count, key);
+    }
+
+    MinMaxResult MinMaxSse2(const double* values, std::size_t count) {
+        if (count < 2) {
+            return MinMaxPortable(values, count);
+        }
+        __m128d lo = _mm_loadu_pd(values), hi = lo;
+        std::size_t i = 2;
+        for (; i + 2 <= count; i += 2) {
+            __m128d v = _mm_loadu_pd(values + i);
+            lo = _mm_min_pd(lo, v);
+            hi = _mm_max_pd(hi, v);
+        }
+        double mins[2], maxs[2];
+        _mm_storeu_pd(mins, lo);
+        _mm_storeu_pd(maxs, hi);
+        MinMaxResult result{mins[0] < mins[1] ? mins[0] : mins[1],
+                            maxs[0] > maxs[1] ? maxs[0] : maxs[1]};
+        return MinMaxScalar(values, i, count, result);
+    }
+
+#endif
+
+#if defined(TRADEBOOK_KERNELS_X86)
+
+    __attribute__((target("avx2")))
+    double SumAvx2(const double* values, std::size_t count) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            a0 = _mm256_add_pd(a0, _mm256_loadu_pd(values + i));
+            a1 = _mm256_add_pd(a1, _mm256_loadu_pd(values + i + 4));
+            a2 = _mm256_add_pd(a2, _mm256_loadu_pd(values + i + 8));
+            a3 = _mm256_add_pd(a3, _mm256_loadu_pd(values + i + 12));
+        }
+        __m256d acc = _mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3));
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + SumScalar(values, i, count);
+    }
+
+    __attribute__((target("avx2")))
+    double SumWhereEqualsAvx2(const double* values, const std::uint8_t* keys,
+                              std::size_t count, std::uint8_t key) {
+        // Widen four key bytes to 64-bit lanes, compare, and mask the values
+        const __m256i wanted = _mm256_set1_epi64x(key);
+        __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            std::uint32_t k0, k1;
+            std::memcpy(&k0, keys + i, sizeof(k0));
+            std::memcpy(&k1, keys + i + 4, sizeof(k1));
+            __m256i m0 = _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(k0))), wanted);
+            __m256i m1 = _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(k1))), wanted);
+            a0 = _mm256_add_pd(a0, _mm256_and_pd(_mm256_castsi256_pd(m0), _mm256_loadu_pd(values + i)));
+            a1 = _mm256_add_pd(a1, _mm256_and_pd(_mm256_castsi256_pd(m1), _mm256_loadu_pd(values + i + 4)));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(a0, a1));
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + SumWhereEqualsScalar(values, keys, i, count, key);
+    }
+
+    __attribute__((target("avx2")))
+    MinMaxResult MinMaxAvx2(const double* values, std::size_t count) {
+        if (count < 8) {
+            return MinMaxPortable(values, count);
+        }
+        __m256d lo0 = _mm256_loadu_pd(values), hi0 = lo0;
+        __m256d lo1 = _mm256_loadu_pd(values + 4), hi1 = lo1;
+        std::size_t i = 8;
+        for (; i + 8 <= count; i += 8) {
+            __m256d v0 = _mm256_loadu_pd(values + i);
+            __m256d v1 = _mm256_loadu_pd(values + i + 4);
+            lo0 = _mm256_min_pd(lo0, v0);
+            hi0 = _mm256_max_pd(hi0, v0);
+            lo1 = _mm256_min_pd(lo1, v1);
+            hi1 = _mm256_max_pd(hi1, v1);
+        }
+        double mins[4], maxs[4];
+        _mm256_storeu_pd(mins, _mm256_min_pd(lo0, lo1));
+        _mm256_storeu_pd(maxs, _mm256_max_pd(hi0, hi1));
+        MinMaxResult result{mins[0], maxs[0]};
+        for (int lane = 1; lane < 4; ++lane) {
+            result.Min = mins[lane] < result.Min ? mins[lane] : result.Min;
+            result.Max = maxs[lane] > result.Max ? maxs[lane] : result.Max;
+        }
+        return MinMaxScalar(values, i, count, result);
+    }
+
+#endif
+
+    struct KernelTable {
+        double (*Sum)(const double*, std::size_t);
+        double (*SumWhereEquals)(const double*, const std::uint8_t*, std::size_t, std::uint8_t);
+        MinMaxResult (*MinMax)(const double*, std::size_t);
+        const char* Name;
+    };
+
+    KernelTable SelectKernels() {
+#if defined(TRADEBOOK_KERNELS_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return KernelTable{SumAvx2, SumWhereEqualsAvx2, MinMaxAvx2, "avx2"};
+        }
+#endif
+#if defined(TRADEBOOK_KERNELS_SSE2)
+        return KernelTable{SumSse2, SumWhereEqualsSse2, MinMaxSse2, "sse2"};
+#else
+        return KernelTable{SumPortable, SumWhereEqualsPortable, MinMaxPortable, "scalar"};
+#endif
+    }
+
+    const KernelTable& Active() {
+        static const KernelTable table = SelectKernels();
+        return table;
+    }
+
+} // namespace
+
+    double Sum(const double* values, std::size_t count) {
+        return Active().Sum(values, count);
+    }
+
+    double SumWhereEquals(const double* values, const std::uint8_t* keys,
+                          std::size_t count, std::uint8_t key) {
+        return Active().SumWhereEquals(values, keys, count, key);
+    }
+
+    MinMaxResult MinMax(const double* values, std::size_t count) {
+        return Active().MinMax(values, count);
+    }
+
+    void CountByKey(const std::uint8_t* keys, std::size_t count, std::uint64_t* counts) {
+        // Scalar, not SIMD: a scatter into 256 buckets has no AVX2 or SSE2
+        // form that beats this. Histograms are bound by store-to-load
+        // forwarding on repeated keys, not arithmetic, so spread
+        // consecutive rows over four sub-tables and fold them at the end
+        std::uint64_t partial[4][KeyBuckets] = {};
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            ++partial[0][keys[i]];
+            ++partial[1][keys[i + 1]];
+            ++partial[2][keys[i + 2]];
+            ++partial[3][keys[i + 3]];
+        }
+        for (; i < count; ++i) {
+            ++partial[0][keys[i]];
+        }
+        for (std::size_t k = 0; k < KeyBuckets; ++k) {
+            counts[k] += partial[0][k] + partial[1][k] + partial[2][k] + partial[3][k];
+        }
+    }
+
+    void SumByKey(const double* values, const std::uint8_t* keys,
+                  std::size_t count, double* sums) {
+        // Scalar for the same reason as CountByKey
+        double partial[4][KeyBuckets] = {};
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            partial[0][keys[i]] += values[i];
+            partial[1][keys[i + 1]] += values[i + 1];
+            partial[2][keys[i + 2]] += values[i + 2];
+            partial[3][keys[i + 3]] += values[i + 3];
+        }
+        for (; i < count; ++i) {
+            partial[0][keys[i]] += values[i];
+        }
+        for (std::size_t k = 0; k < KeyBuckets; ++k) {
+            sums[k] += (partial[0][k] + partial[1][k]) + (partial[2][k] + partial[3][k]);
+        }
+    }
+
+    const char* ActiveInstructionSet() {
+        return Active().Name;
+    }
+
+} // namespace Kernels
+} // namespace Analytics
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,186 @@
+#include "../include/TradeBookEngine/Core/Analytics/ColumnarTradeStore.hpp"
+#include "../include/TradeBookEngine/Core/Calendars/HolidayCalendar.hpp"
+
+using namespace TradeBookEngine::Core::Analytics;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+
+namespace {
+
+    using TradeBookEngine::Core::Calendars::HolidayCalendar;
+
+    std::uint8_t CurrencyKey(const Trade& trade) {
+        int index = trade.GetCurrencyCode().IsoIndex();
+        return index < 0 ? NonIsoCurrencyKey : static_cast<std::uint8_t>(index);
+    }
+
+} // namespace
+
+void ColumnarTradeStore::UpsertLocked(const Trade& trade) {
+    auto inserted = m_rowOf.emplace(trade.GetTradeId(), m_owner.size());
+    if (!inserted.second) {
+        std::size_t row = inserted.first->second;
+        m_notional[row] = trade.GetNotional();
+        m_side[row] = static_cast<std::uint8_t>(trade.GetSide());
+        m_assetClass[row] = static_cast<std::uint8_t>(trade.GetAssetClass());
+        m_status[row] = static_cast<std::uint8_t>(trade.GetStatus());
+        m_currency[row] = CurrencyKey(trade);
+        m_tradeDay[row] = HolidayCalendar::ToDay(trade.GetTradeDate());
+        m_settlementDay[row] = HolidayCalendar::ToDay(trade.GetSettlementDate());
+        return;
+    }
+    m_notional.push_back(trade.GetNotional());
+    m_side.push_back(static_cast<std::uint8_t>(trade.GetSide()));
+    m_assetClass.push_back(static_cast<std::uint8_t>(trade.GetAssetClass()));
+    m_status.push_back(static_cast<std::uint8_t>(trade.GetStatus()));
+    m_currency.push_back(CurrencyKey(trade));
+    m_tradeDay.push_back(HolidayCalendar::ToDay(trade.GetTradeDate()));
+    m_settlementDay.push_back(HolidayCalendar::ToDay(trade.GetSettlementDate()));
+    m_owner.push_back(trade.GetTradeId());
+}
+
+void ColumnarTradeStore::RemoveLocked(const std::string& tradeId) {
+    auto it = m_rowOf.find(tradeId);
+    if (it == m_rowOf.end()) {
+        return;
+    }
+    std::size_t row = it->second;
+    std::size_t last = m_owner.size() - 1;
+    m_rowOf.erase(it);
+    if (row != last) {
+        m_notional[row] = m_notional[last];
+        m_side[row] = m_side[last];
+        m_assetClass[row] = m_assetClass[last];
+        m_status[row] = m_status[last];
+        m_currency[row] = m_currency[last];
+        m_tradeDay[row] = m_tradeDay[last];
+        m_settlementDay[row] = m_settlementDay[last];
+        m_owner[row] = std::move(m_owner[last]);
+        m_rowOf[m_owner[row]] = row;
+    }
+    m_notional.pop_back();
+    m_side.pop_back();
+    m_assetClass.pop_back();
+    m_status.pop_back();
+    m_currency.pop_back();
+    m_tradeDay.pop_back();
+    m_settlementDay.pop_back();
+    m_owner.pop_back();
+}
+
+ColumnView ColumnarTradeStore::ViewLocked() const {
+    return ColumnView{m_owner.size(), m_notional.data(), m_side.data(), m_assetClass.data(),
+                      m_status.data(), m_currency.data(), m_tradeDay.data(), m_settlementDay.data()};
+}
+
+void ColumnarTradeStore::Rebuild(const std::vector<std::shared_ptr<Trade>>& trades) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_notional.clear();
+    m_side.clear();
+    m_assetClass.clear();
+    m_status.clear();
+    m_currency.clear();
+    m_tradeDay.clear();
+    m_settlementDay.clear();
+    m_owner.clear();
+    m_rowOf.clear();
+    m_rowOf.reserve(trades.size());
+    for (const auto& trade : trades) {
+        UpsertLocked(*trade);
+    }
+}
+
+// A replaced trade has the same id, so its row is overwritten in place
+void ColumnarTradeStore::OnTradeSaved(const std::shared_ptr<Trade>& trade, const std::shared_ptr<Trade>&) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    UpsertLocked(*trade);
+}
+
+void ColumnarTradeStore::OnTradeDeleted(const std::shared_ptr<Trade>& trade) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    RemoveLocked(trade->GetTradeId());
+}
+
+void ColumnarTradeStore::OnTradeStatusChanged(const std::shared_ptr<Trade>& trade, TradeStatus) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_rowOf.find(trade->GetTradeId());
+    if (it != m_rowOf.end()) {
+        m_status[it->second] = static_cast<std::uint8_t>(trade->GetStatus());
+    }
+}
+
+std::size_t ColumnarTradeStore::Size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_owner.size();
+}
+
+double ColumnarTradeStore::TotalNotional() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return Kernels::Sum(m_notional.data(), m_notional.size());
+}
+
+SideExposure ColumnarTradeStore::NotionalBySide() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return SideExposure{
+        Kernels::SumWhereEquals(m_notional.data(), m_side.data(), m_notional.size(),
+                                static_cast<std::uint8_t>(TradeSide::Buy)),
+        Kernels::SumWhereEquals(m_notional.data(), m_side.data(), m_notional.size(),
+                                static_cast<std::uint8_t>(TradeSide::Sell))};
+}
+
+std::array<double, AssetClassCount> ColumnarTradeStore::NotionalByAssetClass() const {
+    double sums[Kernels::KeyBuckets] = {};
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Kernels::SumByKey(m_notional.data(), m_assetClass.data(), m_notional.size(), sums);
+    }
+    std::array<double, AssetClassCount> result{};
+    for (std::size_t i = 0; i < AssetClassCount; ++i) {
+        result[i] = sums[i];
+    }
+    return result;
+}
+
+std::array<double, TradeStatusCount> ColumnarTradeStore::NotionalByStatus() const {
+    double sums[Kernels::KeyBuckets] = {};
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Kernels::SumByKey(m_notional.data(), m_status.data(), m_notional.size(), sums);
+    }
+    std::array<double, TradeStatusCount> result{};
+    for (std::size_t i = 0; i < TradeStatusCount; ++i) {
+        result[i] = sums[i];
+    }
+    return result;
+}
+
+std::array<double, IsoCurrencyCount> ColumnarTradeStore::NotionalByCurrency() const {
+    double sums[Kernels::KeyBuckets] = {};
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Kernels::SumByKey(m_notional.data(), m_currency.data(), m_notional.size(), sums);
+    }
+    std::array<double, IsoCurrencyCount> result{};
+    for (std::size_t i = 0; i < IsoCurrencyCount; ++i) {
+        result[i] = sums[i];
+    }
+    return result;
+}
+
+std::array<std::uint64_t, TradeStatusCount> ColumnarTradeStore::CountByStatus() const {
+    std::uint64_t counts[Kernels::KeyBuckets] = {};
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Kernels::CountByKey(m_status.data(), m_status.size(), counts);
+    }
+    std::array<std::uint64_t, TradeStatusCount> result{};
+    for (std::size_t i = 0; i < TradeStatusCount; ++i) {
+        result[i] = counts[i];
+    }
+    return result;
+}
+
+Kernels::MinMaxResult ColumnarTradeStore::NotionalRange() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return Kernels::MinMax(m_notional.data(), m_notional.size());
+}
@@ -0,0 +1,212 @@
+#include "../include/TradeBookEngine/Core/Risk/CounterpartyLimits.hpp"
+#include <cmath>
+#include <stdexcept>
+
+using namespace TradeBookEngine::Core::Risk;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Symbols;
+
+namespace {
+
+    // Limit value of a slot with no limit of its own, and of the default
+    // when there is none
+    constexpr std::int64_t NoLimit = -1;
+
+    // Keeps sums of many large notionals well clear of overflow
+    constexpr double MaxUnits = 4.0e18;
+
+    std::int64_t ToUnits(double notional) {
+        double units = std::round(notional * 100.0);
+        if (!(units < MaxUnits)) {
+            return static_cast<std::int64_t>(MaxUnits);
+        }
+        return units > 0.0 ? static_cast<std::int64_t>(units) : 0;
+    }
+
+    double FromUnits(std::int64_t units) {
+        return static_cast<double>(units) / 100.0;
+    }
+
+    std::int64_t LimitUnits(double limit) {
+        if (!std::isfinite(limit) || limit < 0.0) {
+            throw std::invalid_argument("Counterparty limit must be a non-negative finite notional");
+        }
+        return ToUnits(limit);
+    }
+
+} // namespace
+
+CounterpartyLimits::CounterpartyLimits()
+    : m_chunks(new std::atomic<Slot*>[MaxChunks]), m_defaultLimit(NoLimit) {
+    for (std::size_t i = 0; i < MaxChunks; ++i) {
+        m_chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+CounterpartyLimits::~CounterpartyLimits() {
+    for (std::size_t i = 0; i < MaxChunks; ++i) {
+        delete[] m_chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+bool CounterpartyLimits::HoldsExposure(TradeStatus status) {
+    return status == TradeStatus::Pending || status == TradeStatus::Booked;
+}
+
+CounterpartyLimits::Slot* CounterpartyLimits::Find(SymbolId counterparty) const {
+    Slot* chunk = m_chunks[counterparty >> ChunkBits].load(std::memory_order_acquire);
+    return chunk ? &chunk[counterparty & ChunkMask] : nullptr;
+}
+
+CounterpartyLimits::Slot& CounterpartyLimits::Get(SymbolId counterparty) {
+    auto& entry = m_chunks[counterparty >> ChunkBits];
+    Slot* chunk = entry.load(std::memory_order_acquire);
+    if (!chunk) {
+        // Racing threads may both allocate; the loser frees its copy
+        auto* fresh = new Slot[ChunkSize];
+        for (std::size_t i = 0; i < ChunkSize; ++i) {
+            fresh[i].Limit.store(NoLimit, std::memory_order_relaxed);
+            fresh[i].Exposure.store(0, std::memory_order_relaxed);
+        }
+        if (entry.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            chunk = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    return chunk[counterparty & ChunkMask];
+}
+
+void CounterpartyLimits::SetDefaultLimit(double limit) {
+    m_defaultLimit.store(limit < 0.0 ? NoLimit : LimitUnits(limit), std::memory_order_relaxed);
+}
+
+void CounterpartyLimits::SetLimitLocked(SymbolId counterparty, std::int64_t limit) {
+    Get(counterparty).Limit.store(limit, std::memory_order_relaxed);
+    if (limit == NoLimit) {
+        m_limited.erase(counterparty);
+    } else {
+        m_limited.insert(counterparty);
+    }
+}
+
+void CounterpartyLimits::SetLimit(std::string_view counterparty, double limit) {
+    auto units = LimitUnits(limit);
+    std::lock_guard<std::mutex> lock(m_limitMutex);
+    SetLimitLocked(Intern(counterparty), units);
+}
+
+void CounterpartyLimits::ClearLimit(std::string_view counterparty) {
+    SymbolId id = EmptySymbol;
+    if (!SymbolTable::Instance().Find(counterparty, id)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_limitMutex);
+    SetLimitLocked(id, NoLimit);
+}
+
+void CounterpartyLimits::ReloadLimits(const std::unordered_map<std::string, double>& limits) {
+    // Check everything first so a bad entry leaves the old limits in force
+    std::unordered_map<SymbolId, std::int64_t> next;
+    next.reserve(limits.size());
+    for (const auto& limit : limits) {
+        next.emplace(Intern(limit.first), LimitUnits(limit.second));
+    }
+
+    std::lock_guard<std::mutex> lock(m_limitMutex);
+    for (const auto& limit : next) {
+        Get(limit.first).Limit.store(limit.second, std::memory_order_relaxed);
+    }
+    for (SymbolId counterparty : m_limited) {
+        if (next.find(counterparty) == next.end()) {
+            Get(counterparty).Limit.store(NoLimit, std::memory_order_relaxed);
+        }
+    }
+    m_limited.clear();
+    for (const auto& limit : next) {
+        m_limited.insert(limit.first);
+    }
+}
+
+bool CounterpartyLimits::Reserve(SymbolId counterparty, double notional) {
+    auto& slot = Get(counterparty);
+    auto units = ToUnits(notional);
+    auto limit = slot.Limit.load(std::memory_order_relaxed);
+    if (limit == NoLimit) {
+        limit = m_defaultLimit.load(std::memory_order_relaxed);
+    }
+    if (limit == NoLimit) {
+        // Still counted, so a limit set later sees the open exposure
+        slot.Exposure.fetch_add(units, std::memory_order_relaxed);
+    } else {
+        auto exposure = slot.Exposure.load(std::memory_order_relaxed);
+        do {
+            if (units > limit - exposure) {
+                return false;
+            }
+        } while (!slot.Exposure.compare_exchange_weak(exposure, exposure + units, std::memory_order_relaxed));
+    }
+    return true;
+}
+
+void CounterpartyLimits::Release(SymbolId counterparty, double notional) {
+    Get(counterparty).Exposure.fetch_sub(ToUnits(notional), std::memory_order_relaxed);
+}
+
+CounterpartyUsage CounterpartyLimits::GetUsage(std::string_view counterparty) const {
+    std::int64_t limit = NoLimit, exposure = 0;
+    SymbolId id = EmptySymbol;
+    const Slot* slot = SymbolTable::Instance().Find(counterparty, id) ? Find(id) : nullptr;
+    if (slot) {
+        limit = slot->Limit.load(std::memory_order_relaxed);
+        exposure = slot->Exposure.load(std::memory_order_relaxed);
+    }
+    if (limit == NoLimit) {
+        limit = m_defaultLimit.load(std::memory_order_relaxed);
+    }
+    return CounterpartyUsage{limit != NoLimit, limit == NoLimit ? 0.0 : FromUnits(limit), FromUnits(exposure)};
+}
+
+void CounterpartyLimits::AddExposure(const Trade& trade, std::int64_t sign) {
+    Get(trade.GetCounterpartySymbol()).Exposure.fetch_add(sign * ToUnits(trade.GetNotional()),
+                                                          std::memory_order_relaxed);
+}
+
+void CounterpartyLimits::Rebuild(const std::vector<std::shared_ptr<Trade>>& trades) {
+    for (std::size_t c = 0; c < MaxChunks; ++c) {
+        Slot* chunk = m_chunks[c].load(std::memory_order_acquire);
+        if (!chunk) {
+            continue;
+        }
+        for (std::size_t i = 0; i < ChunkSize; ++i) {
+            chunk[i].Exposure.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (const auto& trade : trades) {
+        if (trade && HoldsExposure(trade->GetStatus())) {
+            AddExposure(*trade, 1);
+        }
+    }
+}
+
+void CounterpartyLimits::OnTradeSaved(const std::shared_ptr<Trade>& trade, const std::shared_ptr<Trade>& replaced) {
+    if (replaced && replaced != trade && HoldsExposure(replaced->GetStatus())) {
+        AddExposure(*replaced, -1);
+    }
+}
+
+void CounterpartyLimits::OnTradeDeleted(const std::shared_ptr<Trade>& trade) {
+    if (HoldsExposure(trade->GetStatus())) {
+        AddExposure(*trade, -1);
+    }
+}
+
+void CounterpartyLimits::OnTradeStatusChanged(const std::shared_ptr<Trade>& trade, TradeStatus previousStatus) {
+    bool held = HoldsExposure(previousStatus);
+    bool holds = HoldsExposure(trade->GetStatus());
+    // A trade coming back into force is not checked against the limit
+    if (held != holds) {
+        AddExposure(*trade, holds ? 1 : -1);
+    }
+}
@@ -0,0 +1,94 @@
+#include "../include/TradeBookEngine/Core/CurrencyCode.hpp"
+
+using namespace TradeBookEngine::Core::Models;
+
+namespace {
+
+    // Sorted, so table positions are the alphabetical IsoIndex
+    constexpr const char IsoCodes[] =
+        "AED" "AFN" "ALL" "AMD" "ANG" "AOA" "ARS" "AUD" "AWG" "AZN" "BAM" "BBD" "BDT" "BGN" "BHD" "BIF"
+        "BMD" "BND" "BOB" "BOV" "BRL" "BSD" "BTN" "BWP" "BYN" "BZD" "CAD" "CDF" "CHE" "CHF" "CHW" "CLF"
+        "CLP" "CNY" "COP" "COU" "CRC" "CUC" "CUP" "CVE" "CZK" "DJF" "DKK" "DOP" "DZD" "EGP" "ERN" "ETB"
+        "EUR" "FJD" "FKP" "GBP" "GEL" "GHS" "GIP" "GMD" "GNF" "GTQ" "GYD" "HKD" "HNL" "HTG" "HUF" "IDR"
+        "ILS" "INR" "IQD" "IRR" "ISK" "JMD" "JOD" "JPY" "KES" "KGS" "KHR" "KMF" "KPW" "KRW" "KWD" "KYD"
+        "KZT" "LAK" "LBP" "LKR" "LRD" "LSL" "LYD" "MAD" "MDL" "MGA" "MKD" "MMK" "MNT" "MOP" "MRU" "MUR"
+        "MVR" "MWK" "MXN" "MXV" "MYR" "MZN" "NAD" "NGN" "NIO" "NOK" "NPR" "NZD" "OMR" "PAB" "PEN" "PGK"
+        "PHP" "PKR" "PLN" "PYG" "QAR" "RON" "RSD" "RUB" "RWF" "SAR" "SBD" "SCR" "SDG" "SEK" "SGD" "SHP"
+        "SLE" "SLL" "SOS" "SRD" "SSP" "STN" "SVC" "SYP" "SZL" "THB" "TJS" "TMT" "TND" "TOP" "TRY" "TTD"
+        "TWD" "TZS" "UAH" "UGX" "USD" "USN" "UYI" "UYU" "UYW" "UZS" "VED" "VES" "VND" "VUV" "WST" "XAF"
+        "XAG" "XAU" "XBA" "XBB" "XBC" "XBD" "XCD" "XCG" "XDR" "XOF" "XPD" "XPF" "XPT" "XSU" "XTS" "XUA"
+        "XXX" "YER" "ZAR" "ZMW" "ZWG" "ZWL";
+
+    static_assert(sizeof(IsoCodes) - 1 == IsoCurrencyCount * 3, "IsoCurrencyCount must match the code list");
+
+    constexpr unsigned PopCount(std::uint64_t bits) {
+        bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+        bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+        bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<unsigned>((bits * 0x0101010101010101ULL) >> 56);
+    }
+
+    constexpr std::size_t Words = (std::size_t{1} << 15) / 64;
+
+    // Membership bitset over every packed value, plus the number of set
+    // bits before each word so IsoIndex is a popcount away
+    struct IsoTable {
+        std::uint64_t Bits[Words];
+        std::uint16_t RankBefore[Words];
+        std::uint16_t Codes[IsoCurrencyCount];
+    };
+
+    constexpr IsoTable BuildIsoTable() {
+        IsoTable table{};
+        for (std::size_t i = 0; i < IsoCurrencyCount; ++i) {
+            auto packed = CurrencyCode(std::string_view(IsoCodes + i * 3, 3)).Packed();
+            table.Codes[i] = packed;
+            table.Bits[packed / 64] |= std::uint64_t{1} << (packed % 64);
+        }
+        std::uint16_t rank = 0;
+        for (std::size_t word = 0; word < Words; ++word) {
+            table.RankBefore[word] = rank;
+            rank = static_cast<std::uint16_t>(rank + PopCount(table.Bits[word]));
+        }
+        return table;
+    }
+
+    constexpr IsoTable Iso = BuildIsoTable();
+
+    static_assert(CurrencyCode("USD").Packed() == ((21u << 10) | (19u << 5) | 4u), "A = 1, first letter highest");
+
+} // namespace
+
+bool CurrencyCode::IsIso4217() const noexcept {
+    return (Iso.Bits[m_packed / 64] >> (m_packed % 64)) & 1u;
+}
+
+int CurrencyCode::IsoIndex() const noexcept {
+    std::uint64_t word = Iso.Bits[m_packed / 64];
+    std::uint64_t bit = std::uint64_t{1} << (m_packed % 64);
+    if ((word & bit) == 0) {
+        return -1;
+    }
+    return Iso.RankBefore[m_packed / 64] + static_cast<int>(PopCount(word & (bit - 1)));
+}
+
+CurrencyCode CurrencyCode::FromIsoIndex(std::size_t index) noexcept {
+    return index < IsoCurrencyCount ? FromPacked(Iso.Codes[index]) : CurrencyCode();
+}
+
+void CurrencyCode::CopyTo(char (&text)[4]) const noexcept {
+    if (m_packed == 0) {
+        text[0] = '\0';
+        return;
+    }
+    text[0] = static_cast<char>('A' - 1 + ((m_packed >> 10) & 31u));
+    text[1] = static_cast<char>('A' - 1 + ((m_packed >> 5) & 31u));
+    text[2] = static_cast<char>('A' - 1 + (m_packed & 31u));
+    text[3] = '\0';
+}
+
+std::string CurrencyCode::ToString() const {
+    char text[4];
+    CopyTo(text);
+    return std::string(text);
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Storage {
+
+    // Thin wrappers over the platform file APIs used by the on-disk formats,
+    // so the repositories stay platform-neutral
+
+    inline std::string ErrnoMessage(const std::string& what) {
+        return what + ": " + std::strerror(errno);
+    }
+
+#if defined(_WIN32)
+    inline int OpenFile(const std::string& path, bool truncate = false) {
+        int flags = _O_RDWR | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+        return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+    }
+
+    inline bool WriteFully(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            unsigned chunk = size > 0x40000000u ? 0x40000000u : static_cast<unsigned>(size);
+            int written = _write(fd, data, chunk);
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    inline bool SyncData(int fd) { return _commit(fd) == 0; }
+
+    inline bool TruncateAt(int fd, std::uint64_t size) {
+        return _chsize_s(fd, static_cast<long long>(size)) == 0 &&
+               _lseeki64(fd, static_cast<long long>(size), SEEK_SET) >= 0;
+    }
+
+    inline void CloseFile(int fd) { _close(fd); }
+
+    // Directory entries are durable once the file handle is flushed on Windows
+    inline bool SyncDirectoryOf(const std::string&) { return true; }
+#else
+    inline int OpenFile(const std::string& path, bool truncate = false) {
+        return ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    }
+
+    inline bool WriteFully(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    inline bool SyncData(int fd) {
+#if defined(__APPLE__)
+        return ::fsync(fd) == 0;
+#else
+        return ::fdatasync(fd) == 0;
+#endif
+    }
+
+    inline bool TruncateAt(int fd, std::uint64_t size) {
+        return ::ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+               ::lseek(fd, static_cast<off_t>(size), SEEK_SET) >= 0;
+    }
+
+    inline void CloseFile(int fd) { ::close(fd); }
+
+    // Makes a rename or create inside path's directory durable
+    inline bool SyncDirectoryOf(const std::string& path) {
+        std::size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+    }
+#endif
+
+    // Read-only memory mapping of a whole file
+    class MappedFile {
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() { Close(); }
+
+        // Returns false and sets error if the file cannot be mapped
+        bool Open(const std::string& path, std::string& error) {
+            Close();
+#if defined(_WIN32)
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+            LARGE_INTEGER size;
+            if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size)) {
+                error = "Cannot open " + path;
+                Close();
+                return false;
+            }
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            if (m_size == 0) {
+                return true;
+            }
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view) {
+                error = "Cannot map " + path;
+                Close();
+                return false;
+            }
+            m_data = static_cast<const char*>(view);
+#else
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat info;
+            if (fd < 0 || ::fstat(fd, &info) != 0) {
+                error = ErrnoMessage("Cannot open " + path);
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                return false;
+            }
+            m_size = static_cast<std::size_t>(info.st_size);
+            if (m_size > 0) {
+                void* view = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+                if (view == MAP_FAILED) {
+                    error = ErrnoMessage("Cannot map " + path);
+                    ::close(fd);
+                    m_size = 0;
+                    return false;
+                }
+                m_data = static_cast<const char*>(view);
+            }
+            // The mapping keeps the file referenced
+            ::close(fd);
+#endif
+            return true;
+        }
+
+        void Close() {
+#if defined(_WIN32)
+            if (m_data) {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping) {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_file);
+            }
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data) {
+                ::munmap(const_cast<char*>(m_data), m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        const char* Data() const { return m_data; }
+        std::size_t Size() const { return m_size; }
+    };
+
+} // namespace Storage
+} // namespace Core
+} // namespace TradeBookEngine
@@ -0,0 +1,367 @@
+#include "../include/TradeBookEngine/Core/Calendars/HolidayCalendar.hpp"
+#include "../include/TradeBookEngine/Core/Utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+using namespace TradeBookEngine::Core::Calendars;
+using TradeBookEngine::Core::Utils::DateTimeUtils;
+
+namespace {
+
+    constexpr std::int64_t SecondsPerDay = 86400;
+
+    // 0 = Sunday; 1970-01-01 was a Thursday
+    unsigned Weekday(Day day) {
+        return static_cast<unsigned>(((static_cast<std::int64_t>(day) % 7) + 11) % 7);
+    }
+
+    unsigned MonthOf(Day day) {
+        std::int64_t year;
+        unsigned month, dayOfMonth;
+        DateTimeUtils::CivilFromDays(day, year, month, dayOfMonth);
+        return month;
+    }
+
+    std::string Trim(const std::string& text) {
+        auto begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) {
+            return std::string();
+        }
+        auto end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    std::string Lower(std::string text) {
+        for (auto& c : text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    // YYYY-MM-DD at the start of text
+    bool ParseDate(const std::string& text, Day& day) {
+        if (text.size() < 10 || text[4] != '-' || text[7] != '-' ||
+            (text.size() > 10 && text[10] != ' ' && text[10] != '\t')) {
+            return false;
+        }
+        int fields[3] = {0, 0, 0};
+        const std::size_t starts[3] = {0, 5, 8};
+        const std::size_t lengths[3] = {4, 2, 2};
+        for (int f = 0; f < 3; ++f) {
+            for (std::size_t i = 0; i < lengths[f]; ++i) {
+                char c = text[starts[f] + i];
+                if (c < '0' || c > '9') {
+                    return false;
+                }
+                fields[f] = fields[f] * 10 + (c - '0');
+            }
+        }
+        auto month = static_cast<unsigned>(fields[1]);
+        auto dayOfMonth = static_cast<unsigned>(fields[2]);
+        if (month < 1 || month > 12 || dayOfMonth < 1 || dayOfMonth > DateTimeUtils::DaysInMonth(fields[0], month)) {
+            return false;
+        }
+        day = static_cast<Day>(DateTimeUtils::DaysFromCivil(fields[0], month, dayOfMonth));
+        return true;
+    }
+
+    bool ParseWeekday(const std::string& name, unsigned& weekday) {
+        static const char* const names[] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+        auto lower = Lower(name);
+        for (unsigned i = 0; i < 7; ++i) {
+            if (lower.compare(0, 3, names[i]) == 0 && lower.size() >= 3) {
+                weekday = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace
+
+HolidayCalendar::HolidayCalendar(std::string code, const std::vector<Day>& holidays,
+                                 WeekendMask weekend, Day firstDay, Day lastDay)
+    : m_code(std::move(code)), m_firstDay(firstDay), m_lastDay(lastDay), m_weekend(weekend) {
+    if (lastDay < firstDay) {
+        throw std::invalid_argument("Calendar " + m_code + " has an empty day range");
+    }
+    auto span = static_cast<std::size_t>(static_cast<std::int64_t>(lastDay) - firstDay + 1);
+
+    std::vector<bool> closed(span, false);
+    for (Day holiday : holidays) {
+        if (holiday >= firstDay && holiday <= lastDay) {
+            closed[static_cast<std::size_t>(holiday - firstDay)] = true;
+        }
+    }
+
+    m_before.resize(span + 1);
+    m_businessDays.reserve(span * 5 / 7 + 1);
+    std::int32_t count = 0;
+    for (std::size_t i = 0; i < span; ++i) {
+        m_before[i] = count;
+        Day day = firstDay + static_cast<Day>(i);
+        if (!closed[i] && (m_weekend & (1u << Weekday(day))) == 0) {
+            m_businessDays.push_back(day);
+            ++count;
+        }
+    }
+    m_before[span] = count;
+}
+
+const HolidayCalendar& HolidayCalendar::WeekendsOnly() {
+    static const HolidayCalendar calendar("WEEKENDS", std::vector<Day>());
+    return calendar;
+}
+
+std::size_t HolidayCalendar::IndexOf(Day day) const {
+    if (day < m_firstDay || day > m_lastDay) {
+        throw std::out_of_range("Date outside calendar " + m_code + " range");
+    }
+    return static_cast<std::size_t>(day - m_firstDay);
+}
+
+Day HolidayCalendar::BusinessDayAt(std::int64_t ordinal) const {
+    if (ordinal < 0 || ordinal >= static_cast<std::int64_t>(m_businessDays.size())) {
+        throw std::out_of_range("Business day outside calendar " + m_code + " range");
+    }
+    return m_businessDays[static_cast<std::size_t>(ordinal)];
+}
+
+bool HolidayCalendar::IsBusinessDay(Day day) const {
+    auto index = IndexOf(day);
+    return m_before[index + 1] != m_before[index];
+}
+
+Day HolidayCalendar::AddBusinessDays(Day day, int businessDays) const {
+    auto index = IndexOf(day);
+    if (businessDays > 0) {
+        // Ordinal of the first business day after day, plus n - 1
+        return BusinessDayAt(static_cast<std::int64_t>(m_before[index + 1]) + businessDays - 1);
+    }
+    if (businessDays < 0) {
+        return BusinessDayAt(static_cast<std::int64_t>(m_before[index]) + businessDays);
+    }
+    return day;
+}
+
+bool HolidayCalendar::CanAddBusinessDays(Day day, int businessDays) const {
+    if (day < m_firstDay || day > m_lastDay) {
+        return false;
+    }
+    auto index = static_cast<std::size_t>(day - m_firstDay);
+    std::int64_t ordinal = businessDays > 0 ? static_cast<std::int64_t>(m_before[index + 1]) + businessDays - 1
+                                            : static_cast<std::int64_t>(m_before[index]) + businessDays;
+    return businessDays == 0 || (ordinal >= 0 && ordinal < static_cast<std::int64_t>(m_businessDays.size()));
+}
+
+int HolidayCalendar::BusinessDaysBetween(Day from, Day to) const {
+    auto before = [this](Day day) {
+        // One past the last day is a valid end of a half-open range
+        if (day == m_lastDay + 1) {
+            return m_before.back();
+        }
+        return m_before[IndexOf(day)];
+    };
+    return before(to) - before(from);
+}
+
+Day HolidayCalendar::Roll(Day day, RollConvention convention) const {
+    auto index = IndexOf(day);
+    if (m_before[index + 1] != m_before[index]) {
+        return day;
+    }
+    // Not a business day, so m_before[index] is the ordinal of the next one
+    auto following = static_cast<std::int64_t>(m_before[index]);
+    switch (convention) {
+        case RollConvention::Following:
+            return BusinessDayAt(following);
+        case RollConvention::Preceding:
+            return BusinessDayAt(following - 1);
+        case RollConvention::ModifiedFollowing: {
+            if (following < static_cast<std::int64_t>(m_businessDays.size())) {
+                Day next = m_businessDays[static_cast<std::size_t>(following)];
+                if (MonthOf(next) == MonthOf(day)) {
+                    return next;
+                }
+            }
+            return BusinessDayAt(following - 1);
+        }
+    }
+    return day;
+}
+
+Day HolidayCalendar::ToDay(std::chrono::system_clock::time_point time) {
+    auto seconds = std::chrono::floor<std::chrono::seconds>(time.time_since_epoch()).count();
+    auto days = seconds / SecondsPerDay;
+    if (seconds % SecondsPerDay < 0) {
+        --days;
+    }
+    return static_cast<Day>(days);
+}
+
+std::chrono::system_clock::time_point HolidayCalendar::FromDay(Day day) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(day * SecondsPerDay)));
+}
+
+bool HolidayCalendar::IsBusinessDay(std::chrono::system_clock::time_point time) const {
+    return IsBusinessDay(ToDay(time));
+}
+
+std::chrono::system_clock::time_point HolidayCalendar::AddBusinessDays(
+    std::chrono::system_clock::time_point time, int businessDays) const {
+    Day day = ToDay(time);
+    return FromDay(AddBusinessDays(day, businessDays)) + (time - FromDay(day));
+}
+
+int HolidayCalendar::BusinessDaysBetween(std::chrono::system_clock::time_point from,
+                                         std::chrono::system_clock::time_point to) const {
+    return BusinessDaysBetween(ToDay(from), ToDay(to));
+}
+
+std::chrono::system_clock::time_point HolidayCalendar::Roll(
+    std::chrono::system_clock::time_point time, RollConvention convention) const {
+    Day day = ToDay(time);
+    return FromDay(Roll(day, convention)) + (time - FromDay(day));
+}
+
+std::shared_ptr<const HolidayCalendar> HolidayCalendar::Parse(std::istream& input, const std::string& codeIfMissing,
+                                                              const std::string& sourceName) {
+    std::string code = codeIfMissing;
+    WeekendMask weekend = SaturdaySunday;
+    std::vector<Day> holidays;
+
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& reason) {
+        return CalendarError(sourceName + ":" + std::to_string(lineNumber) + ": " + reason);
+    };
+
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        auto comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = Trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        auto colon = line.find(':');
+        if (colon != std::string::npos) {
+            auto key = Lower(Trim(line.substr(0, colon)));
+            auto value = Trim(line.substr(colon + 1));
+            if (key == "code") {
+                if (value.empty()) {
+                    throw fail("empty calendar code");
+                }
+                code = value;
+            } else if (key == "weekend") {
+                weekend = 0;
+                std::istringstream names(value);
+                std::string name;
+                while (names >> name) {
+                    unsigned weekday;
+                    if (Lower(name) == "none") {
+                        continue;
+                    }
+                    if (!ParseWeekday(name, weekday)) {
+                        throw fail("unknown weekday '" + name + "'");
+                    }
+                    weekend = static_cast<WeekendMask>(weekend | (1u << weekday));
+                }
+            } else {
+                throw fail("unknown setting '" + key + "'");
+            }
+            continue;
+        }
+
+        Day holiday;
+        if (!ParseDate(line, holiday)) {
+            throw fail("expected YYYY-MM-DD, got '" + line + "'");
+        }
+        holidays.push_back(holiday);
+    }
+
+    if (code.empty()) {
+        throw CalendarError(sourceName + ": calendar has no code");
+    }
+    return std::make_shared<const HolidayCalendar>(code, holidays, weekend);
+}
+
+std::shared_ptr<const HolidayCalendar> HolidayCalendar::LoadFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw CalendarError("Cannot open calendar file " + path);
+    }
+    return Parse(file, std::filesystem::path(path).stem().string(), path);
+}
+
+// CalendarRegistry implementation
+void CalendarRegistry::Add(std::shared_ptr<const HolidayCalendar> calendar) {
+    if (!calendar) {
+        throw std::invalid_argument("Calendar cannot be null");
+    }
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_calendars[calendar->Code()] = std::move(calendar);
+}
+
+std::shared_ptr<const HolidayCalendar> CalendarRegistry::LoadFile(const std::string& path) {
+    auto calendar = HolidayCalendar::LoadFile(path);
+    Add(calendar);
+    return calendar;
+}
+
+std::size_t CalendarRegistry::LoadDirectory(const std::string& directory) {
+    std::error_code error;
+    std::filesystem::directory_iterator entries(directory, error);
+    if (error) {
+        throw CalendarError("Cannot read calendar directory " + directory + ": " + error.message());
+    }
+
+    std::vector<std::string> paths;
+    for (const auto& entry : entries) {
+        if (entry.is_regular_file() && entry.path().extension() == ".cal") {
+            paths.push_back(entry.path().string());
+        }
+    }
+    // Directory order is unspecified; sort so duplicate codes resolve the
+    // same way on every run
+    std::sort(paths.begin(), paths.end());
+
+    // Parse everything before publishing, so a bad file leaves the
+    // registry unchanged
+    std::vector<std::shared_ptr<const HolidayCalendar>> calendars;
+    calendars.reserve(paths.size());
+    for (const auto& path : paths) {
+        calendars.push_back(HolidayCalendar::LoadFile(path));
+    }
+    for (auto& calendar : calendars) {
+        Add(std::move(calendar));
+    }
+    return calendars.size();
+}
+
+std::shared_ptr<const HolidayCalendar> CalendarRegistry::Find(const std::string& code) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_calendars.find(code);
+    return it == m_calendars.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> CalendarRegistry::Codes() const {
+    std::vector<std::string> codes;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        codes.reserve(m_calendars.size());
+        for (const auto& entry : m_calendars) {
+            codes.push_back(entry.first);
+        }
+    }
+    std::sort(codes.begin(), codes.end());
+    return codes;
+}
@@ -1,31 +1,126 @@
 #include "../include/TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include "../include/TradeBookEngine/Core/Metrics/BookingMetrics.hpp"
+#include "TradeTable.hpp"
+#include "TableScan.hpp"
+#include "RepositoryListeners.hpp"
 #include <unordered_map>
 #include <algorithm>
 #include <mutex>
+#include <condition_variable>
 
 using namespace TradeBookEngine::Core::Interfaces;
 using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Storage;
+using namespace TradeBookEngine::Core::Symbols;
+using TradeBookEngine::Core::Metrics::LockTimed;
 
 class InMemoryTradeRepository : public ITradeRepository {
 private:
-    std::unordered_map<std::string, std::shared_ptr<Trade>> m_tradesById;
-    std::unordered_map<std::string, std::shared_ptr<Trade>> m_tradesByIdempotencyKey;
+    TradeTable m_trades;
+    // A null value marks a key reserved by a booking still in flight
+    PooledHashMap<std::string, std::shared_ptr<Trade>> m_tradesByIdempotencyKey;
     mutable std::mutex m_mutex;
+    std::condition_variable m_reservationResolved;
+    RepositoryListeners m_listeners;
+
+    // Returns true if this fulfilled an outstanding reservation
+    bool SaveLocked(const std::shared_ptr<Trade>& trade) {
+        auto replaced = m_trades.Upsert(trade);
+        m_listeners.Saved(trade, replaced);
+        
+        if (trade->GetIdempotencyKey().empty()) {
+            return false;
+        }
+        auto& slot = m_tradesByIdempotencyKey[trade->GetIdempotencyKey()];
+        bool wasReserved = !slot;
+        slot = trade;
+        return wasReserved;
+    }
+
+    StatusTransition TransitionLocked(const std::string& tradeId, TradeStatus status, StatusTransitionRule rule) {
+        StatusTransition result;
+        auto trade = m_trades.Transition(tradeId, status, rule, result);
+        if (result.Outcome == TransitionOutcome::Applied) {
+            m_listeners.StatusChanged(trade, result.Previous);
+        }
+        return result;
+    }
 
 public:
     void Save(std::shared_ptr<Trade> trade) override {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_tradesById[trade->GetTradeId()] = trade;
+        bool fulfilled;
+        {
+            auto lock = LockTimed(m_mutex);
+            fulfilled = SaveLocked(trade);
+        }
+        if (fulfilled) {
+            m_reservationResolved.notify_all();
+        }
+    }
+
+    void SaveBatch(const std::vector<std::shared_ptr<Trade>>& trades) override {
+        bool fulfilled = false;
+        {
+            auto lock = LockTimed(m_mutex);
+            for (const auto& trade : trades) {
+                fulfilled |= SaveLocked(trade);
+            }
+        }
+        if (fulfilled) {
+            m_reservationResolved.notify_all();
+        }
+    }
+
+    IdempotencyReservation ReserveIdempotencyKey(const std::string& idempotencyKey) override {
+        auto lock = LockTimed(m_mutex);
+        for (;;) {
+            auto inserted = m_tradesByIdempotencyKey.try_emplace(idempotencyKey);
+            if (inserted.second) {
+                return IdempotencyReservation{ReservationStatus::Reserved, nullptr};
+            }
+            if (inserted.first->second) {
+                return IdempotencyReservation{ReservationStatus::Existing, inserted.first->second};
+            }
+            // Another booking holds the key; wait for it to save or give up
+            m_reservationResolved.wait(lock);
+        }
+    }
+
+    std::vector<IdempotencyReservation> TryReserveIdempotencyKeys(const std::vector<std::string>& idempotencyKeys) override {
+        std::vector<IdempotencyReservation> result;
+        result.reserve(idempotencyKeys.size());
         
-        if (!trade->GetIdempotencyKey().empty()) {
-            m_tradesByIdempotencyKey[trade->GetIdempotencyKey()] = trade;
+        auto lock = LockTimed(m_mutex);
+        for (const auto& key : idempotencyKeys) {
+            auto inserted = m_tradesByIdempotencyKey.try_emplace(key);
+            if (inserted.second) {
+                result.push_back(IdempotencyReservation{ReservationStatus::Reserved, nullptr});
+            } else if (inserted.first->second) {
+                result.push_back(IdempotencyReservation{ReservationStatus::Existing, inserted.first->second});
+            } else {
+                result.push_back(IdempotencyReservation{ReservationStatus::Pending, nullptr});
+            }
         }
+        
+        return result;
+    }
+
+    void ReleaseIdempotencyKey(const std::string& idempotencyKey) override {
+        {
+            auto lock = LockTimed(m_mutex);
+            auto it = m_tradesByIdempotencyKey.find(idempotencyKey);
+            if (it == m_tradesByIdempotencyKey.end() || it->second) {
+                return;
+            }
+            m_tradesByIdempotencyKey.erase(it);
+        }
+        m_reservationResolved.notify_all();
     }
 
     std::shared_ptr<Trade> GetById(const std::string& tradeId) override {
         std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_tradesById.find(tradeId);
-        return it != m_tradesById.end() ? it->second : nullptr;
+        return m_trades.Find(tradeId);
     }
 
     std::shared_ptr<Trade> GetByIdempotencyKey(const std::string& idempotencyKey) override {
@@ -34,45 +129,137 @@ public:
         return it != m_tradesByIdempotencyKey.end() ? it->second : nullptr;
     }
 
-    std::vector<std::shared_ptr<Trade>> GetByCounterparty(const std::string& counterparty) override {
-        std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::shared_ptr<Trade>> GetByIdempotencyKeys(const std::vector<std::string>& idempotencyKeys) override {
         std::vector<std::shared_ptr<Trade>> result;
+        result.reserve(idempotencyKeys.size());
         
-        for (const auto& pair : m_tradesById) {
-            if (pair.second->GetCounterparty() == counterparty) {
-                result.push_back(pair.second);
-            }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& key : idempotencyKeys) {
+            auto it = m_tradesByIdempotencyKey.find(key);
+            result.push_back(it != m_tradesByIdempotencyKey.end() ? it->second : nullptr);
         }
         
         return result;
     }
 
-    std::vector<std::shared_ptr<Trade>> GetAll() override {
+    std::vector<std::shared_ptr<Trade>> GetByCounterparty(const std::string& counterparty) override {
+        std::vector<std::shared_ptr<Trade>> result;
+        SymbolId symbol;
+        if (!SymbolTable::Instance().Find(counterparty, symbol)) {
+            return result; // Never seen, so no trade can match
+        }
         std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectByCounterparty(symbol, result);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByInstrument(const std::string& instrumentId) override {
         std::vector<std::shared_ptr<Trade>> result;
-        
-        for (const auto& pair : m_tradesById) {
-            result.push_back(pair.second);
+        SymbolId symbol;
+        if (!SymbolTable::Instance().Find(instrumentId, symbol)) {
+            return result;
         }
-        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectByInstrument(symbol, result);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByAssetClass(AssetClass assetClass) override {
+        std::vector<std::shared_ptr<Trade>> result;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectByAssetClass(assetClass, result);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByStatus(TradeStatus status) override {
+        std::vector<std::shared_ptr<Trade>> result;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectByStatus(status, result);
         return result;
     }
 
+    std::vector<std::shared_ptr<Trade>> GetAll() override {
+        std::vector<std::shared_ptr<Trade>> result;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectAll(result);
+        return result;
+    }
+
+    void ForEach(const TradePredicate& predicate, const TradeVisitor& visitor) override {
+        ForEachInShards(1, [this](std::size_t, std::size_t& slot, auto& visit) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_trades.Scan(slot, ScanChunkSlots, visit);
+        }, predicate, visitor);
+    }
+
+    std::string ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                         const TradePredicate& predicate, const TradeVisitor& visitor) override {
+        return ReadPageInShards(1, [this](std::size_t, std::size_t& slot, auto& visit) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_trades.Scan(slot, ScanChunkSlots, visit);
+        }, continuationToken, pageSize, predicate, visitor);
+    }
+
     bool Exists(const std::string& tradeId) override {
         std::lock_guard<std::mutex> lock(m_mutex);
-        return m_tradesById.find(tradeId) != m_tradesById.end();
+        return m_trades.Contains(tradeId);
+    }
+
+    bool UpdateStatus(const std::string& tradeId, TradeStatus status) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TradeStatus previousStatus;
+        auto trade = m_trades.UpdateStatus(tradeId, status, previousStatus);
+        if (!trade) {
+            return false;
+        }
+        m_listeners.StatusChanged(trade, previousStatus);
+        return true;
+    }
+
+    StatusTransition TransitionStatus(const std::string& tradeId, TradeStatus status,
+                                      StatusTransitionRule rule) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return TransitionLocked(tradeId, status, rule);
+    }
+
+    std::vector<StatusTransition> TransitionStatuses(const std::vector<std::string>& tradeIds, TradeStatus status,
+                                                     StatusTransitionRule rule) override {
+        std::vector<StatusTransition> result;
+        result.reserve(tradeIds.size());
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& tradeId : tradeIds) {
+            result.push_back(TransitionLocked(tradeId, status, rule));
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetBySettlementDate(std::chrono::system_clock::time_point date) override {
+        std::vector<std::shared_ptr<Trade>> result;
+        auto day = TradeBookEngine::Core::Calendars::HolidayCalendar::ToDay(date);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_trades.CollectBySettlementDay(day, result);
+        return result;
+    }
+
+    void AddListener(std::shared_ptr<ITradeRepositoryListener> listener) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_listeners.Add(std::move(listener));
     }
 
     void Delete(const std::string& tradeId) override {
         std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_tradesById.find(tradeId);
-        if (it != m_tradesById.end()) {
+        auto removed = m_trades.Erase(tradeId);
+        if (removed) {
+            m_listeners.Deleted(removed);
+
             // Also remove from idempotency key map if exists
-            const auto& idempotencyKey = it->second->GetIdempotencyKey();
+            const auto& idempotencyKey = removed->GetIdempotencyKey();
             if (!idempotencyKey.empty()) {
-                m_tradesByIdempotencyKey.erase(idempotencyKey);
+                auto it = m_tradesByIdempotencyKey.find(idempotencyKey);
+                if (it != m_tradesByIdempotencyKey.end() && it->second == removed) {
+                    m_tradesByIdempotencyKey.erase(it);
+                }
             }
-            m_tradesById.erase(it);
         }
     }
 };
@@ -86,4 +273,4 @@ extern "C" {
     void DestroyInMemoryTradeRepository(ITradeRepository* repository) {
         delete repository;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,507 @@
+#include "../include/TradeBookEngine/Core/Repositories/JournalTradeRepository.hpp"
+#include "TradeCodec.hpp"
+#include "FileIo.hpp"
+#include <algorithm>
+
+using namespace TradeBookEngine::Core::Repositories;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Storage;
+
+extern "C" {
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+    void DestroyShardedTradeRepository(ITradeRepository* repository);
+}
+
+namespace {
+
+    constexpr char JournalMagic[4] = {'T', 'B', 'J', 'L'};
+    constexpr std::uint32_t JournalVersion = 1;
+    constexpr std::size_t JournalHeaderSize = 8;
+    // Length and checksum ahead of every record
+    constexpr std::size_t RecordHeaderSize = 8;
+
+    enum class RecordType : std::uint8_t {
+        Save = 1,
+        Delete = 2,
+        Status = 3
+    };
+
+    // Appends one framed record; write fills in the payload after the type byte
+    template <typename Write>
+    void AppendRecord(std::string& out, RecordType type, Write&& write) {
+        std::size_t start = out.size();
+        BinaryWriter writer(out);
+        writer.PutU32(0);
+        writer.PutU32(0);
+        writer.PutU8(static_cast<std::uint8_t>(type));
+        write(writer);
+        std::size_t payloadSize = out.size() - start - RecordHeaderSize;
+        writer.PatchU32(start, static_cast<std::uint32_t>(payloadSize));
+        writer.PatchU32(start + 4, Crc32c(out.data() + start + RecordHeaderSize, payloadSize));
+    }
+
+    void AppendSave(std::string& out, const Trade& trade) {
+        AppendRecord(out, RecordType::Save, [&trade](BinaryWriter& writer) {
+            EncodeTrade(trade, writer);
+        });
+    }
+
+    void AppendStatus(std::string& out, const std::string& tradeId, TradeStatus status) {
+        AppendRecord(out, RecordType::Status, [&tradeId, status](BinaryWriter& writer) {
+            writer.PutString(tradeId);
+            writer.PutU8(static_cast<std::uint8_t>(status));
+        });
+    }
+
+} // namespace
+
+JournalTradeRepository::JournalTradeRepository(JournalOptions options)
+    : m_options(std::move(options))
+    , m_memory(CreateShardedTradeRepository(m_options.ShardCount), DestroyShardedTradeRepository)
+    , m_fd(-1)
+    , m_opSequence(0)
+    , m_appendedBytes(0)
+    , m_durableBytes(0)
+    , m_stopping(false)
+    , m_recoveredRecords(0)
+    , m_truncatedBytes(0) {
+    Recover();
+    m_writer = std::thread([this]() { WriterLoop(); });
+}
+
+JournalTradeRepository::~JournalTradeRepository() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    if (m_fd >= 0) {
+        CloseFile(m_fd);
+    }
+}
+
+bool JournalTradeRepository::Replay(const char* payload, std::size_t payloadSize) {
+    BinaryReader reader(payload, payloadSize);
+    auto type = static_cast<RecordType>(reader.GetU8());
+    if (type == RecordType::Save) {
+        auto trade = DecodeTrade(reader);
+        if (trade) {
+            m_memory->Save(trade);
+            return true;
+        }
+    } else if (type == RecordType::Delete) {
+        std::string tradeId(reader.GetString());
+        if (reader.Ok()) {
+            m_memory->Delete(tradeId);
+            return true;
+        }
+    } else if (type == RecordType::Status) {
+        std::string tradeId(reader.GetString());
+        auto status = static_cast<TradeStatus>(reader.GetU8());
+        if (reader.Ok()) {
+            m_memory->UpdateStatus(tradeId, status);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JournalTradeRepository::Recover() {
+    m_fd = OpenFile(m_options.Path);
+    if (m_fd < 0) {
+        throw JournalError(ErrnoMessage("Cannot open journal " + m_options.Path));
+    }
+    auto refuse = [this](const std::string& message) {
+        CloseFile(m_fd);
+        m_fd = -1;
+        throw JournalError(message);
+    };
+
+    // Replay from a read-only mapping so start-up memory does not grow with
+    // the log; pages are read in as replay reaches them
+    MappedFile log;
+    std::string error;
+    if (!log.Open(m_options.Path, error)) {
+        refuse(error);
+    }
+    const char* data = log.Data();
+    std::size_t size = log.Size();
+
+    std::uint64_t goodSize = 0;
+    if (size >= JournalHeaderSize) {
+        BinaryReader header(data, JournalHeaderSize);
+        bool magicOk = std::memcmp(data, JournalMagic, sizeof(JournalMagic)) == 0;
+        header.GetU32();
+        if (!magicOk || header.GetU32() != JournalVersion) {
+            refuse("Not a version " + std::to_string(JournalVersion) + " trade journal: " + m_options.Path);
+        }
+        goodSize = JournalHeaderSize;
+
+        std::size_t offset = JournalHeaderSize;
+        while (offset < size) {
+            std::size_t remaining = size - offset;
+            std::uint32_t payloadSize = 0;
+            std::uint32_t checksum = 0;
+            if (remaining >= RecordHeaderSize) {
+                BinaryReader frame(data + offset, RecordHeaderSize);
+                payloadSize = frame.GetU32();
+                checksum = frame.GetU32();
+            }
+            bool complete = remaining >= RecordHeaderSize && payloadSize <= remaining - RecordHeaderSize;
+            const char* payload = data + offset + RecordHeaderSize;
+            if (complete && payloadSize > 0 && Crc32c(payload, payloadSize) == checksum &&
+                Replay(payload, payloadSize)) {
+                offset += RecordHeaderSize + payloadSize;
+                goodSize = offset;
+                ++m_recoveredRecords;
+                continue;
+            }
+            // A crash can only tear the record being appended: it runs to the
+            // end of the file, or the file system left zeros in its place.
+            // A bad record with acknowledged commits after it is damage, and
+            // dropping them would lose data, so refuse to open instead.
+            bool lastRecord = !complete || RecordHeaderSize + payloadSize == remaining;
+            bool zeroTail = std::all_of(data + offset, data + size, [](char byte) { return byte == 0; });
+            if (!lastRecord && !zeroTail) {
+                refuse("Corrupt record at offset " + std::to_string(offset) + " of journal " + m_options.Path +
+                       "; later records would be lost, so it was not opened");
+            }
+            break;
+        }
+    }
+
+    // Drop a torn tail, or start a fresh log when even the header is incomplete
+    m_truncatedBytes = size - goodSize;
+    log.Close();
+    if (!TruncateAt(m_fd, goodSize)) {
+        throw JournalError(ErrnoMessage("Cannot truncate journal " + m_options.Path));
+    }
+    if (goodSize == 0) {
+        std::string header(JournalMagic, sizeof(JournalMagic));
+        BinaryWriter(header).PutU32(JournalVersion);
+        if (!WriteFully(m_fd, header.data(), header.size()) || !SyncData(m_fd)) {
+            throw JournalError(ErrnoMessage("Cannot initialise journal " + m_options.Path));
+        }
+    } else if (m_truncatedBytes > 0 && !SyncData(m_fd)) {
+        throw JournalError(ErrnoMessage("Cannot sync journal " + m_options.Path));
+    }
+}
+
+void JournalTradeRepository::WriterLoop() {
+    std::string batch;
+    std::vector<PendingOp> ops;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work.wait(lock, [this]() { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            return; // Stopping with nothing left to commit
+        }
+        if (m_options.CommitDelay.count() > 0 && !m_stopping && m_pending.size() < m_options.MaxBatchBytes) {
+            m_work.wait_for(lock, m_options.CommitDelay, [this]() {
+                return m_stopping || m_pending.size() >= m_options.MaxBatchBytes;
+            });
+        }
+
+        batch.swap(m_pending);
+        ops.swap(m_pendingOps);
+        std::uint64_t target = m_appendedBytes;
+        lock.unlock();
+
+        bool written = WriteFully(m_fd, batch.data(), batch.size()) && (!m_options.SyncOnCommit || SyncData(m_fd));
+        std::string failure = written ? std::string() : ErrnoMessage("Journal commit failed");
+        batch.clear();
+
+        lock.lock();
+        if (written) {
+            ApplyLocked(ops);
+            m_durableBytes = target;
+            m_commits.fetch_add(1, std::memory_order_relaxed);
+            m_records.fetch_add(ops.size(), std::memory_order_relaxed);
+        } else {
+            // Nothing in flight will be written now, so none of it is applied
+            m_failure = failure;
+            m_pending.clear();
+            m_pendingOps.clear();
+            m_pendingState.clear();
+        }
+        ops.clear();
+        m_durable.notify_all();
+        if (!written) {
+            return;
+        }
+    }
+}
+
+// Caller holds m_mutex; ops are durable and in log order
+void JournalTradeRepository::ApplyLocked(std::vector<PendingOp>& ops) {
+    std::vector<std::shared_ptr<Trade>> saves;
+    auto flushSaves = [this, &saves]() {
+        if (saves.size() == 1) {
+            m_memory->Save(saves.front());
+        } else if (!saves.empty()) {
+            m_memory->SaveBatch(saves);
+        }
+        saves.clear();
+    };
+    for (auto& op : ops) {
+        if (op.Type == OpType::Save) {
+            saves.push_back(std::move(op.Trade));
+        } else {
+            flushSaves();
+            if (op.Type == OpType::Delete) {
+                m_memory->Delete(op.TradeId);
+            } else {
+                m_memory->UpdateStatus(op.TradeId, op.Status);
+            }
+        }
+        auto state = m_pendingState.find(op.TradeId);
+        if (state != m_pendingState.end() && state->second.Sequence == op.Sequence) {
+            m_pendingState.erase(state);
+        }
+    }
+    flushSaves();
+}
+
+void JournalTradeRepository::Queue(PendingOp op, bool exists) {
+    op.Sequence = ++m_opSequence;
+    m_pendingState[op.TradeId] = PendingState{exists, op.Status, op.Sequence};
+    m_pendingOps.push_back(std::move(op));
+}
+
+void JournalTradeRepository::LogSave(const std::shared_ptr<Trade>& trade) {
+    AppendSave(m_pending, *trade);
+    Queue(PendingOp{OpType::Save, trade, trade->GetTradeId(), trade->GetStatus(), 0}, true);
+}
+
+void JournalTradeRepository::LogDelete(const std::string& tradeId) {
+    AppendRecord(m_pending, RecordType::Delete, [&tradeId](BinaryWriter& writer) {
+        writer.PutString(tradeId);
+    });
+    Queue(PendingOp{OpType::Delete, nullptr, tradeId, TradeStatus::Pending, 0}, false);
+}
+
+void JournalTradeRepository::LogStatus(const std::string& tradeId, TradeStatus status) {
+    AppendStatus(m_pending, tradeId, status);
+    Queue(PendingOp{OpType::Status, nullptr, tradeId, status, 0}, true);
+}
+
+bool JournalTradeRepository::CurrentStatus(const std::string& tradeId, TradeStatus& status) const {
+    auto state = m_pendingState.find(tradeId);
+    if (state != m_pendingState.end()) {
+        status = state->second.Status;
+        return state->second.Exists;
+    }
+    auto trade = m_memory->GetById(tradeId);
+    if (!trade) {
+        return false;
+    }
+    status = trade->GetStatus();
+    return true;
+}
+
+template <typename Append>
+void JournalTradeRepository::Commit(Append&& append) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_failure.empty()) {
+        throw JournalError(m_failure);
+    }
+    std::size_t before = m_pending.size();
+    // Appends records to m_pending and queues their mutations, which the
+    // writer applies in log order once they are durable
+    append();
+    if (m_pending.size() == before) {
+        return;
+    }
+    m_appendedBytes += m_pending.size() - before;
+    std::uint64_t target = m_appendedBytes;
+    m_work.notify_one();
+    m_durable.wait(lock, [this, target]() { return m_durableBytes >= target || !m_failure.empty(); });
+    if (m_durableBytes < target) {
+        throw JournalError(m_failure);
+    }
+}
+
+void JournalTradeRepository::Save(std::shared_ptr<Trade> trade) {
+    Commit([this, &trade]() {
+        LogSave(trade);
+    });
+}
+
+void JournalTradeRepository::SaveBatch(const std::vector<std::shared_ptr<Trade>>& trades) {
+    if (trades.empty()) {
+        return;
+    }
+    Commit([this, &trades]() {
+        for (const auto& trade : trades) {
+            LogSave(trade);
+        }
+    });
+}
+
+void JournalTradeRepository::Delete(const std::string& tradeId) {
+    Commit([this, &tradeId]() {
+        TradeStatus current;
+        if (CurrentStatus(tradeId, current)) {
+            LogDelete(tradeId);
+        }
+    });
+}
+
+bool JournalTradeRepository::UpdateStatus(const std::string& tradeId, TradeStatus status) {
+    bool found = false;
+    Commit([this, &tradeId, status, &found]() {
+        TradeStatus current;
+        found = CurrentStatus(tradeId, current);
+        if (found && current != status) {
+            LogStatus(tradeId, status);
+        }
+    });
+    return found;
+}
+
+StatusTransition JournalTradeRepository::TransitionStatus(const std::string& tradeId, TradeStatus status,
+                                                          StatusTransitionRule rule) {
+    StatusTransition result;
+    Commit([this, &tradeId, status, rule, &result]() {
+        // Writers are serialised here, so the check and the record agree
+        result = DecideLocked(tradeId, status, rule);
+        if (result.Outcome == TransitionOutcome::Applied) {
+            LogStatus(tradeId, status);
+        }
+    });
+    return result;
+}
+
+std::vector<StatusTransition> JournalTradeRepository::TransitionStatuses(const std::vector<std::string>& tradeIds,
+                                                                         TradeStatus status,
+                                                                         StatusTransitionRule rule) {
+    std::vector<StatusTransition> result;
+    if (tradeIds.empty()) {
+        return result;
+    }
+    result.reserve(tradeIds.size());
+    Commit([this, &tradeIds, status, rule, &result]() {
+        for (const auto& tradeId : tradeIds) {
+            result.push_back(DecideLocked(tradeId, status, rule));
+            if (result.back().Outcome == TransitionOutcome::Applied) {
+                LogStatus(tradeId, status);
+            }
+        }
+    });
+    return result;
+}
+
+StatusTransition JournalTradeRepository::DecideLocked(const std::string& tradeId, TradeStatus status,
+                                                      StatusTransitionRule rule) const {
+    StatusTransition result;
+    if (!CurrentStatus(tradeId, result.Previous)) {
+        return result;
+    }
+    if (result.Previous == status) {
+        result.Outcome = TransitionOutcome::Unchanged;
+    } else if (rule && !rule(result.Previous, status)) {
+        result.Outcome = TransitionOutcome::Refused;
+    } else {
+        result.Outcome = TransitionOutcome::Applied;
+    }
+    return result;
+}
+
+std::shared_ptr<Trade> JournalTradeRepository::GetById(const std::string& tradeId) {
+    return m_memory->GetById(tradeId);
+}
+
+std::shared_ptr<Trade> JournalTradeRepository::GetByIdempotencyKey(const std::string& idempotencyKey) {
+    return m_memory->GetByIdempotencyKey(idempotencyKey);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetByCounterparty(const std::string& counterparty) {
+    return m_memory->GetByCounterparty(counterparty);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetAll() {
+    return m_memory->GetAll();
+}
+
+bool JournalTradeRepository::Exists(const std::string& tradeId) {
+    return m_memory->Exists(tradeId);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetByInstrument(const std::string& instrumentId) {
+    return m_memory->GetByInstrument(instrumentId);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetByAssetClass(AssetClass assetClass) {
+    return m_memory->GetByAssetClass(assetClass);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetByStatus(TradeStatus status) {
+    return m_memory->GetByStatus(status);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetBySettlementDate(
+    std::chrono::system_clock::time_point date) {
+    return m_memory->GetBySettlementDate(date);
+}
+
+std::vector<std::shared_ptr<Trade>> JournalTradeRepository::GetByIdempotencyKeys(
+    const std::vector<std::string>& idempotencyKeys) {
+    return m_memory->GetByIdempotencyKeys(idempotencyKeys);
+}
+
+IdempotencyReservation JournalTradeRepository::ReserveIdempotencyKey(const std::string& idempotencyKey) {
+    return m_memory->ReserveIdempotencyKey(idempotencyKey);
+}
+
+void JournalTradeRepository::ReleaseIdempotencyKey(const std::string& idempotencyKey) {
+    m_memory->ReleaseIdempotencyKey(idempotencyKey);
+}
+
+std::vector<IdempotencyReservation> JournalTradeRepository::TryReserveIdempotencyKeys(
+    const std::vector<std::string>& idempotencyKeys) {
+    return m_memory->TryReserveIdempotencyKeys(idempotencyKeys);
+}
+
+void JournalTradeRepository::AddListener(std::shared_ptr<ITradeRepositoryListener> listener) {
+    m_memory->AddListener(std::move(listener));
+}
+
+void JournalTradeRepository::ForEach(const TradePredicate& predicate, const TradeVisitor& visitor) {
+    m_memory->ForEach(predicate, visitor);
+}
+
+std::string JournalTradeRepository::ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                                             const TradePredicate& predicate, const TradeVisitor& visitor) {
+    return m_memory->ReadPage(continuationToken, pageSize, predicate, visitor);
+}
+
+JournalStats JournalTradeRepository::GetStats() const {
+    JournalStats stats;
+    stats.Commits = m_commits.load(std::memory_order_relaxed);
+    stats.Records = m_records.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.Bytes = m_durableBytes;
+    }
+    stats.RecoveredRecords = m_recoveredRecords;
+    stats.TruncatedBytes = m_truncatedBytes;
+    return stats;
+}
+
+// Factory function; throws JournalError if the journal cannot be opened
+extern "C" {
+    ITradeRepository* CreateJournalTradeRepository(const char* path) {
+        JournalOptions options;
+        options.Path = path;
+        return new JournalTradeRepository(std::move(options));
+    }
+
+    void DestroyJournalTradeRepository(ITradeRepository* repository) {
+        delete repository;
+    }
+}
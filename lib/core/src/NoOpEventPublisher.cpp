@@ -7,9 +7,19 @@ using namespace TradeBookEngine::Core::Events;
 class NoOpEventPublisher : public IEventPublisher {
 public:
     void Publish(const TradeBookedEvent& event) override {
-        // No-op implementation - just log to console
+        // No-op implementation - just log to console. No flush per event:
+        // std::endl here made booking latency depend on the terminal.
         std::cout << "Event published: Trade " << event.GetTrade()->GetTradeId() 
-                  << " booked at " << event.GetEventId() << std::endl;
+                  << " booked at " << event.GetEventId() << '\n';
+    }
+
+    void PublishBatch(const std::vector<TradeBookedEvent>& events) override {
+        // One flush for the whole batch
+        for (const auto& event : events) {
+            std::cout << "Event published: Trade " << event.GetTrade()->GetTradeId() 
+                      << " booked at " << event.GetEventId() << '\n';
+        }
+        std::cout.flush();
     }
 };
 
@@ -0,0 +1,171 @@
+#include "../include/TradeBookEngine/Core/Analytics/PositionKeeper.hpp"
+#include <algorithm>
+
+using namespace TradeBookEngine::Core::Analytics;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Symbols;
+
+namespace {
+
+    constexpr std::size_t TotalStripes = PositionKeeper::StripeCount * PositionDimensionCount;
+    static_assert((PositionKeeper::StripeCount & (PositionKeeper::StripeCount - 1)) == 0,
+                  "StripeCount must be a power of two");
+
+    // A save that replaces a trade removes the old one and adds the new one
+    constexpr std::size_t MaxChanges = 2 * PositionDimensionCount;
+
+} // namespace
+
+PositionKeeper::PositionKeeper()
+    : m_stripes(new Stripe[TotalStripes]) {
+}
+
+bool PositionKeeper::Counts(TradeStatus status) {
+    return status == TradeStatus::Pending || status == TradeStatus::Booked || status == TradeStatus::Settled;
+}
+
+std::size_t PositionKeeper::StripeOf(PositionDimension dimension, SymbolId key) {
+    // Symbol ids are dense, so a multiplicative hash spreads neighbours
+    auto hashed = static_cast<std::uint32_t>(key * 0x9E3779B1u) >> 26;
+    return static_cast<std::size_t>(dimension) * StripeCount + (hashed & (StripeCount - 1));
+}
+
+std::size_t PositionKeeper::AddChanges(const Trade& trade, std::int64_t sign, Change* changes) {
+    double gross = trade.GetNotional() * static_cast<double>(sign);
+    double net = trade.GetSide() == TradeSide::Buy ? gross : -gross;
+    const SymbolId keys[PositionDimensionCount] = {
+        trade.GetCounterpartySymbol(), trade.GetInstrumentSymbol(), trade.GetCurrencySymbol()
+    };
+    for (std::size_t d = 0; d < PositionDimensionCount; ++d) {
+        changes[d] = Change{StripeOf(static_cast<PositionDimension>(d), keys[d]), keys[d], net, gross, sign};
+    }
+    return PositionDimensionCount;
+}
+
+void PositionKeeper::ApplyLocked(Stripe& stripe, const Change& change) {
+    auto& position = stripe.Positions[change.Key];
+    position.Trades += change.Trades;
+    if (position.Trades == 0) {
+        // Drop it rather than keep the rounding left by add-then-subtract
+        stripe.Positions.erase(change.Key);
+        return;
+    }
+    position.NetNotional += change.Net;
+    position.GrossNotional += change.Gross;
+}
+
+void PositionKeeper::Apply(Change* changes, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // Lock every touched stripe in ascending order before changing any, so a
+    // snapshot sees the whole trade or none of it
+    std::sort(changes, changes + count,
+              [](const Change& a, const Change& b) { return a.Stripe < b.Stripe; });
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i == 0 || changes[i].Stripe != changes[i - 1].Stripe) {
+            m_stripes[changes[i].Stripe].Mutex.lock();
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        ApplyLocked(m_stripes[changes[i].Stripe], changes[i]);
+    }
+    for (std::size_t i = count; i-- > 0;) {
+        if (i == 0 || changes[i].Stripe != changes[i - 1].Stripe) {
+            m_stripes[changes[i].Stripe].Mutex.unlock();
+        }
+    }
+}
+
+void PositionKeeper::Rebuild(const std::vector<std::shared_ptr<Trade>>& trades) {
+    for (std::size_t s = 0; s < TotalStripes; ++s) {
+        m_stripes[s].Mutex.lock();
+    }
+    for (std::size_t s = 0; s < TotalStripes; ++s) {
+        m_stripes[s].Positions.clear();
+    }
+    Change changes[PositionDimensionCount];
+    for (const auto& trade : trades) {
+        if (!trade || !Counts(trade->GetStatus())) {
+            continue;
+        }
+        AddChanges(*trade, 1, changes);
+        for (const auto& change : changes) {
+            ApplyLocked(m_stripes[change.Stripe], change);
+        }
+    }
+    for (std::size_t s = TotalStripes; s-- > 0;) {
+        m_stripes[s].Mutex.unlock();
+    }
+}
+
+void PositionKeeper::OnTradeSaved(const std::shared_ptr<Trade>& trade, const std::shared_ptr<Trade>& replaced) {
+    Change changes[MaxChanges];
+    std::size_t count = 0;
+    if (replaced && Counts(replaced->GetStatus())) {
+        count += AddChanges(*replaced, -1, changes + count);
+    }
+    if (Counts(trade->GetStatus())) {
+        count += AddChanges(*trade, 1, changes + count);
+    }
+    Apply(changes, count);
+}
+
+void PositionKeeper::OnTradeDeleted(const std::shared_ptr<Trade>& trade) {
+    if (!Counts(trade->GetStatus())) {
+        return;
+    }
+    Change changes[PositionDimensionCount];
+    Apply(changes, AddChanges(*trade, -1, changes));
+}
+
+void PositionKeeper::OnTradeStatusChanged(const std::shared_ptr<Trade>& trade, TradeStatus previousStatus) {
+    bool counted = Counts(previousStatus);
+    bool counts = Counts(trade->GetStatus());
+    if (counted == counts) {
+        return;
+    }
+    Change changes[PositionDimensionCount];
+    Apply(changes, AddChanges(*trade, counts ? 1 : -1, changes));
+}
+
+Position PositionKeeper::Get(PositionDimension dimension, SymbolId key) const {
+    auto& stripe = m_stripes[StripeOf(dimension, key)];
+    std::lock_guard<std::mutex> lock(stripe.Mutex);
+    auto it = stripe.Positions.find(key);
+    return it == stripe.Positions.end() ? Position{} : it->second;
+}
+
+Position PositionKeeper::Get(PositionDimension dimension, std::string_view key) const {
+    SymbolId id = EmptySymbol;
+    // Never interns: a name no trade has used has no position
+    if (!SymbolTable::Instance().Find(key, id)) {
+        return Position{};
+    }
+    return Get(dimension, id);
+}
+
+PositionSnapshot PositionKeeper::Snapshot() const {
+    PositionSnapshot snapshot;
+    for (std::size_t s = 0; s < TotalStripes; ++s) {
+        m_stripes[s].Mutex.lock();
+    }
+    for (std::size_t d = 0; d < PositionDimensionCount; ++d) {
+        std::size_t size = 0;
+        for (std::size_t s = d * StripeCount; s < (d + 1) * StripeCount; ++s) {
+            size += m_stripes[s].Positions.size();
+        }
+        auto& entries = snapshot.Entries[d];
+        entries.reserve(size);
+        for (std::size_t s = d * StripeCount; s < (d + 1) * StripeCount; ++s) {
+            for (const auto& position : m_stripes[s].Positions) {
+                entries.push_back(PositionEntry{position.first, position.second});
+            }
+        }
+    }
+    for (std::size_t s = TotalStripes; s-- > 0;) {
+        m_stripes[s].Mutex.unlock();
+    }
+    return snapshot;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../include/TradeBookEngine/Core/Interfaces/ITradeRepositoryListener.hpp"
+#include <vector>
+#include <memory>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Storage {
+
+    // Listener fan-out shared by the repositories. Not synchronised: callers
+    // notify under the lock that guards the affected trade and add listeners
+    // while holding every such lock.
+    class RepositoryListeners {
+    private:
+        std::vector<std::shared_ptr<Interfaces::ITradeRepositoryListener>> m_listeners;
+
+    public:
+        void Add(std::shared_ptr<Interfaces::ITradeRepositoryListener> listener) {
+            m_listeners.push_back(std::move(listener));
+        }
+
+        bool Empty() const { return m_listeners.empty(); }
+
+        void Saved(const std::shared_ptr<Models::Trade>& trade, const std::shared_ptr<Models::Trade>& replaced) const {
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeSaved(trade, replaced);
+            }
+        }
+
+        void Deleted(const std::shared_ptr<Models::Trade>& trade) const {
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeDeleted(trade);
+            }
+        }
+
+        void StatusChanged(const std::shared_ptr<Models::Trade>& trade, Enums::TradeStatus previousStatus) const {
+            if (trade->GetStatus() == previousStatus) {
+                return;
+            }
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeStatusChanged(trade, previousStatus);
+            }
+        }
+    };
+
+} // namespace Storage
+} // namespace Core
+} // namespace TradeBookEngine
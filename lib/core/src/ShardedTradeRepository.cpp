@@ -0,0 +1,384 @@
+#include "../include/TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include "../include/TradeBookEngine/Core/Metrics/BookingMetrics.hpp"
+#include "TradeTable.hpp"
+#include "TableScan.hpp"
+#include "RepositoryListeners.hpp"
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Storage;
+using namespace TradeBookEngine::Core::Symbols;
+using TradeBookEngine::Core::Metrics::LockTimed;
+
+// Repository that splits trades into independently locked shards so that
+// point lookups only contend with writers touching the same shard. Trades
+// are sharded by trade-id hash; the idempotency table is sharded separately
+// by key hash so both lookups take a single shared lock. Each trade shard
+// keeps its own secondary indexes; index queries visit every shard but only
+// touch matching trades. Writers lock through Metrics::LockTimed, so time
+// spent waiting for a shard shows up in TradeService's booking metrics.
+class ShardedTradeRepository : public ITradeRepository {
+private:
+    struct alignas(64) TradeShard {
+        mutable std::shared_mutex mutex;
+        TradeTable trades;
+    };
+
+    struct alignas(64) KeyShard {
+        mutable std::shared_mutex mutex;
+        // A null value marks a key reserved by a booking still in flight
+        PooledHashMap<std::string, std::shared_ptr<Trade>> tradesByIdempotencyKey;
+        std::condition_variable_any reservationResolved;
+
+        // Returns true if this fulfilled an outstanding reservation
+        bool Bind(const std::shared_ptr<Trade>& trade) {
+            auto& slot = tradesByIdempotencyKey[trade->GetIdempotencyKey()];
+            bool wasReserved = !slot;
+            slot = trade;
+            return wasReserved;
+        }
+    };
+
+    std::unique_ptr<TradeShard[]> m_tradeShards;
+    std::unique_ptr<KeyShard[]> m_keyShards;
+    std::size_t m_shardMask;
+    // Notified under the trade shard's write lock
+    RepositoryListeners m_listeners;
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    TradeShard& TradeShardFor(const std::string& tradeId) const {
+        return m_tradeShards[std::hash<std::string>{}(tradeId) & m_shardMask];
+    }
+
+    // Caller holds shard.mutex exclusively
+    StatusTransition TransitionLocked(TradeShard& shard, const std::string& tradeId, TradeStatus status,
+                                      StatusTransitionRule rule) {
+        StatusTransition result;
+        auto trade = shard.trades.Transition(tradeId, status, rule, result);
+        if (result.Outcome == TransitionOutcome::Applied) {
+            m_listeners.StatusChanged(trade, result.Previous);
+        }
+        return result;
+    }
+
+    template <typename Collect>
+    std::vector<std::shared_ptr<Trade>> CollectFromShards(Collect collect) const {
+        std::vector<std::shared_ptr<Trade>> result;
+        for (std::size_t s = 0; s <= m_shardMask; ++s) {
+            auto& shard = m_tradeShards[s];
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            collect(shard.trades, result);
+        }
+        return result;
+    }
+
+    // One locked chunk of a streaming scan; readers share the shard lock
+    template <typename Visit>
+    TradeTable::ScanState ScanChunk(std::size_t shardIndex, std::size_t& slot, Visit& visit) const {
+        auto& shard = m_tradeShards[shardIndex];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.trades.Scan(slot, ScanChunkSlots, visit);
+    }
+
+    KeyShard& KeyShardFor(const std::string& idempotencyKey) const {
+        return m_keyShards[std::hash<std::string>{}(idempotencyKey) & m_shardMask];
+    }
+
+public:
+    explicit ShardedTradeRepository(std::size_t shardCount) {
+        std::size_t shards = RoundUpToPowerOfTwo(shardCount == 0 ? 1 : shardCount);
+        m_tradeShards.reset(new TradeShard[shards]);
+        m_keyShards.reset(new KeyShard[shards]);
+        m_shardMask = shards - 1;
+    }
+
+    void Save(std::shared_ptr<Trade> trade) override {
+        // Publish by id first so a key hit can always be resolved by id
+        {
+            auto& shard = TradeShardFor(trade->GetTradeId());
+            auto lock = LockTimed(shard.mutex);
+            auto replaced = shard.trades.Upsert(trade);
+            m_listeners.Saved(trade, replaced);
+        }
+
+        if (!trade->GetIdempotencyKey().empty()) {
+            auto& shard = KeyShardFor(trade->GetIdempotencyKey());
+            bool fulfilled;
+            {
+                auto lock = LockTimed(shard.mutex);
+                fulfilled = shard.Bind(trade);
+            }
+            if (fulfilled) {
+                shard.reservationResolved.notify_all();
+            }
+        }
+    }
+
+    void SaveBatch(const std::vector<std::shared_ptr<Trade>>& trades) override {
+        // Group by shard so each shard lock is taken once per batch
+        std::vector<std::vector<const std::shared_ptr<Trade>*>> byTradeShard(m_shardMask + 1);
+        std::vector<std::vector<const std::shared_ptr<Trade>*>> byKeyShard(m_shardMask + 1);
+        for (const auto& trade : trades) {
+            auto hash = std::hash<std::string>{}(trade->GetTradeId());
+            byTradeShard[hash & m_shardMask].push_back(&trade);
+            if (!trade->GetIdempotencyKey().empty()) {
+                auto keyHash = std::hash<std::string>{}(trade->GetIdempotencyKey());
+                byKeyShard[keyHash & m_shardMask].push_back(&trade);
+            }
+        }
+
+        for (std::size_t s = 0; s <= m_shardMask; ++s) {
+            if (byTradeShard[s].empty()) {
+                continue;
+            }
+            auto& shard = m_tradeShards[s];
+            auto lock = LockTimed(shard.mutex);
+            for (const auto* trade : byTradeShard[s]) {
+                auto replaced = shard.trades.Upsert(*trade);
+                m_listeners.Saved(*trade, replaced);
+            }
+        }
+
+        for (std::size_t s = 0; s <= m_shardMask; ++s) {
+            if (byKeyShard[s].empty()) {
+                continue;
+            }
+            auto& shard = m_keyShards[s];
+            bool fulfilled = false;
+            {
+                auto lock = LockTimed(shard.mutex);
+                for (const auto* trade : byKeyShard[s]) {
+                    fulfilled |= shard.Bind(*trade);
+                }
+            }
+            if (fulfilled) {
+                shard.reservationResolved.notify_all();
+            }
+        }
+    }
+
+    std::shared_ptr<Trade> GetById(const std::string& tradeId) override {
+        auto& shard = TradeShardFor(tradeId);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.trades.Find(tradeId);
+    }
+
+    std::shared_ptr<Trade> GetByIdempotencyKey(const std::string& idempotencyKey) override {
+        auto& shard = KeyShardFor(idempotencyKey);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.tradesByIdempotencyKey.find(idempotencyKey);
+        return it != shard.tradesByIdempotencyKey.end() ? it->second : nullptr;
+    }
+
+    IdempotencyReservation ReserveIdempotencyKey(const std::string& idempotencyKey) override {
+        auto& shard = KeyShardFor(idempotencyKey);
+        auto lock = LockTimed(shard.mutex);
+        for (;;) {
+            auto inserted = shard.tradesByIdempotencyKey.try_emplace(idempotencyKey);
+            if (inserted.second) {
+                return IdempotencyReservation{ReservationStatus::Reserved, nullptr};
+            }
+            if (inserted.first->second) {
+                return IdempotencyReservation{ReservationStatus::Existing, inserted.first->second};
+            }
+            // Another booking holds the key; wait for it to save or give up
+            shard.reservationResolved.wait(lock);
+        }
+    }
+
+    std::vector<IdempotencyReservation> TryReserveIdempotencyKeys(const std::vector<std::string>& idempotencyKeys) override {
+        std::vector<IdempotencyReservation> result;
+        result.reserve(idempotencyKeys.size());
+        
+        for (const auto& key : idempotencyKeys) {
+            auto& shard = KeyShardFor(key);
+            auto lock = LockTimed(shard.mutex);
+            auto inserted = shard.tradesByIdempotencyKey.try_emplace(key);
+            if (inserted.second) {
+                result.push_back(IdempotencyReservation{ReservationStatus::Reserved, nullptr});
+            } else if (inserted.first->second) {
+                result.push_back(IdempotencyReservation{ReservationStatus::Existing, inserted.first->second});
+            } else {
+                result.push_back(IdempotencyReservation{ReservationStatus::Pending, nullptr});
+            }
+        }
+        
+        return result;
+    }
+
+    void ReleaseIdempotencyKey(const std::string& idempotencyKey) override {
+        auto& shard = KeyShardFor(idempotencyKey);
+        {
+            auto lock = LockTimed(shard.mutex);
+            auto it = shard.tradesByIdempotencyKey.find(idempotencyKey);
+            if (it == shard.tradesByIdempotencyKey.end() || it->second) {
+                return;
+            }
+            shard.tradesByIdempotencyKey.erase(it);
+        }
+        shard.reservationResolved.notify_all();
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByCounterparty(const std::string& counterparty) override {
+        SymbolId symbol;
+        if (!SymbolTable::Instance().Find(counterparty, symbol)) {
+            return {}; // Never seen, so no trade can match
+        }
+        return CollectFromShards([symbol](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectByCounterparty(symbol, out);
+        });
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByInstrument(const std::string& instrumentId) override {
+        SymbolId symbol;
+        if (!SymbolTable::Instance().Find(instrumentId, symbol)) {
+            return {};
+        }
+        return CollectFromShards([symbol](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectByInstrument(symbol, out);
+        });
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByAssetClass(AssetClass assetClass) override {
+        return CollectFromShards([assetClass](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectByAssetClass(assetClass, out);
+        });
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetByStatus(TradeStatus status) override {
+        return CollectFromShards([status](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectByStatus(status, out);
+        });
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetAll() override {
+        return CollectFromShards([](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectAll(out);
+        });
+    }
+
+    void ForEach(const TradePredicate& predicate, const TradeVisitor& visitor) override {
+        ForEachInShards(m_shardMask + 1, [this](std::size_t shard, std::size_t& slot, auto& visit) {
+            return ScanChunk(shard, slot, visit);
+        }, predicate, visitor);
+    }
+
+    std::string ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                         const TradePredicate& predicate, const TradeVisitor& visitor) override {
+        return ReadPageInShards(m_shardMask + 1, [this](std::size_t shard, std::size_t& slot, auto& visit) {
+            return ScanChunk(shard, slot, visit);
+        }, continuationToken, pageSize, predicate, visitor);
+    }
+
+    bool Exists(const std::string& tradeId) override {
+        auto& shard = TradeShardFor(tradeId);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.trades.Contains(tradeId);
+    }
+
+    bool UpdateStatus(const std::string& tradeId, TradeStatus status) override {
+        auto& shard = TradeShardFor(tradeId);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        TradeStatus previousStatus;
+        auto trade = shard.trades.UpdateStatus(tradeId, status, previousStatus);
+        if (!trade) {
+            return false;
+        }
+        m_listeners.StatusChanged(trade, previousStatus);
+        return true;
+    }
+
+    StatusTransition TransitionStatus(const std::string& tradeId, TradeStatus status,
+                                      StatusTransitionRule rule) override {
+        auto& shard = TradeShardFor(tradeId);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return TransitionLocked(shard, tradeId, status, rule);
+    }
+
+    std::vector<StatusTransition> TransitionStatuses(const std::vector<std::string>& tradeIds, TradeStatus status,
+                                                     StatusTransitionRule rule) override {
+        // Group by shard as SaveBatch does; results stay in input order
+        std::vector<std::vector<std::size_t>> byTradeShard(m_shardMask + 1);
+        for (std::size_t i = 0; i < tradeIds.size(); ++i) {
+            byTradeShard[std::hash<std::string>{}(tradeIds[i]) & m_shardMask].push_back(i);
+        }
+        std::vector<StatusTransition> result(tradeIds.size());
+        for (std::size_t s = 0; s <= m_shardMask; ++s) {
+            if (byTradeShard[s].empty()) {
+                continue;
+            }
+            auto& shard = m_tradeShards[s];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (std::size_t i : byTradeShard[s]) {
+                result[i] = TransitionLocked(shard, tradeIds[i], status, rule);
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> GetBySettlementDate(std::chrono::system_clock::time_point date) override {
+        auto day = TradeBookEngine::Core::Calendars::HolidayCalendar::ToDay(date);
+        return CollectFromShards([day](const TradeTable& trades, std::vector<std::shared_ptr<Trade>>& out) {
+            trades.CollectBySettlementDay(day, out);
+        });
+    }
+
+    void AddListener(std::shared_ptr<ITradeRepositoryListener> listener) override {
+        // Exclude every writer, in shard order, while the list changes
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+        locks.reserve(m_shardMask + 1);
+        for (std::size_t s = 0; s <= m_shardMask; ++s) {
+            locks.emplace_back(m_tradeShards[s].mutex);
+        }
+        m_listeners.Add(std::move(listener));
+    }
+
+    void Delete(const std::string& tradeId) override {
+        std::shared_ptr<Trade> removed;
+        {
+            auto& shard = TradeShardFor(tradeId);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            removed = shard.trades.Erase(tradeId);
+            if (!removed) {
+                return;
+            }
+            m_listeners.Deleted(removed);
+        }
+
+        // Also remove from idempotency key map if it still points at this trade
+        const auto& idempotencyKey = removed->GetIdempotencyKey();
+        if (!idempotencyKey.empty()) {
+            auto& shard = KeyShardFor(idempotencyKey);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.tradesByIdempotencyKey.find(idempotencyKey);
+            if (it != shard.tradesByIdempotencyKey.end() && it->second == removed) {
+                shard.tradesByIdempotencyKey.erase(it);
+            }
+        }
+    }
+};
+
+// Factory function
+extern "C" {
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount) {
+        return new ShardedTradeRepository(shardCount);
+    }
+
+    void DestroyShardedTradeRepository(ITradeRepository* repository) {
+        delete repository;
+    }
+}
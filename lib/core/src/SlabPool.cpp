@@ -0,0 +1,192 @@
+#include "../include/TradeBookEngine/Core/Memory/SlabPool.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace TradeBookEngine::Core::Memory;
+
+namespace {
+
+    constexpr std::size_t Granularity = 32;
+    constexpr std::size_t ClassCount = SlabPool::MaxBlockSize / Granularity;
+    constexpr std::size_t SlabBytes = 64 * 1024;
+    // A thread keeps at most this many free blocks per class and returns
+    // half of them to the depot when it goes over
+    constexpr std::uint32_t ThreadCacheLimit = 1024;
+    // Blocks a thread takes from the depot at once
+    constexpr std::size_t RefillBatch = 64;
+
+    std::size_t ClassOf(std::size_t bytes) {
+        return bytes == 0 ? 0 : (bytes - 1) / Granularity;
+    }
+
+    std::size_t BlockSizeOf(std::size_t sizeClass) {
+        return (sizeClass + 1) * Granularity;
+    }
+
+    // Free blocks are linked through their first word
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head;
+        std::uint32_t count;
+    };
+
+    class Depot {
+    private:
+        struct alignas(64) ClassDepot {
+            std::mutex mutex;
+            std::vector<void*> blocks;
+        };
+
+        ClassDepot m_classes[ClassCount];
+        std::atomic<std::size_t> m_slabBytes{0};
+
+    public:
+        // Intentionally leaked: blocks may be released during static destruction
+        static Depot& Instance() {
+            static Depot* depot = new Depot();
+            return *depot;
+        }
+
+        void Put(std::size_t sizeClass, FreeList& list, std::uint32_t count) {
+            auto& depot = m_classes[sizeClass];
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            for (std::uint32_t i = 0; i < count && list.head; ++i) {
+                FreeBlock* block = list.head;
+                list.head = block->next;
+                --list.count;
+                depot.blocks.push_back(block);
+            }
+        }
+
+        void PutOne(std::size_t sizeClass, void* block) {
+            auto& depot = m_classes[sizeClass];
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            depot.blocks.push_back(block);
+        }
+
+        // Fills list from parked blocks, or carves a fresh slab
+        void Refill(std::size_t sizeClass, FreeList& list) {
+            auto& depot = m_classes[sizeClass];
+            {
+                std::lock_guard<std::mutex> lock(depot.mutex);
+                std::size_t take = depot.blocks.size() < RefillBatch ? depot.blocks.size() : RefillBatch;
+                for (std::size_t i = 0; i < take; ++i) {
+                    auto* block = static_cast<FreeBlock*>(depot.blocks.back());
+                    depot.blocks.pop_back();
+                    block->next = list.head;
+                    list.head = block;
+                    ++list.count;
+                }
+                if (take > 0) {
+                    return;
+                }
+            }
+
+            std::size_t blockSize = BlockSizeOf(sizeClass);
+            auto* slab = static_cast<char*>(::operator new(SlabBytes));
+            m_slabBytes.fetch_add(SlabBytes, std::memory_order_relaxed);
+            for (std::size_t offset = SlabBytes - SlabBytes % blockSize; offset >= blockSize; ) {
+                offset -= blockSize;
+                auto* block = reinterpret_cast<FreeBlock*>(slab + offset);
+                block->next = list.head;
+                list.head = block;
+                ++list.count;
+            }
+        }
+
+        SlabPoolStats GetStats() {
+            SlabPoolStats stats{m_slabBytes.load(std::memory_order_relaxed), 0};
+            for (auto& depot : m_classes) {
+                std::lock_guard<std::mutex> lock(depot.mutex);
+                stats.DepotBlocks += depot.blocks.size();
+            }
+            return stats;
+        }
+    };
+
+    // Trivially destructible, so still usable while other thread-locals are
+    // being destroyed
+    thread_local FreeList t_lists[ClassCount];
+    thread_local bool t_registered = false;
+    thread_local bool t_retired = false;
+
+    struct ThreadCacheRetirer {
+        ~ThreadCacheRetirer() {
+            auto& depot = Depot::Instance();
+            for (std::size_t c = 0; c < ClassCount; ++c) {
+                depot.Put(c, t_lists[c], t_lists[c].count);
+            }
+            t_retired = true;
+        }
+    };
+
+    thread_local ThreadCacheRetirer t_retirer;
+
+    void RegisterThread() {
+        t_registered = true;
+        (void)&t_retirer; // Constructs it, so it runs at thread exit
+    }
+
+} // namespace
+
+void* SlabPool::Allocate(std::size_t bytes) {
+    if (bytes > MaxBlockSize) {
+        return ::operator new(bytes);
+    }
+    std::size_t sizeClass = ClassOf(bytes);
+    if (t_retired) {
+        FreeList list{nullptr, 0};
+        Depot::Instance().Refill(sizeClass, list);
+        void* block = list.head;
+        list.head = list.head->next;
+        --list.count;
+        Depot::Instance().Put(sizeClass, list, list.count);
+        return block;
+    }
+
+    FreeList& list = t_lists[sizeClass];
+    if (!list.head) {
+        if (!t_registered) {
+            RegisterThread();
+        }
+        Depot::Instance().Refill(sizeClass, list);
+    }
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    --list.count;
+    return block;
+}
+
+void SlabPool::Deallocate(void* block, std::size_t bytes) noexcept {
+    if (!block) {
+        return;
+    }
+    if (bytes > MaxBlockSize) {
+        ::operator delete(block);
+        return;
+    }
+    std::size_t sizeClass = ClassOf(bytes);
+    if (t_retired) {
+        Depot::Instance().PutOne(sizeClass, block);
+        return;
+    }
+    if (!t_registered) {
+        RegisterThread();
+    }
+
+    FreeList& list = t_lists[sizeClass];
+    auto* freed = static_cast<FreeBlock*>(block);
+    freed->next = list.head;
+    list.head = freed;
+    if (++list.count > ThreadCacheLimit) {
+        Depot::Instance().Put(sizeClass, list, ThreadCacheLimit / 2);
+    }
+}
+
+SlabPoolStats SlabPool::GetStats() {
+    return Depot::Instance().GetStats();
+}
@@ -0,0 +1,930 @@
+#include "../include/TradeBookEngine/Core/Repositories/SnapshotTradeRepository.hpp"
+#include "FileIo.hpp"
+#include "TableScan.hpp"
+#include "TradeCodec.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace TradeBookEngine::Core::Repositories;
+using namespace TradeBookEngine::Core::Interfaces;
+using namespace TradeBookEngine::Core::Models;
+using namespace TradeBookEngine::Core::Enums;
+using namespace TradeBookEngine::Core::Storage;
+
+extern "C" {
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+    void DestroyShardedTradeRepository(ITradeRepository* repository);
+}
+
+namespace {
+
+    // File layout, little-endian, every section 8-byte aligned:
+    //   SnapshotHeader
+    //   SnapshotRecord[TradeCount]         fixed-size trades
+    //   SnapshotAttribute[AttributeCount]  key/value string ids
+    //   u64[StringCount + 1]               start of each string in the bytes
+    //   char[StringBytesSize]              string bytes, each string stored once
+    //   u32[StringIndexSlots]              hash index: string -> string id + 1
+    //   u32[IdIndexSlots]                  hash index: trade id -> record + 1
+    //   u32[KeyIndexSlots]                 hash index: idempotency key -> record + 1
+    //   SnapshotDay[DayCount + 1]          settlement days, ascending, then an end marker
+    //   u32[TradeCount]                    records sorted by settlement day
+    // String id 0 is the empty string. Indexes use linear probing and 0 marks
+    // an empty slot.
+
+    constexpr char SnapshotMagic[8] = {'T', 'B', 'S', 'N', 'A', 'P', '\0', '\0'};
+    constexpr std::uint32_t SnapshotVersion = 2;
+
+    struct SnapshotHeader {
+        char Magic[8];
+        std::uint32_t Version;
+        std::uint32_t RecordSize;
+        std::uint64_t FileSize;
+        std::uint64_t TradeCount;
+        std::uint64_t RecordsOffset;
+        std::uint64_t AttributeCount;
+        std::uint64_t AttributesOffset;
+        std::uint64_t StringCount;
+        std::uint64_t StringOffsetsOffset;
+        std::uint64_t StringBytesSize;
+        std::uint64_t StringBytesOffset;
+        std::uint64_t StringIndexSlots;
+        std::uint64_t StringIndexOffset;
+        std::uint64_t IdIndexSlots;
+        std::uint64_t IdIndexOffset;
+        std::uint64_t KeyIndexSlots;
+        std::uint64_t KeyIndexOffset;
+        std::uint64_t DayCount;
+        std::uint64_t DaysOffset;
+        std::uint64_t DayRecordsOffset;
+        std::uint32_t HeaderCrc;  // CRC-32C of the header with this field zero
+        std::uint32_t Reserved;
+    };
+
+    struct SnapshotRecord {
+        std::uint32_t TradeId;
+        std::uint32_t InstrumentId;
+        std::uint32_t Counterparty;
+        std::uint32_t Currency;
+        std::uint32_t IdempotencyKey;
+        std::uint32_t CorrelationId;
+        std::uint32_t CreatedBy;
+        std::uint8_t AssetClass;
+        std::uint8_t Side;
+        std::uint8_t Status;
+        std::uint8_t Reserved;
+        double Notional;
+        std::int64_t TradeDate;       // Nanoseconds since the Unix epoch
+        std::int64_t SettlementDate;
+        std::int64_t CreatedAt;
+        std::uint32_t FirstAttribute;
+        std::uint32_t AttributeCount;
+    };
+
+    struct SnapshotAttribute {
+        std::uint32_t Key;
+        std::uint32_t Value;
+    };
+
+    // Records settling on Day are DayRecords[First, next entry's First)
+    struct SnapshotDay {
+        std::int32_t Day;  // Days since the Unix epoch, UTC
+        std::uint32_t First;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 168, "Snapshot header layout changed");
+    static_assert(sizeof(SnapshotRecord) == 72, "Snapshot record layout changed");
+    static_assert(sizeof(SnapshotAttribute) == 8, "Snapshot attribute layout changed");
+    static_assert(sizeof(SnapshotDay) == 8, "Snapshot day layout changed");
+    static_assert(std::is_trivially_copyable<SnapshotRecord>::value, "Snapshot records are copied as bytes");
+
+    bool LittleEndianHost() {
+        std::uint16_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    std::uint64_t HashBytes(std::string_view text) {
+        // FNV-1a; stable across builds, unlike std::hash
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::uint64_t IndexSlotsFor(std::size_t entries) {
+        std::uint64_t slots = 1;
+        while (slots < entries * 2) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    std::size_t AlignUp(std::size_t offset) {
+        return (offset + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    std::int64_t ToNanos(const std::chrono::system_clock::time_point& time) {
+        return static_cast<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+
+    std::chrono::system_clock::time_point FromNanos(std::int64_t nanos) {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    constexpr std::size_t NotFound = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Repositories {
+
+    class SnapshotImage {
+    private:
+        MappedFile m_file;
+        SnapshotHeader m_header;
+        const SnapshotRecord* m_records = nullptr;
+        const SnapshotAttribute* m_attributes = nullptr;
+        const std::uint64_t* m_stringOffsets = nullptr;
+        const char* m_stringBytes = nullptr;
+        const std::uint32_t* m_stringIndex = nullptr;
+        const std::uint32_t* m_idIndex = nullptr;
+        const std::uint32_t* m_keyIndex = nullptr;
+        const SnapshotDay* m_days = nullptr;
+        const std::uint32_t* m_dayRecords = nullptr;
+
+        [[noreturn]] static void Corrupt(const std::string& what) {
+            throw SnapshotError("Corrupt trade snapshot: " + what);
+        }
+
+        template <typename T>
+        const T* Section(std::uint64_t offset, std::uint64_t count, const char* name) const {
+            if (offset % alignof(T) != 0 || offset > m_header.FileSize ||
+                count > (m_header.FileSize - offset) / sizeof(T)) {
+                Corrupt(std::string(name) + " section out of bounds");
+            }
+            return reinterpret_cast<const T*>(m_file.Data() + offset);
+        }
+
+        // Probes a hash index; matches(value - 1) compares the candidate entry
+        template <typename Matches>
+        std::size_t Probe(const std::uint32_t* index, std::uint64_t slots, std::uint64_t limit,
+                          std::string_view key, Matches&& matches) const {
+            std::uint64_t mask = slots - 1;
+            for (std::uint64_t slot = HashBytes(key) & mask, probes = 0; probes < slots; slot = (slot + 1) & mask, ++probes) {
+                std::uint32_t value = index[slot];
+                if (value == 0) {
+                    return NotFound;
+                }
+                if (value > limit) {
+                    Corrupt("index entry out of range");
+                }
+                if (matches(value - 1)) {
+                    return value - 1;
+                }
+            }
+            return NotFound;
+        }
+
+    public:
+        explicit SnapshotImage(const std::string& path) {
+            if (!LittleEndianHost()) {
+                throw SnapshotError("Trade snapshots require a little-endian host");
+            }
+            std::string error;
+            if (!m_file.Open(path, error)) {
+                throw SnapshotError(error);
+            }
+            if (m_file.Size() < sizeof(SnapshotHeader)) {
+                Corrupt("file too short: " + path);
+            }
+            std::memcpy(&m_header, m_file.Data(), sizeof(m_header));
+            SnapshotHeader unsealed = m_header;
+            unsealed.HeaderCrc = 0;
+            if (std::memcmp(m_header.Magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+                throw SnapshotError("Not a trade snapshot: " + path);
+            }
+            if (m_header.Version != SnapshotVersion || m_header.RecordSize != sizeof(SnapshotRecord)) {
+                throw SnapshotError("Unsupported trade snapshot version " + std::to_string(m_header.Version) + ": " + path);
+            }
+            if (m_header.HeaderCrc != Crc32c(reinterpret_cast<const char*>(&unsealed), sizeof(unsealed)) ||
+                m_header.FileSize != m_file.Size()) {
+                Corrupt("header checksum or size mismatch: " + path);
+            }
+            auto powerOfTwo = [](std::uint64_t slots) { return slots != 0 && (slots & (slots - 1)) == 0; };
+            if (!powerOfTwo(m_header.StringIndexSlots) || !powerOfTwo(m_header.IdIndexSlots) ||
+                !powerOfTwo(m_header.KeyIndexSlots) || m_header.StringCount == 0 ||
+                m_header.TradeCount >= std::numeric_limits<std::uint32_t>::max() ||
+                m_header.DayCount > m_header.TradeCount) {
+                Corrupt("bad index geometry: " + path);
+            }
+
+            m_records = Section<SnapshotRecord>(m_header.RecordsOffset, m_header.TradeCount, "record");
+            m_attributes = Section<SnapshotAttribute>(m_header.AttributesOffset, m_header.AttributeCount, "attribute");
+            m_stringOffsets = Section<std::uint64_t>(m_header.StringOffsetsOffset, m_header.StringCount + 1, "string offset");
+            m_stringBytes = Section<char>(m_header.StringBytesOffset, m_header.StringBytesSize, "string");
+            m_stringIndex = Section<std::uint32_t>(m_header.StringIndexOffset, m_header.StringIndexSlots, "string index");
+            m_idIndex = Section<std::uint32_t>(m_header.IdIndexOffset, m_header.IdIndexSlots, "id index");
+            m_keyIndex = Section<std::uint32_t>(m_header.KeyIndexOffset, m_header.KeyIndexSlots, "key index");
+            m_days = Section<SnapshotDay>(m_header.DaysOffset, m_header.DayCount + 1, "day");
+            m_dayRecords = Section<std::uint32_t>(m_header.DayRecordsOffset, m_header.TradeCount, "day record");
+        }
+
+        std::size_t Count() const { return static_cast<std::size_t>(m_header.TradeCount); }
+        const SnapshotRecord& Record(std::size_t record) const { return m_records[record]; }
+
+        std::string_view String(std::uint32_t id) const {
+            if (id >= m_header.StringCount) {
+                Corrupt("string id out of range");
+            }
+            std::uint64_t begin = m_stringOffsets[id];
+            std::uint64_t end = m_stringOffsets[id + 1];
+            if (begin > end || end > m_header.StringBytesSize) {
+                Corrupt("string offsets out of range");
+            }
+            return std::string_view(m_stringBytes + begin, static_cast<std::size_t>(end - begin));
+        }
+
+        // String id of text, or NotFound if no trade uses it
+        std::size_t FindString(std::string_view text) const {
+            return Probe(m_stringIndex, m_header.StringIndexSlots, m_header.StringCount, text,
+                         [this, text](std::size_t id) { return String(static_cast<std::uint32_t>(id)) == text; });
+        }
+
+        std::size_t FindById(std::string_view tradeId) const {
+            return Probe(m_idIndex, m_header.IdIndexSlots, m_header.TradeCount, tradeId,
+                         [this, tradeId](std::size_t record) { return String(m_records[record].TradeId) == tradeId; });
+        }
+
+        std::size_t FindByKey(std::string_view key) const {
+            if (key.empty()) {
+                return NotFound;
+            }
+            return Probe(m_keyIndex, m_header.KeyIndexSlots, m_header.TradeCount, key,
+                         [this, key](std::size_t record) { return String(m_records[record].IdempotencyKey) == key; });
+        }
+
+        // Calls visit(record) for every record settling on day, in record order
+        template <typename Visit>
+        void ForEachSettlingOn(Calendars::Day day, Visit&& visit) const {
+            const SnapshotDay* end = m_days + m_header.DayCount;
+            const SnapshotDay* found = std::lower_bound(m_days, end, day,
+                [](const SnapshotDay& entry, Calendars::Day value) { return entry.Day < value; });
+            if (found == end || found->Day != day) {
+                return;
+            }
+            std::uint32_t first = found->First;
+            std::uint32_t last = found[1].First;
+            if (first > last || last > m_header.TradeCount) {
+                Corrupt("day index out of range");
+            }
+            for (std::uint32_t i = first; i < last; ++i) {
+                std::uint32_t record = m_dayRecords[i];
+                if (record >= m_header.TradeCount) {
+                    Corrupt("day index entry out of range");
+                }
+                visit(static_cast<std::size_t>(record));
+            }
+        }
+
+        std::shared_ptr<Trade> Materialize(std::size_t record) const {
+            const SnapshotRecord& source = m_records[record];
+            auto trade = std::make_shared<Trade>(std::string(String(source.TradeId)),
+                static_cast<AssetClass>(source.AssetClass), std::string(String(source.InstrumentId)),
+                std::string(String(source.Counterparty)), source.Notional, std::string(String(source.Currency)),
+                static_cast<TradeSide>(source.Side), FromNanos(source.TradeDate), FromNanos(source.SettlementDate),
+                std::string(String(source.CreatedBy)));
+            if (source.AttributeCount > 0) {
+                if (source.FirstAttribute > m_header.AttributeCount ||
+                    source.AttributeCount > m_header.AttributeCount - source.FirstAttribute) {
+                    Corrupt("attribute range out of bounds");
+                }
+                AttributeMap additional;
+                for (std::uint32_t i = 0; i < source.AttributeCount; ++i) {
+                    const SnapshotAttribute& attribute = m_attributes[source.FirstAttribute + i];
+                    additional[String(attribute.Key)] = String(attribute.Value);
+                }
+                trade->SetAdditional(additional);
+            }
+            trade->SetIdempotencyKey(std::string(String(source.IdempotencyKey)));
+            trade->SetCorrelationId(std::string(String(source.CorrelationId)));
+            trade->SetCreatedAt(FromNanos(source.CreatedAt));
+            trade->SetStatus(static_cast<TradeStatus>(source.Status));
+            return trade;
+        }
+    };
+
+} // namespace Repositories
+} // namespace Core
+} // namespace TradeBookEngine
+
+namespace {
+
+    class SnapshotBuilder {
+    private:
+        std::unordered_map<std::string, std::uint32_t> m_ids;
+        std::vector<const std::string*> m_strings;
+
+    public:
+        std::vector<SnapshotRecord> Records;
+        std::vector<SnapshotAttribute> Attributes;
+
+        SnapshotBuilder() { Intern(std::string_view()); }
+
+        std::uint32_t Intern(std::string_view text) {
+            auto inserted = m_ids.emplace(std::string(text), static_cast<std::uint32_t>(m_strings.size()));
+            if (inserted.second) {
+                m_strings.push_back(&inserted.first->first);
+            }
+            return inserted.first->second;
+        }
+
+        void Add(const Trade& trade) {
+            SnapshotRecord record{};
+            record.TradeId = Intern(trade.GetTradeId());
+            record.InstrumentId = Intern(trade.GetInstrumentId());
+            record.Counterparty = Intern(trade.GetCounterparty());
+            record.Currency = Intern(trade.GetCurrency());
+            record.IdempotencyKey = Intern(trade.GetIdempotencyKey());
+            record.CorrelationId = Intern(trade.GetCorrelationId());
+            record.CreatedBy = Intern(trade.GetCreatedBy());
+            record.AssetClass = static_cast<std::uint8_t>(trade.GetAssetClass());
+            record.Side = static_cast<std::uint8_t>(trade.GetSide());
+            record.Status = static_cast<std::uint8_t>(trade.GetStatus());
+            record.Notional = trade.GetNotional();
+            record.TradeDate = ToNanos(trade.GetTradeDate());
+            record.SettlementDate = ToNanos(trade.GetSettlementDate());
+            record.CreatedAt = ToNanos(trade.GetCreatedAt());
+            record.FirstAttribute = static_cast<std::uint32_t>(Attributes.size());
+            record.AttributeCount = static_cast<std::uint32_t>(trade.GetAdditional().size());
+            for (const auto& entry : trade.GetAdditional()) {
+                Attributes.push_back(SnapshotAttribute{Intern(entry.Key()), Intern(entry.Value.View())});
+            }
+            Records.push_back(record);
+        }
+
+        std::size_t StringCount() const { return m_strings.size(); }
+        const std::string& String(std::uint32_t id) const { return *m_strings[id]; }
+
+        // key(entry) gives the string an entry is indexed under; empty keys are skipped
+        template <typename Key>
+        std::vector<std::uint32_t> BuildIndex(std::size_t entries, Key&& key) const {
+            std::vector<std::uint32_t> index(static_cast<std::size_t>(IndexSlotsFor(entries)), 0);
+            std::size_t mask = index.size() - 1;
+            for (std::size_t entry = 0; entry < entries; ++entry) {
+                const std::string& text = key(entry);
+                if (text.empty()) {
+                    continue;
+                }
+                std::size_t slot = static_cast<std::size_t>(HashBytes(text)) & mask;
+                bool duplicate = false;
+                while (index[slot] != 0) {
+                    // The first trade holding an id or key wins
+                    if (key(index[slot] - 1) == text) {
+                        duplicate = true;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                if (!duplicate) {
+                    index[slot] = static_cast<std::uint32_t>(entry + 1);
+                }
+            }
+            return index;
+        }
+    };
+
+    template <typename T>
+    void AppendSection(std::vector<std::pair<const char*, std::size_t>>& chunks,
+                       std::size_t& offset, std::uint64_t& sectionOffset, const std::vector<T>& items) {
+        static const char padding[8] = {};
+        std::size_t aligned = AlignUp(offset);
+        if (aligned != offset) {
+            chunks.emplace_back(padding, aligned - offset);
+        }
+        sectionOffset = aligned;
+        offset = aligned + items.size() * sizeof(T);
+        if (!items.empty()) {
+            chunks.emplace_back(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(T));
+        }
+    }
+
+} // namespace
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Repositories {
+
+    SnapshotInfo WriteTradeSnapshot(ITradeRepository& repository, const std::string& path) {
+        if (!LittleEndianHost()) {
+            throw SnapshotError("Trade snapshots require a little-endian host");
+        }
+        SnapshotBuilder builder;
+        repository.ForEach(TradePredicate(), [&builder](const Trade& trade) {
+            builder.Add(trade);
+            return true;
+        });
+        if (builder.Records.size() >= std::numeric_limits<std::uint32_t>::max() ||
+            builder.StringCount() >= std::numeric_limits<std::uint32_t>::max()) {
+            throw SnapshotError("Too many trades for one snapshot");
+        }
+
+        std::vector<std::uint64_t> stringOffsets;
+        std::vector<char> stringBytes;
+        stringOffsets.reserve(builder.StringCount() + 1);
+        for (std::size_t id = 0; id < builder.StringCount(); ++id) {
+            const std::string& text = builder.String(static_cast<std::uint32_t>(id));
+            stringOffsets.push_back(stringBytes.size());
+            stringBytes.insert(stringBytes.end(), text.begin(), text.end());
+        }
+        stringOffsets.push_back(stringBytes.size());
+
+        const auto& records = builder.Records;
+        auto stringIndex = builder.BuildIndex(builder.StringCount(), [&builder](std::size_t id) -> const std::string& {
+            return builder.String(static_cast<std::uint32_t>(id));
+        });
+        auto idIndex = builder.BuildIndex(records.size(), [&builder, &records](std::size_t record) -> const std::string& {
+            return builder.String(records[record].TradeId);
+        });
+        auto keyIndex = builder.BuildIndex(records.size(), [&builder, &records](std::size_t record) -> const std::string& {
+            return builder.String(records[record].IdempotencyKey);
+        });
+
+        // Day index: records grouped by settlement day, in record order
+        // within a day, the way TradeTable buckets them
+        std::vector<Calendars::Day> recordDays(records.size());
+        std::vector<std::uint32_t> dayRecords(records.size());
+        for (std::size_t record = 0; record < records.size(); ++record) {
+            recordDays[record] = Calendars::HolidayCalendar::ToDay(FromNanos(records[record].SettlementDate));
+            dayRecords[record] = static_cast<std::uint32_t>(record);
+        }
+        std::stable_sort(dayRecords.begin(), dayRecords.end(), [&recordDays](std::uint32_t a, std::uint32_t b) {
+            return recordDays[a] < recordDays[b];
+        });
+        std::vector<SnapshotDay> days;
+        for (std::size_t i = 0; i < dayRecords.size(); ++i) {
+            Calendars::Day day = recordDays[dayRecords[i]];
+            if (days.empty() || days.back().Day != day) {
+                days.push_back(SnapshotDay{day, static_cast<std::uint32_t>(i)});
+            }
+        }
+        std::size_t dayCount = days.size();
+        days.push_back(SnapshotDay{0, static_cast<std::uint32_t>(records.size())});
+
+        SnapshotHeader header{};
+        std::memcpy(header.Magic, SnapshotMagic, sizeof(SnapshotMagic));
+        header.Version = SnapshotVersion;
+        header.RecordSize = sizeof(SnapshotRecord);
+        header.TradeCount = records.size();
+        header.AttributeCount = builder.Attributes.size();
+        header.StringCount = builder.StringCount();
+        header.StringBytesSize = stringBytes.size();
+        header.StringIndexSlots = stringIndex.size();
+        header.IdIndexSlots = idIndex.size();
+        header.KeyIndexSlots = keyIndex.size();
+        header.DayCount = dayCount;
+
+        std::vector<std::pair<const char*, std::size_t>> chunks;
+        chunks.emplace_back(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::size_t offset = sizeof(header);
+        AppendSection(chunks, offset, header.RecordsOffset, records);
+        AppendSection(chunks, offset, header.AttributesOffset, builder.Attributes);
+        AppendSection(chunks, offset, header.StringOffsetsOffset, stringOffsets);
+        AppendSection(chunks, offset, header.StringBytesOffset, stringBytes);
+        AppendSection(chunks, offset, header.StringIndexOffset, stringIndex);
+        AppendSection(chunks, offset, header.IdIndexOffset, idIndex);
+        AppendSection(chunks, offset, header.KeyIndexOffset, keyIndex);
+        AppendSection(chunks, offset, header.DaysOffset, days);
+        AppendSection(chunks, offset, header.DayRecordsOffset, dayRecords);
+        header.FileSize = offset;
+        header.HeaderCrc = Crc32c(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::string temporary = path + ".tmp";
+        int fd = OpenFile(temporary, true);
+        if (fd < 0) {
+            throw SnapshotError(ErrnoMessage("Cannot create snapshot " + temporary));
+        }
+        bool written = true;
+        for (const auto& chunk : chunks) {
+            written = written && WriteFully(fd, chunk.first, chunk.second);
+        }
+        written = written && SyncData(fd);
+        CloseFile(fd);
+        if (!written || std::rename(temporary.c_str(), path.c_str()) != 0 || !SyncDirectoryOf(path)) {
+            std::string message = ErrnoMessage("Cannot write snapshot " + path);
+            std::remove(temporary.c_str());
+            throw SnapshotError(message);
+        }
+        return SnapshotInfo{header.TradeCount, header.StringCount, header.FileSize};
+    }
+
+    SnapshotTradeRepository::SnapshotTradeRepository(const std::string& snapshotPath, std::size_t overlayShards)
+        : m_image(std::make_unique<SnapshotImage>(snapshotPath))
+        , m_overlay(CreateShardedTradeRepository(overlayShards), DestroyShardedTradeRepository)
+        , m_hidden((m_image->Count() + 63) / 64, 0) {
+    }
+
+    SnapshotTradeRepository::~SnapshotTradeRepository() = default;
+
+    bool SnapshotTradeRepository::IsHidden(std::size_t record) const {
+        return (m_hidden[record / 64] >> (record % 64)) & 1u;
+    }
+
+    void SnapshotTradeRepository::Hide(std::size_t record) {
+        m_hidden[record / 64] |= std::uint64_t{1} << (record % 64);
+    }
+
+    std::size_t SnapshotTradeRepository::FindVisible(const std::string& tradeId) const {
+        std::size_t record = m_image->FindById(tradeId);
+        return record != NotFound && !IsHidden(record) ? record : NotFound;
+    }
+
+    std::shared_ptr<Trade> SnapshotTradeRepository::FindVisibleByKey(const std::string& idempotencyKey) const {
+        std::size_t record = m_image->FindByKey(idempotencyKey);
+        return record != NotFound && !IsHidden(record) ? m_image->Materialize(record) : nullptr;
+    }
+
+    // Caller holds m_mutex
+    std::shared_ptr<Trade> SnapshotTradeRepository::CurrentTrade(const std::string& tradeId) const {
+        if (auto trade = m_overlay->GetById(tradeId)) {
+            return trade;
+        }
+        std::size_t record = FindVisible(tradeId);
+        return record != NotFound ? m_image->Materialize(record) : nullptr;
+    }
+
+    // Caller holds m_mutex exclusively
+    void SnapshotTradeRepository::SaveLocked(const std::shared_ptr<Trade>& trade) {
+        std::shared_ptr<Trade> replaced;
+        if (!m_listeners.empty()) {
+            replaced = CurrentTrade(trade->GetTradeId());
+        }
+        m_overlay->Save(trade);
+        std::size_t record = m_image->FindById(trade->GetTradeId());
+        if (record != NotFound) {
+            Hide(record);
+        }
+        for (const auto& listener : m_listeners) {
+            listener->OnTradeSaved(trade, replaced);
+        }
+    }
+
+    void SnapshotTradeRepository::Save(std::shared_ptr<Trade> trade) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        SaveLocked(trade);
+    }
+
+    void SnapshotTradeRepository::SaveBatch(const std::vector<std::shared_ptr<Trade>>& trades) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        for (const auto& trade : trades) {
+            SaveLocked(trade);
+        }
+    }
+
+    void SnapshotTradeRepository::Delete(const std::string& tradeId) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        auto existing = m_listeners.empty() ? nullptr : CurrentTrade(tradeId);
+        std::size_t record = m_image->FindById(tradeId);
+        if (record != NotFound) {
+            Hide(record);
+        }
+        m_overlay->Delete(tradeId);
+        if (existing) {
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeDeleted(existing);
+            }
+        }
+    }
+
+    bool SnapshotTradeRepository::UpdateStatus(const std::string& tradeId, TradeStatus status) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        auto trade = m_overlay->GetById(tradeId);
+        TradeStatus previous;
+        if (trade) {
+            previous = trade->GetStatus();
+            m_overlay->UpdateStatus(tradeId, status);
+        } else {
+            // Copy the snapshot trade into the overlay with its new status
+            std::size_t record = FindVisible(tradeId);
+            if (record == NotFound) {
+                return false;
+            }
+            trade = m_image->Materialize(record);
+            previous = trade->GetStatus();
+            if (previous == status) {
+                return true;
+            }
+            trade->SetStatus(status);
+            m_overlay->Save(trade);
+            Hide(record);
+        }
+        if (previous != status) {
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeStatusChanged(trade, previous);
+            }
+        }
+        return true;
+    }
+
+    // Caller holds m_mutex exclusively
+    StatusTransition SnapshotTradeRepository::TransitionLocked(const std::string& tradeId, TradeStatus status,
+                                                               StatusTransitionRule rule) {
+        auto result = m_overlay->TransitionStatus(tradeId, status, rule);
+        std::shared_ptr<Trade> trade;
+        if (result.Outcome == TransitionOutcome::Applied) {
+            trade = m_overlay->GetById(tradeId);
+        } else if (result.Outcome == TransitionOutcome::NotFound) {
+            std::size_t record = FindVisible(tradeId);
+            if (record == NotFound) {
+                return result;
+            }
+            result.Previous = static_cast<TradeStatus>(m_image->Record(record).Status);
+            if (result.Previous == status) {
+                result.Outcome = TransitionOutcome::Unchanged;
+                return result;
+            }
+            if (rule && !rule(result.Previous, status)) {
+                result.Outcome = TransitionOutcome::Refused;
+                return result;
+            }
+            // Copy the snapshot trade into the overlay with its new status
+            trade = m_image->Materialize(record);
+            trade->SetStatus(status);
+            m_overlay->Save(trade);
+            Hide(record);
+            result.Outcome = TransitionOutcome::Applied;
+        }
+        if (trade) {
+            for (const auto& listener : m_listeners) {
+                listener->OnTradeStatusChanged(trade, result.Previous);
+            }
+        }
+        return result;
+    }
+
+    StatusTransition SnapshotTradeRepository::TransitionStatus(const std::string& tradeId, TradeStatus status,
+                                                               StatusTransitionRule rule) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        return TransitionLocked(tradeId, status, rule);
+    }
+
+    std::vector<StatusTransition> SnapshotTradeRepository::TransitionStatuses(
+        const std::vector<std::string>& tradeIds, TradeStatus status, StatusTransitionRule rule) {
+        std::vector<StatusTransition> result;
+        result.reserve(tradeIds.size());
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        for (const auto& tradeId : tradeIds) {
+            result.push_back(TransitionLocked(tradeId, status, rule));
+        }
+        return result;
+    }
+
+    std::shared_ptr<Trade> SnapshotTradeRepository::GetById(const std::string& tradeId) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return CurrentTrade(tradeId);
+    }
+
+    std::shared_ptr<Trade> SnapshotTradeRepository::GetByIdempotencyKey(const std::string& idempotencyKey) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (auto trade = m_overlay->GetByIdempotencyKey(idempotencyKey)) {
+            return trade;
+        }
+        return FindVisibleByKey(idempotencyKey);
+    }
+
+    bool SnapshotTradeRepository::Exists(const std::string& tradeId) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_overlay->Exists(tradeId) || FindVisible(tradeId) != NotFound;
+    }
+
+    // Appends visible snapshot trades whose record satisfies match. Caller
+    // holds m_mutex.
+    template <typename Match>
+    void SnapshotTradeRepository::CollectSnapshot(Match&& match, std::vector<std::shared_ptr<Trade>>& out) const {
+        for (std::size_t record = 0; record < m_image->Count(); ++record) {
+            if (match(m_image->Record(record)) && !IsHidden(record)) {
+                out.push_back(m_image->Materialize(record));
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetByCounterparty(const std::string& counterparty) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetByCounterparty(counterparty);
+        std::size_t id = m_image->FindString(counterparty);
+        if (id != NotFound) {
+            CollectSnapshot([id](const SnapshotRecord& record) { return record.Counterparty == id; }, result);
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetByInstrument(const std::string& instrumentId) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetByInstrument(instrumentId);
+        std::size_t id = m_image->FindString(instrumentId);
+        if (id != NotFound) {
+            CollectSnapshot([id](const SnapshotRecord& record) { return record.InstrumentId == id; }, result);
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetByAssetClass(AssetClass assetClass) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetByAssetClass(assetClass);
+        auto value = static_cast<std::uint8_t>(assetClass);
+        CollectSnapshot([value](const SnapshotRecord& record) { return record.AssetClass == value; }, result);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetByStatus(TradeStatus status) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetByStatus(status);
+        auto value = static_cast<std::uint8_t>(status);
+        CollectSnapshot([value](const SnapshotRecord& record) { return record.Status == value; }, result);
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetBySettlementDate(
+        std::chrono::system_clock::time_point date) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetBySettlementDate(date);
+        m_image->ForEachSettlingOn(Calendars::HolidayCalendar::ToDay(date), [this, &result](std::size_t record) {
+            if (!IsHidden(record)) {
+                result.push_back(m_image->Materialize(record));
+            }
+        });
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetAll() {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        std::vector<std::shared_ptr<Trade>> result;
+        result.reserve(m_image->Count());
+        CollectSnapshot([](const SnapshotRecord&) { return true; }, result);
+        for (auto& trade : m_overlay->GetAll()) {
+            result.push_back(std::move(trade));
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Trade>> SnapshotTradeRepository::GetByIdempotencyKeys(
+        const std::vector<std::string>& idempotencyKeys) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto result = m_overlay->GetByIdempotencyKeys(idempotencyKeys);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            if (!result[i]) {
+                result[i] = FindVisibleByKey(idempotencyKeys[i]);
+            }
+        }
+        return result;
+    }
+
+    IdempotencyReservation SnapshotTradeRepository::ReserveIdempotencyKey(const std::string& idempotencyKey) {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (auto existing = FindVisibleByKey(idempotencyKey)) {
+                return IdempotencyReservation{ReservationStatus::Existing, existing};
+            }
+        }
+        // Not under m_mutex: this may wait for a Save that needs it
+        return m_overlay->ReserveIdempotencyKey(idempotencyKey);
+    }
+
+    void SnapshotTradeRepository::ReleaseIdempotencyKey(const std::string& idempotencyKey) {
+        m_overlay->ReleaseIdempotencyKey(idempotencyKey);
+    }
+
+    std::vector<IdempotencyReservation> SnapshotTradeRepository::TryReserveIdempotencyKeys(
+        const std::vector<std::string>& idempotencyKeys) {
+        std::vector<IdempotencyReservation> result(idempotencyKeys.size(),
+                                                   IdempotencyReservation{ReservationStatus::Reserved, nullptr});
+        std::vector<std::string> overlayKeys;
+        std::vector<std::size_t> overlayPositions;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            for (std::size_t i = 0; i < idempotencyKeys.size(); ++i) {
+                if (auto existing = FindVisibleByKey(idempotencyKeys[i])) {
+                    result[i] = IdempotencyReservation{ReservationStatus::Existing, existing};
+                } else {
+                    overlayKeys.push_back(idempotencyKeys[i]);
+                    overlayPositions.push_back(i);
+                }
+            }
+        }
+        auto reserved = m_overlay->TryReserveIdempotencyKeys(overlayKeys);
+        for (std::size_t i = 0; i < reserved.size(); ++i) {
+            result[overlayPositions[i]] = std::move(reserved[i]);
+        }
+        return result;
+    }
+
+    void SnapshotTradeRepository::AddListener(std::shared_ptr<ITradeRepositoryListener> listener) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_listeners.push_back(std::move(listener));
+    }
+
+    // Visits visible snapshot trades from record, one locked chunk at a
+    // time. Leaves record after the last trade examined and returns false if
+    // visit stopped the scan.
+    template <typename Visit>
+    bool SnapshotTradeRepository::ScanSnapshot(std::size_t& record, Visit&& visit) const {
+        while (record < m_image->Count()) {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            std::size_t end = std::min(m_image->Count(), record + ScanChunkSlots);
+            while (record < end) {
+                std::size_t current = record++;
+                if (!IsHidden(current) && !visit(*m_image->Materialize(current))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void SnapshotTradeRepository::ForEach(const TradePredicate& predicate, const TradeVisitor& visitor) {
+        std::size_t record = 0;
+        bool finished = ScanSnapshot(record, [&predicate, &visitor](const Trade& trade) {
+            return (predicate && !predicate(trade)) || visitor(trade);
+        });
+        if (finished) {
+            m_overlay->ForEach(predicate, visitor);
+        }
+    }
+
+    // Tokens are "s:<record>" while in the snapshot and "o:<overlay token>"
+    // once the scan has moved on to the overlay
+    std::string SnapshotTradeRepository::ReadPage(const std::string& continuationToken, std::size_t pageSize,
+                                                  const TradePredicate& predicate, const TradeVisitor& visitor) {
+        if (pageSize == 0) {
+            throw std::invalid_argument("Page size must be positive");
+        }
+        bool inSnapshot = true;
+        std::size_t record = 0;
+        std::string overlayToken;
+        if (!continuationToken.empty()) {
+            bool valid = continuationToken.size() >= 2 && continuationToken[1] == ':';
+            if (valid && continuationToken[0] == 'o') {
+                inSnapshot = false;
+                overlayToken = continuationToken.substr(2);
+            } else if (valid && continuationToken[0] == 's') {
+                std::size_t parsed = 0;
+                try {
+                    record = std::stoul(continuationToken.substr(2), &parsed);
+                } catch (const std::logic_error&) {
+                    valid = false;
+                }
+                valid = valid && parsed == continuationToken.size() - 2;
+            } else {
+                valid = false;
+            }
+            if (!valid) {
+                throw std::invalid_argument("Invalid continuation token: " + continuationToken);
+            }
+        }
+
+        std::size_t visited = 0;
+        if (inSnapshot) {
+            bool finished = ScanSnapshot(record, [&](const Trade& trade) {
+                if (predicate && !predicate(trade)) {
+                    return true;
+                }
+                return visitor(trade) && ++visited < pageSize;
+            });
+            if (!finished) {
+                return record < m_image->Count() ? "s:" + std::to_string(record) : std::string("o:");
+            }
+        }
+        std::string next = m_overlay->ReadPage(overlayToken, pageSize - visited, predicate, visitor);
+        return next.empty() ? std::string() : "o:" + next;
+    }
+
+    std::size_t SnapshotTradeRepository::SnapshotTradeCount() const {
+        return m_image->Count();
+    }
+
+} // namespace Repositories
+} // namespace Core
+} // namespace TradeBookEngine
+
+// Factory function; throws SnapshotError if the snapshot cannot be opened
+extern "C" {
+    TradeBookEngine::Core::Interfaces::ITradeRepository* CreateSnapshotTradeRepository(const char* path) {
+        return new SnapshotTradeRepository(path);
+    }
+
+    void DestroySnapshotTradeRepository(TradeBookEngine::Core::Interfaces::ITradeRepository* repository) {
+        delete repository;
+    }
+}
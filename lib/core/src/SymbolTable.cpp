@@ -0,0 +1,93 @@
+#include "../include/TradeBookEngine/Core/SymbolTable.hpp"
+#include <stdexcept>
+
+using namespace TradeBookEngine::Core::Symbols;
+
+SymbolTable& SymbolTable::Instance() {
+    // Never destroyed: trades resolved during static destruction stay valid
+    static SymbolTable* instance = new SymbolTable();
+    return *instance;
+}
+
+SymbolTable::SymbolTable()
+    : m_chunks(new std::atomic<std::string*>[MaxChunks])
+    , m_size(0)
+    , m_heapBytes(0) {
+    for (std::size_t i = 0; i < MaxChunks; ++i) {
+        m_chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+    Intern(std::string_view());
+    // Ids 1..3, matching Symbols::WellKnown
+    Intern("Exchange");
+    Intern("MaturityDate");
+    Intern("CreditRating");
+}
+
+SymbolTable::~SymbolTable() {
+    for (std::size_t i = 0; i < MaxChunks; ++i) {
+        delete[] m_chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+SymbolId SymbolTable::Intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_ids.find(text);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(text);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    if (m_size >= MaxChunks * ChunkSize) {
+        throw std::length_error("Symbol table is full");
+    }
+
+    std::size_t chunkIndex = m_size >> ChunkBits;
+    std::string* chunk = m_chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string[ChunkSize];
+        m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    auto id = static_cast<SymbolId>(m_size);
+    std::string& stored = chunk[m_size & ChunkMask];
+    stored.assign(text.data(), text.size());
+    if (stored.capacity() > std::string().capacity()) {
+        m_heapBytes += stored.capacity() + 1;
+    }
+    m_ids.emplace(std::string_view(stored), id);
+    ++m_size;
+    return id;
+}
+
+bool SymbolTable::Find(std::string_view text, SymbolId& id) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(text);
+    if (it == m_ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+std::size_t SymbolTable::Size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_size;
+}
+
+std::size_t SymbolTable::MemoryUsage() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::size_t chunks = (m_size + ChunkSize - 1) >> ChunkBits;
+    std::size_t mapNodes = m_ids.size() * (sizeof(std::string_view) + sizeof(SymbolId) + 2 * sizeof(void*));
+    return MaxChunks * sizeof(std::atomic<std::string*>)
+         + chunks * ChunkSize * sizeof(std::string)
+         + m_heapBytes
+         + mapNodes
+         + m_ids.bucket_count() * sizeof(void*);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "TradeTable.hpp"
+#include "../include/TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Storage {
+
+    // Slots examined per lock acquisition during ForEach and ReadPage
+    constexpr std::size_t ScanChunkSlots = 1024;
+
+    // Where a scan over one or more TradeTables resumes
+    struct ScanCursor {
+        std::size_t Shard = 0;
+        std::size_t Slot = 0;
+    };
+
+    inline std::string EncodeScanToken(const ScanCursor& cursor) {
+        return std::to_string(cursor.Shard) + ":" + std::to_string(cursor.Slot);
+    }
+
+    inline ScanCursor DecodeScanToken(const std::string& token, std::size_t shardCount) {
+        ScanCursor cursor;
+        if (token.empty()) {
+            return cursor;
+        }
+        try {
+            std::size_t separator = token.find(':');
+            std::size_t parsed = 0;
+            if (separator == std::string::npos) {
+                throw std::invalid_argument(token);
+            }
+            cursor.Shard = std::stoul(token.substr(0, separator), &parsed);
+            bool shardValid = parsed == separator;
+            cursor.Slot = std::stoul(token.substr(separator + 1), &parsed);
+            if (shardValid && parsed == token.size() - separator - 1 && cursor.Shard < shardCount) {
+                return cursor;
+            }
+        } catch (const std::logic_error&) {
+        }
+        throw std::invalid_argument("Invalid continuation token: " + token);
+    }
+
+    // Runs a scan across shards in order. scanChunk(shard, slot, visit) locks
+    // the shard, calls TradeTable::Scan for one chunk and returns its state.
+    template <typename ScanChunk, typename Visit>
+    TradeTable::ScanState ScanShards(ScanCursor& cursor, std::size_t shardCount,
+                                     ScanChunk&& scanChunk, Visit&& visit) {
+        while (cursor.Shard < shardCount) {
+            auto state = scanChunk(cursor.Shard, cursor.Slot, visit);
+            if (state == TradeTable::ScanState::Stopped) {
+                return state;
+            }
+            if (state == TradeTable::ScanState::Finished) {
+                ++cursor.Shard;
+                cursor.Slot = 0;
+            }
+        }
+        return TradeTable::ScanState::Finished;
+    }
+
+    template <typename ScanChunk>
+    void ForEachInShards(std::size_t shardCount, ScanChunk&& scanChunk,
+                         const Interfaces::TradePredicate& predicate,
+                         const Interfaces::TradeVisitor& visitor) {
+        ScanCursor cursor;
+        ScanShards(cursor, shardCount, scanChunk, [&predicate, &visitor](const Models::Trade& trade) {
+            return (predicate && !predicate(trade)) || visitor(trade);
+        });
+    }
+
+    template <typename ScanChunk>
+    std::string ReadPageInShards(std::size_t shardCount, ScanChunk&& scanChunk,
+                                 const std::string& continuationToken, std::size_t pageSize,
+                                 const Interfaces::TradePredicate& predicate,
+                                 const Interfaces::TradeVisitor& visitor) {
+        if (pageSize == 0) {
+            throw std::invalid_argument("Page size must be positive");
+        }
+        ScanCursor cursor = DecodeScanToken(continuationToken, shardCount);
+        std::size_t visited = 0;
+        auto state = ScanShards(cursor, shardCount, scanChunk,
+            [&predicate, &visitor, &visited, pageSize](const Models::Trade& trade) {
+                if (predicate && !predicate(trade)) {
+                    return true;
+                }
+                ++visited;
+                return visitor(trade) && visited < pageSize;
+            });
+        return state == TradeTable::ScanState::Finished ? std::string() : EncodeScanToken(cursor);
+    }
+
+} // namespace Storage
+} // namespace Core
+} // namespace TradeBookEngine
@@ -1,6 +1,7 @@
 #include "../include/TradeBookEngine/Core/Trade.hpp"
 #include "../include/TradeBookEngine/Core/Utils.hpp"
 
+using namespace TradeBookEngine::Core;
 using namespace TradeBookEngine::Core::Models;
 using namespace TradeBookEngine::Core::Enums;
 using namespace TradeBookEngine::Core::Utils;
@@ -17,14 +18,15 @@ Trade::Trade(const std::string& tradeId,
              const std::string& createdBy)
     : m_tradeId(tradeId)
     , m_assetClass(assetClass)
-    , m_instrumentId(instrumentId)
-    , m_counterparty(counterparty)
+    , m_currencyCode(currency)
+    , m_instrumentId(Symbols::Intern(instrumentId))
+    , m_counterparty(Symbols::Intern(counterparty))
+    , m_currency(Symbols::Intern(currency))
+    , m_createdBy(Symbols::Intern(createdBy))
     , m_notional(notional)
-    , m_currency(currency)
     , m_side(side)
     , m_tradeDate(tradeDate)
     , m_settlementDate(settlementDate)
-    , m_createdBy(createdBy)
     , m_createdAt(std::chrono::system_clock::now())
     , m_status(TradeStatus::Pending) {
 }
\ No newline at end of file
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "../include/TradeBookEngine/Core/Trade.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Storage {
+
+    // Little-endian binary encoding of trades, shared by the on-disk formats.
+    // Strings are a u32 length followed by the bytes; times are i64
+    // nanoseconds since the Unix epoch.
+
+    class BinaryWriter {
+    private:
+        std::string& m_out;
+
+    public:
+        explicit BinaryWriter(std::string& out) : m_out(out) {}
+
+        void PutU8(std::uint8_t value) { m_out.push_back(static_cast<char>(value)); }
+
+        void PutU32(std::uint32_t value) {
+            char bytes[4];
+            for (int i = 0; i < 4; ++i) {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+            m_out.append(bytes, sizeof(bytes));
+        }
+
+        void PutU64(std::uint64_t value) {
+            char bytes[8];
+            for (int i = 0; i < 8; ++i) {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+            m_out.append(bytes, sizeof(bytes));
+        }
+
+        void PutF64(double value) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            PutU64(bits);
+        }
+
+        void PutTime(const std::chrono::system_clock::time_point& time) {
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            PutU64(static_cast<std::uint64_t>(nanos));
+        }
+
+        void PutString(std::string_view text) {
+            PutU32(static_cast<std::uint32_t>(text.size()));
+            m_out.append(text.data(), text.size());
+        }
+
+        // Overwrites a u32 written earlier at offset
+        void PatchU32(std::size_t offset, std::uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                m_out[offset + static_cast<std::size_t>(i)] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+        }
+
+        std::size_t Size() const { return m_out.size(); }
+    };
+
+    // Bounds-checked reader; once a read runs past the end every later read
+    // fails and Ok() returns false
+    class BinaryReader {
+    private:
+        const char* m_data;
+        std::size_t m_size;
+        std::size_t m_position;
+        bool m_ok;
+
+        bool Take(std::size_t bytes, const char*& start) {
+            if (!m_ok || m_size - m_position < bytes) {
+                m_ok = false;
+                return false;
+            }
+            start = m_data + m_position;
+            m_position += bytes;
+            return true;
+        }
+
+    public:
+        BinaryReader(const char* data, std::size_t size)
+            : m_data(data), m_size(size), m_position(0), m_ok(true) {}
+
+        bool Ok() const { return m_ok; }
+        std::size_t Position() const { return m_position; }
+        std::size_t Remaining() const { return m_size - m_position; }
+
+        std::uint8_t GetU8() {
+            const char* start;
+            return Take(1, start) ? static_cast<std::uint8_t>(*start) : 0;
+        }
+
+        std::uint32_t GetU32() {
+            const char* start;
+            std::uint32_t value = 0;
+            if (Take(4, start)) {
+                for (int i = 0; i < 4; ++i) {
+                    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(start[i])) << (8 * i);
+                }
+            }
+            return value;
+        }
+
+        std::uint64_t GetU64() {
+            const char* start;
+            std::uint64_t value = 0;
+            if (Take(8, start)) {
+                for (int i = 0; i < 8; ++i) {
+                    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(start[i])) << (8 * i);
+                }
+            }
+            return value;
+        }
+
+        double GetF64() {
+            std::uint64_t bits = GetU64();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        std::chrono::system_clock::time_point GetTime() {
+            auto nanos = std::chrono::nanoseconds(static_cast<std::int64_t>(GetU64()));
+            return std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(nanos));
+        }
+
+        std::string_view GetString() {
+            std::uint32_t length = GetU32();
+            const char* start;
+            return Take(length, start) ? std::string_view(start, length) : std::string_view();
+        }
+    };
+
+    // CRC-32C (Castagnoli), for record checksums
+    inline std::uint32_t Crc32c(const char* data, std::size_t size, std::uint32_t crc = 0) {
+        struct Table {
+            std::uint32_t entries[256];
+            Table() {
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    std::uint32_t value = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        value = (value & 1) ? (value >> 1) ^ 0x82F63B78u : value >> 1;
+                    }
+                    entries[i] = value;
+                }
+            }
+        };
+        static const Table table;
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc = table.entries[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    inline void EncodeTrade(const Models::Trade& trade, BinaryWriter& out) {
+        out.PutString(trade.GetTradeId());
+        out.PutU8(static_cast<std::uint8_t>(trade.GetAssetClass()));
+        out.PutString(trade.GetInstrumentId());
+        out.PutString(trade.GetCounterparty());
+        out.PutF64(trade.GetNotional());
+        out.PutString(trade.GetCurrency());
+        out.PutU8(static_cast<std::uint8_t>(trade.GetSide()));
+        out.PutTime(trade.GetTradeDate());
+        out.PutTime(trade.GetSettlementDate());
+        out.PutU32(static_cast<std::uint32_t>(trade.GetAdditional().size()));
+        for (const auto& entry : trade.GetAdditional()) {
+            out.PutString(entry.Key());
+            out.PutString(entry.Value.View());
+        }
+        out.PutString(trade.GetIdempotencyKey());
+        out.PutString(trade.GetCorrelationId());
+        out.PutString(trade.GetCreatedBy());
+        out.PutTime(trade.GetCreatedAt());
+        out.PutU8(static_cast<std::uint8_t>(trade.GetStatus()));
+    }
+
+    // Returns nullptr if the input is truncated or malformed
+    inline std::shared_ptr<Models::Trade> DecodeTrade(BinaryReader& in) {
+        std::string tradeId(in.GetString());
+        auto assetClass = static_cast<Enums::AssetClass>(in.GetU8());
+        std::string instrumentId(in.GetString());
+        std::string counterparty(in.GetString());
+        double notional = in.GetF64();
+        std::string currency(in.GetString());
+        auto side = static_cast<Enums::TradeSide>(in.GetU8());
+        auto tradeDate = in.GetTime();
+        auto settlementDate = in.GetTime();
+        Models::AttributeMap additional;
+        std::uint32_t attributeCount = in.GetU32();
+        for (std::uint32_t i = 0; i < attributeCount && in.Ok(); ++i) {
+            auto key = in.GetString();
+            additional[key] = in.GetString();
+        }
+        std::string idempotencyKey(in.GetString());
+        std::string correlationId(in.GetString());
+        std::string createdBy(in.GetString());
+        auto createdAt = in.GetTime();
+        auto status = static_cast<Enums::TradeStatus>(in.GetU8());
+        if (!in.Ok()) {
+            return nullptr;
+        }
+
+        auto trade = std::make_shared<Models::Trade>(tradeId, assetClass, instrumentId, counterparty,
+            notional, currency, side, tradeDate, settlementDate, createdBy);
+        trade->SetAdditional(additional);
+        trade->SetIdempotencyKey(idempotencyKey);
+        trade->SetCorrelationId(correlationId);
+        trade->SetCreatedAt(createdAt);
+        trade->SetStatus(status);
+        return trade;
+    }
+
+} // namespace Storage
+} // namespace Core
+} // namespace TradeBookEngine
@@ -1,8 +1,12 @@
 #include "../include/TradeBookEngine/Core/TradeService.hpp"
 #include "../include/TradeBookEngine/Core/Utils.hpp"
 #include "../include/TradeBookEngine/Core/Events/TradeBookedEvent.hpp"
+#include "../include/TradeBookEngine/Core/Memory/SlabPool.hpp"
 #include <stdexcept>
 #include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <string_view>
 
 using namespace TradeBookEngine::Core::Services;
 using namespace TradeBookEngine::Core::Models;
@@ -10,42 +14,349 @@ using namespace TradeBookEngine::Core::Interfaces;
 using namespace TradeBookEngine::Core::Validators;
 using namespace TradeBookEngine::Core::Utils;
 using namespace TradeBookEngine::Core::Events;
+using namespace TradeBookEngine::Core::Metrics;
+
+namespace {
+
+    using TradeBookEngine::Core::Enums::TradeStatus;
+
+    // The end-of-day sweep settles Booked trades only
+    bool SettlesWhenDue(TradeStatus from, TradeStatus to) {
+        return from == TradeStatus::Booked && to == TradeStatus::Settled;
+    }
+
+} // namespace
 
 TradeService::TradeService(std::shared_ptr<ITradeRepository> repository,
                           std::shared_ptr<IEventPublisher> eventPublisher)
-    : m_repository(repository), m_eventPublisher(eventPublisher) {
+    : m_repository(repository), m_eventPublisher(eventPublisher), m_tradeAllocation(TradeAllocation::Heap),
+      m_settlementLag(2), m_metrics(std::make_unique<BookingMetrics>()), m_metricsEnabled(true),
+      m_metricsSampleInterval(16) {
 }
 
 void TradeService::AddValidator(std::shared_ptr<IAssetValidator> validator) {
-    m_validators.push_back(validator);
+    auto index = static_cast<std::size_t>(validator->GetSupportedAssetClass());
+    if (index < m_validators.size() && !m_validators[index]) {
+        m_validators[index] = std::move(validator);
+    }
+}
+
+void TradeService::SetSettlementCalendars(std::shared_ptr<const Calendars::CalendarRegistry> calendars,
+                                          int settlementLag) {
+    m_settlementCalendars = std::move(calendars);
+    m_settlementLag = settlementLag;
 }
 
 std::shared_ptr<Trade> TradeService::BookTrade(const TradeDto& tradeDto) {
-    // Check for duplicate idempotency key
-    if (!tradeDto.IdempotencyKey.empty()) {
-        auto existingTrade = m_repository->GetByIdempotencyKey(tradeDto.IdempotencyKey);
-        if (existingTrade) {
-            return existingTrade; // Return existing trade for idempotency
+    auto result = TryBookTrade(tradeDto);
+    if (result.Status == BookingStatus::Rejected) {
+        throw std::invalid_argument(RejectionMessage(result.Error, tradeDto));
+    }
+    return result.Trade;
+}
+
+BookingOutcome TradeService::TryBookTrade(const TradeDto& tradeDto) {
+    BookingOutcome result;
+    const auto& idempotencyKey = tradeDto.IdempotencyKey;
+    auto* metrics = m_metricsEnabled ? &m_metrics->Local() : nullptr;
+    StageTimer timer(metrics, BookingStage::Total, metrics && metrics->SampleNext(m_metricsSampleInterval));
+
+    // One probe both detects a duplicate and claims the key for this booking,
+    // so concurrent retries of the same key cannot both create a trade
+    if (!idempotencyKey.empty()) {
+        auto reservation = m_repository->ReserveIdempotencyKey(idempotencyKey);
+        timer.Lap(BookingStage::IdempotencyLookup);
+        if (reservation.Status == ReservationStatus::Existing) {
+            result.Status = BookingStatus::Duplicate;
+            result.Trade = reservation.Existing; // Return existing trade for idempotency
+            if (metrics) {
+                ThreadBookingMetrics::Add(metrics->IdempotentHits, 1);
+            }
+            return result;
         }
     }
 
     // Validate the trade
-    ValidateTrade(tradeDto);
+    std::chrono::system_clock::time_point settlementDate;
+    result.Error = CheckTrade(tradeDto, settlementDate);
+    timer.Lap(BookingStage::Validation);
+    if (result.Error) {
+        if (!idempotencyKey.empty()) {
+            m_repository->ReleaseIdempotencyKey(idempotencyKey);
+        }
+        result.Status = BookingStatus::Rejected;
+        if (metrics) {
+            metrics->AddReject(static_cast<std::int32_t>(result.Error.Code));
+        }
+        return result;
+    }
 
-    // Convert DTO to Trade model
-    auto trade = ConvertToTrade(tradeDto);
+    std::shared_ptr<Trade> trade;
+    bool limitReserved = false;
+    try {
+        // Convert DTO to Trade model
+        trade = ConvertToTrade(tradeDto, settlementDate);
 
-    // Set status to booked
-    trade->SetStatus(Enums::TradeStatus::Booked);
+        // Set status to booked
+        trade->SetStatus(Enums::TradeStatus::Booked);
+        timer.Lap(BookingStage::Conversion);
 
-    // Save to repository
-    m_repository->Save(trade);
+        // Checked on the converted trade, which already holds the interned
+        // counterparty
+        if (m_limits) {
+            limitReserved = m_limits->Reserve(trade->GetCounterpartySymbol(), trade->GetNotional());
+            timer.Lap(BookingStage::LimitCheck);
+            if (!limitReserved) {
+                if (!idempotencyKey.empty()) {
+                    m_repository->ReleaseIdempotencyKey(idempotencyKey);
+                }
+                result.Status = BookingStatus::Rejected;
+                result.Error.Code = BookingErrorCode::LimitBreached;
+                result.Error.Field = "Notional";
+                if (metrics) {
+                    metrics->AddReject(static_cast<std::int32_t>(result.Error.Code));
+                }
+                return result;
+            }
+        }
+
+        // Save to repository; this fulfils the reservation
+        m_repository->Save(trade);
+        timer.Lap(BookingStage::RepositorySave);
+    } catch (...) {
+        if (limitReserved) {
+            m_limits->Release(trade->GetCounterpartySymbol(), trade->GetNotional());
+        }
+        if (!idempotencyKey.empty()) {
+            m_repository->ReleaseIdempotencyKey(idempotencyKey);
+        }
+        throw;
+    }
+    if (limitReserved) {
+        m_limits->Commit(trade->GetCounterpartySymbol(), trade->GetNotional());
+    }
 
     // Publish event
     TradeBookedEvent event(trade, tradeDto.CorrelationId);
     m_eventPublisher->Publish(event);
+    timer.Lap(BookingStage::Publish);
 
-    return trade;
+    result.Status = BookingStatus::Booked;
+    result.Trade = std::move(trade);
+    if (metrics) {
+        ThreadBookingMetrics::Add(metrics->Booked, 1);
+    }
+    return result;
+}
+
+std::vector<BookingResult> TradeService::BookTrades(const std::vector<TradeDto>& tradeDtos) {
+    return BookTrades(tradeDtos.data(), tradeDtos.size());
+}
+
+std::vector<BookingResult> TradeService::BookTrades(const TradeDto* tradeDtos, std::size_t count) {
+    std::vector<BookingResult> results(count);
+    if (count == 0) {
+        return results;
+    }
+    auto* metrics = m_metricsEnabled ? &m_metrics->Local() : nullptr;
+    StageTimer timer(metrics, BookingStage::BatchTotal, metrics && metrics->SampleNext(m_metricsSampleInterval));
+    std::uint64_t duplicates = 0;
+
+    // Reserve every distinct idempotency key with a single repository call
+    std::unordered_map<std::string_view, std::size_t, std::hash<std::string_view>, std::equal_to<std::string_view>,
+                       Memory::PoolAllocator<std::pair<const std::string_view, std::size_t>>> keySlots;
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& key = tradeDtos[i].IdempotencyKey;
+        if (!key.empty() && keySlots.emplace(key, keys.size()).second) {
+            keys.push_back(key);
+        }
+    }
+
+    std::vector<IdempotencyReservation> reservations;
+    if (!keys.empty()) {
+        reservations = m_repository->TryReserveIdempotencyKeys(keys);
+        timer.Lap(BookingStage::BatchReservation);
+    }
+
+    auto releaseReservations = [this, &keys, &reservations](bool unboundOnly) {
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            if (reservations[k].Status == ReservationStatus::Reserved &&
+                !(unboundOnly && reservations[k].Existing)) {
+                m_repository->ReleaseIdempotencyKey(keys[k]);
+            }
+        }
+    };
+
+    // Validate and convert. A reserved key is bound to the first valid trade
+    // that carries it, so repeats within the batch resolve to that trade.
+    std::vector<std::shared_ptr<Trade>> trades;
+    std::vector<std::size_t> tradeOwners;
+    std::vector<std::size_t> deferred;
+    trades.reserve(count);
+    tradeOwners.reserve(count);
+
+    try {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& tradeDto = tradeDtos[i];
+            auto& result = results[i];
+
+            IdempotencyReservation* reservation = nullptr;
+            if (!tradeDto.IdempotencyKey.empty()) {
+                reservation = &reservations[keySlots.find(tradeDto.IdempotencyKey)->second];
+                if (reservation->Status == ReservationStatus::Pending) {
+                    // Held by a concurrent booking; resolve after our own reservations are done
+                    deferred.push_back(i);
+                    continue;
+                }
+                if (reservation->Existing) {
+                    result.Status = BookingStatus::Duplicate;
+                    result.Trade = reservation->Existing;
+                    ++duplicates;
+                    continue;
+                }
+            }
+
+            timer.Mark();
+            std::chrono::system_clock::time_point settlementDate;
+            auto error = CheckTrade(tradeDto, settlementDate);
+            timer.Lap(BookingStage::Validation);
+            if (error) {
+                result.Status = BookingStatus::Rejected;
+                result.Error = RejectionMessage(error, tradeDto);
+                if (metrics) {
+                    metrics->AddReject(static_cast<std::int32_t>(error.Code));
+                }
+                continue;
+            }
+
+            auto trade = ConvertToTrade(tradeDto, settlementDate);
+            trade->SetStatus(Enums::TradeStatus::Booked);
+            timer.Lap(BookingStage::Conversion);
+            if (m_limits) {
+                bool reserved = m_limits->Reserve(trade->GetCounterpartySymbol(), trade->GetNotional());
+                timer.Lap(BookingStage::LimitCheck);
+                if (!reserved) {
+                    BookingError breach;
+                    breach.Code = BookingErrorCode::LimitBreached;
+                    result.Status = BookingStatus::Rejected;
+                    result.Error = breach.Message();
+                    if (metrics) {
+                        metrics->AddReject(static_cast<std::int32_t>(breach.Code));
+                    }
+                    continue;
+                }
+            }
+            if (reservation) {
+                reservation->Existing = trade;
+            }
+
+            result.Status = BookingStatus::Booked;
+            result.Trade = trade;
+            trades.push_back(trade);
+            tradeOwners.push_back(i);
+        }
+
+        if (!trades.empty()) {
+            timer.Mark();
+            m_repository->SaveBatch(trades);
+            timer.Lap(BookingStage::BatchSave);
+        }
+    } catch (...) {
+        // Every trade converted so far holds a limit reservation
+        if (m_limits) {
+            for (const auto& trade : trades) {
+                m_limits->Release(trade->GetCounterpartySymbol(), trade->GetNotional());
+            }
+        }
+        releaseReservations(false);
+        throw;
+    }
+    if (m_limits) {
+        for (const auto& trade : trades) {
+            m_limits->Commit(trade->GetCounterpartySymbol(), trade->GetNotional());
+        }
+    }
+
+    // Give back keys whose every occurrence was rejected
+    releaseReservations(true);
+
+    std::uint64_t booked = trades.size();
+    if (!trades.empty()) {
+        timer.Mark();
+        // Reused across batches on this thread; cleared after publishing so
+        // it does not keep trades alive
+        thread_local std::vector<TradeBookedEvent> events;
+        events.clear();
+        events.reserve(trades.size());
+        for (std::size_t t = 0; t < trades.size(); ++t) {
+            events.emplace_back(std::move(trades[t]), tradeDtos[tradeOwners[t]].CorrelationId);
+        }
+        try {
+            m_eventPublisher->PublishBatch(events);
+        } catch (...) {
+            events.clear();
+            throw;
+        }
+        events.clear();
+        timer.Lap(BookingStage::BatchPublish);
+    }
+
+    // Deferred trades go through TryBookTrade, which records them itself
+    if (metrics) {
+        ThreadBookingMetrics::Add(metrics->Booked, booked);
+        ThreadBookingMetrics::Add(metrics->IdempotentHits, duplicates);
+    }
+    timer.Mark();
+    timer.Finish();
+
+    for (std::size_t i : deferred) {
+        auto outcome = TryBookTrade(tradeDtos[i]);
+        results[i].Status = outcome.Status;
+        results[i].Trade = std::move(outcome.Trade);
+        results[i].Error = RejectionMessage(outcome.Error, tradeDtos[i]);
+    }
+
+    return results;
+}
+
+StatusTransition TradeService::SettleTrade(const std::string& tradeId) {
+    return m_repository->TransitionStatus(tradeId, Enums::TradeStatus::Settled, Enums::IsValidTransition);
+}
+
+StatusTransition TradeService::CancelTrade(const std::string& tradeId) {
+    return m_repository->TransitionStatus(tradeId, Enums::TradeStatus::Cancelled, Enums::IsValidTransition);
+}
+
+StatusTransition TradeService::FailTrade(const std::string& tradeId) {
+    return m_repository->TransitionStatus(tradeId, Enums::TradeStatus::Failed, Enums::IsValidTransition);
+}
+
+std::vector<StatusTransition> TradeService::SettleTrades(const std::vector<std::string>& tradeIds) {
+    return m_repository->TransitionStatuses(tradeIds, Enums::TradeStatus::Settled, Enums::IsValidTransition);
+}
+
+std::vector<StatusTransition> TradeService::CancelTrades(const std::vector<std::string>& tradeIds) {
+    return m_repository->TransitionStatuses(tradeIds, Enums::TradeStatus::Cancelled, Enums::IsValidTransition);
+}
+
+std::vector<StatusTransition> TradeService::FailTrades(const std::vector<std::string>& tradeIds) {
+    return m_repository->TransitionStatuses(tradeIds, Enums::TradeStatus::Failed, Enums::IsValidTransition);
+}
+
+std::size_t TradeService::SettleDueTrades(std::chrono::system_clock::time_point date) {
+    std::vector<std::string> tradeIds;
+    for (const auto& trade : m_repository->GetBySettlementDate(date)) {
+        if (trade->GetStatus() == Enums::TradeStatus::Booked) {
+            tradeIds.push_back(trade->GetTradeId());
+        }
+    }
+    std::size_t settled = 0;
+    // A trade cancelled or failed since the lookup is refused, not settled
+    for (const auto& transition : m_repository->TransitionStatuses(tradeIds, Enums::TradeStatus::Settled, SettlesWhenDue)) {
+        settled += transition.Outcome == TransitionOutcome::Applied ? 1 : 0;
+    }
+    return settled;
 }
 
 std::shared_ptr<Trade> TradeService::GetTrade(const std::string& tradeId) {
@@ -56,58 +367,179 @@ std::vector<std::shared_ptr<Trade>> TradeService::GetTradesByCounterparty(const
     return m_repository->GetByCounterparty(counterparty);
 }
 
+std::vector<std::shared_ptr<Trade>> TradeService::GetTradesByInstrument(const std::string& instrumentId) {
+    return m_repository->GetByInstrument(instrumentId);
+}
+
+std::vector<std::shared_ptr<Trade>> TradeService::GetTradesByAssetClass(Enums::AssetClass assetClass) {
+    return m_repository->GetByAssetClass(assetClass);
+}
+
+std::vector<std::shared_ptr<Trade>> TradeService::GetTradesByStatus(Enums::TradeStatus status) {
+    return m_repository->GetByStatus(status);
+}
+
+std::vector<std::shared_ptr<Trade>> TradeService::GetTradesBySettlementDate(std::chrono::system_clock::time_point date) {
+    return m_repository->GetBySettlementDate(date);
+}
+
 std::vector<std::shared_ptr<Trade>> TradeService::GetAllTrades() {
     return m_repository->GetAll();
 }
 
-void TradeService::ValidateTrade(const TradeDto& tradeDto) {
+void TradeService::ForEachTrade(const TradeVisitor& visitor, const TradePredicate& predicate) {
+    m_repository->ForEach(predicate, visitor);
+}
+
+TradeCursor TradeService::OpenTradeCursor(std::size_t pageSize, const TradePredicate& predicate,
+                                          const std::string& continuationToken) {
+    return TradeCursor(*m_repository, pageSize, predicate, continuationToken);
+}
+
+std::string TradeService::ValidateTrade(const TradeDto& tradeDto) const {
+    std::chrono::system_clock::time_point settlementDate;
+    return RejectionMessage(CheckTrade(tradeDto, settlementDate), tradeDto);
+}
+
+BookingError TradeService::CheckTrade(const TradeDto& tradeDto,
+                                      std::chrono::system_clock::time_point& settlementDate) const {
+    BookingError error;
+
     // Basic validation
     if (tradeDto.InstrumentId.empty()) {
-        throw std::invalid_argument("InstrumentId cannot be empty");
-    }
-    if (tradeDto.Counterparty.empty()) {
-        throw std::invalid_argument("Counterparty cannot be empty");
+        error.Code = BookingErrorCode::EmptyInstrumentId;
+        error.Field = "InstrumentId";
+    } else if (tradeDto.Counterparty.empty()) {
+        error.Code = BookingErrorCode::EmptyCounterparty;
+        error.Field = "Counterparty";
+    } else if (tradeDto.Notional <= 0) {
+        error.Code = BookingErrorCode::NonPositiveNotional;
+        error.Field = "Notional";
+    } else if (tradeDto.Currency.empty()) {
+        error.Code = BookingErrorCode::EmptyCurrency;
+        error.Field = "Currency";
+    } else if (!SettlementDateFor(tradeDto, settlementDate)) {
+        error.Code = BookingErrorCode::TradeDateOutOfRange;
+        error.Field = "TradeDate";
+    } else {
+        // Asset-specific validation; messages are only built on request
+        auto index = static_cast<std::size_t>(tradeDto.AssetClass);
+        const IAssetValidator* validator = index < m_validators.size() ? m_validators[index].get() : nullptr;
+        ValidationErrorMask errors = validator ? validator->Check(tradeDto) : ValidationError::None;
+        if (errors != ValidationError::None) {
+            error.Code = BookingErrorCode::AssetValidation;
+            error.ValidationErrors = errors;
+            // Name the field behind the lowest error bit
+            if (errors & ValidationError::WrongAssetClass) {
+                error.Field = "AssetClass";
+            } else if (errors & ValidationError::InvalidInstrumentId) {
+                error.Field = "InstrumentId";
+            } else if (errors & ValidationError::InvalidNotional) {
+                error.Field = "Notional";
+            } else if (errors & ValidationError::MissingExchange) {
+                error.Field = "Additional.Exchange";
+            } else if (errors & ValidationError::MissingMaturityDate) {
+                error.Field = "Additional.MaturityDate";
+            } else if (errors & ValidationError::MissingCreditRating) {
+                error.Field = "Additional.CreditRating";
+            }
+        }
     }
-    if (tradeDto.Notional <= 0) {
-        throw std::invalid_argument("Notional must be positive");
+    return error;
+}
+
+std::string BookingError::Message() const {
+    switch (Code) {
+    case BookingErrorCode::None:
+        return std::string();
+    case BookingErrorCode::EmptyInstrumentId:
+        return "InstrumentId cannot be empty";
+    case BookingErrorCode::EmptyCounterparty:
+        return "Counterparty cannot be empty";
+    case BookingErrorCode::NonPositiveNotional:
+        return "Notional must be positive";
+    case BookingErrorCode::EmptyCurrency:
+        return "Currency cannot be empty";
+    case BookingErrorCode::AssetValidation: {
+        // One fixed message per library bit; custom bits share one
+        static const struct {
+            ValidationErrorMask Bit;
+            const char* Text;
+        } texts[] = {
+            {ValidationError::WrongAssetClass, "Asset class does not match the validator"},
+            {ValidationError::InvalidInstrumentId, "Invalid instrument ID"},
+            {ValidationError::InvalidNotional, "Invalid notional amount"},
+            {ValidationError::MissingExchange, "Exchange is required for equity trades"},
+            {ValidationError::MissingMaturityDate, "MaturityDate is required for bond trades"},
+            {ValidationError::MissingCreditRating, "CreditRating is required for bond trades"},
+        };
+        std::string message = "Validation failed: ";
+        ValidationErrorMask known = ValidationError::None;
+        for (const auto& entry : texts) {
+            known |= entry.Bit;
+            if (ValidationErrors & entry.Bit) {
+                message += entry.Text;
+                message += "; ";
+            }
+        }
+        if (ValidationErrors & ~known) {
+            message += "Rejected by the asset class validator; ";
+        }
+        return message;
     }
-    if (tradeDto.Currency.empty()) {
-        throw std::invalid_argument("Currency cannot be empty");
+    case BookingErrorCode::LimitBreached:
+        return "Counterparty limit exceeded";
+    case BookingErrorCode::TradeDateOutOfRange:
+        return "TradeDate is outside the settlement calendar's range; give a SettlementDate";
+    case BookingErrorCode::Internal:
+        break;
     }
+    return "Internal booking failure";
+}
 
-    // Asset-specific validation
-    auto validator = std::find_if(m_validators.begin(), m_validators.end(),
-        [&tradeDto](const std::shared_ptr<IAssetValidator>& v) {
-            return v->GetSupportedAssetClass() == tradeDto.AssetClass;
-        });
-
-    if (validator != m_validators.end()) {
-        if (!(*validator)->IsValid(tradeDto)) {
-            auto errors = (*validator)->GetValidationErrors(tradeDto);
-            std::string errorMsg = "Validation failed: ";
-            for (const auto& error : errors) {
-                errorMsg += error + "; ";
+// Asset validation failures in the validator's own words, which only it
+// knows for custom checks; the DTO and the validator are alive here
+std::string TradeService::RejectionMessage(const BookingError& error, const TradeDto& tradeDto) const {
+    if (error.Code == BookingErrorCode::AssetValidation) {
+        auto index = static_cast<std::size_t>(tradeDto.AssetClass);
+        if (index < m_validators.size() && m_validators[index]) {
+            std::string message = "Validation failed: ";
+            for (const auto& text : m_validators[index]->GetValidationErrors(tradeDto)) {
+                message += text;
+                message += "; ";
             }
-            throw std::invalid_argument(errorMsg);
+            return message;
         }
     }
+    return error.Message();
 }
 
-std::shared_ptr<Trade> TradeService::ConvertToTrade(const TradeDto& tradeDto) {
+std::shared_ptr<Trade> TradeService::ConvertToTrade(const TradeDto& tradeDto,
+                                                    std::chrono::system_clock::time_point settlementDate) {
     std::string tradeId = tradeDto.TradeId.empty() ? IdGenerator::GenerateTradeId() : tradeDto.TradeId;
     
-    auto trade = std::make_shared<Trade>(
-        tradeId,
-        tradeDto.AssetClass,
-        tradeDto.InstrumentId,
-        tradeDto.Counterparty,
-        tradeDto.Notional,
-        tradeDto.Currency,
-        tradeDto.Side,
-        tradeDto.TradeDate,
-        tradeDto.SettlementDate,
-        tradeDto.CreatedBy
-    );
+    auto create = [&](const auto& allocator) {
+        return std::allocate_shared<Trade>(
+            allocator,
+            tradeId,
+            tradeDto.AssetClass,
+            tradeDto.InstrumentId,
+            tradeDto.Counterparty,
+            tradeDto.Notional,
+            tradeDto.Currency,
+            tradeDto.Side,
+            tradeDto.TradeDate,
+            settlementDate,
+            tradeDto.CreatedBy
+        );
+    };
+    auto trade = m_tradeAllocation == TradeAllocation::Pooled
+        ? create(Memory::PoolAllocator<Trade>())
+        : create(std::allocator<Trade>());
+    if (m_limits) {
+        // Reserved right after conversion; let the rest of it hide the miss
+        m_limits->Prefetch(trade->GetCounterpartySymbol());
+    }
 
     if (!tradeDto.IdempotencyKey.empty()) {
         trade->SetIdempotencyKey(tradeDto.IdempotencyKey);
@@ -117,13 +549,30 @@ std::shared_ptr<Trade> TradeService::ConvertToTrade(const TradeDto& tradeDto) {
     }
 
     // Copy additional data
-    for (const auto& pair : tradeDto.Additional) {
-        trade->AddAdditionalData(pair.first, pair.second);
-    }
+    trade->SetAdditional(tradeDto.Additional);
 
     return trade;
 }
 
+// The DTO's settlement date, or one derived from the currency calendar with
+// a single registry lookup. False when that calendar cannot settle the trade.
+bool TradeService::SettlementDateFor(const TradeDto& tradeDto,
+                                     std::chrono::system_clock::time_point& settlementDate) const {
+    settlementDate = tradeDto.SettlementDate;
+    // A default-constructed date means the caller left it to us
+    if (!m_settlementCalendars || tradeDto.SettlementDate != std::chrono::system_clock::time_point()) {
+        return true;
+    }
+    auto calendar = m_settlementCalendars->Find(tradeDto.Currency);
+    const auto& settlementCalendar = calendar ? *calendar : Calendars::HolidayCalendar::WeekendsOnly();
+    if (!settlementCalendar.CanAddBusinessDays(Calendars::HolidayCalendar::ToDay(tradeDto.TradeDate),
+                                               m_settlementLag)) {
+        return false;
+    }
+    settlementDate = settlementCalendar.AddBusinessDays(tradeDto.TradeDate, m_settlementLag);
+    return true;
+}
+
 // C-style factory functions for console app
 extern "C" {
     TradeService* CreateTradeService(ITradeRepository* repository, IEventPublisher* eventPublisher) {
@@ -145,4 +594,41 @@ extern "C" {
             return nullptr;
         }
     }
+
+    // Returns a BookingErrorCode: 0 with *trade set when booked (or a
+    // duplicate), otherwise the rejection code, or 100 (Internal) if storage
+    // or publishing threw. When message is non-null the reason is copied
+    // into it, truncated and NUL-terminated.
+    int TryBookTradeC(TradeService* service, const TradeDto* tradeDto, Trade** trade,
+                      char* message, std::size_t messageSize) {
+        std::string reason;
+        BookingErrorCode code = BookingErrorCode::Internal;
+        if (trade) {
+            *trade = nullptr;
+        }
+        try {
+            auto outcome = service->TryBookTrade(*tradeDto);
+            code = outcome.Error.Code;
+            if (outcome.Succeeded() && trade) {
+                *trade = outcome.Trade.get();
+            }
+            if (message && messageSize > 0 && outcome.Error) {
+                reason = outcome.Error.Message();
+            }
+        } catch (const std::exception& ex) {
+            if (message && messageSize > 0) {
+                reason = ex.what();
+            }
+        } catch (...) {
+            if (message && messageSize > 0) {
+                reason = "Unknown booking failure";
+            }
+        }
+        if (message && messageSize > 0) {
+            std::size_t length = std::min(reason.size(), messageSize - 1);
+            std::memcpy(message, reason.data(), length);
+            message[length] = '\0';
+        }
+        return static_cast<int>(code);
+    }
 }
\ No newline at end of file
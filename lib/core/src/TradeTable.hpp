@@ -0,0 +1,284 @@
+#pragma once
+
+#include "../include/TradeBookEngine/Core/Trade.hpp"
+#include "../include/TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
+#include "../include/TradeBookEngine/Core/SymbolTable.hpp"
+#include "../include/TradeBookEngine/Core/Memory/SlabPool.hpp"
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace TradeBookEngine {
+namespace Core {
+namespace Storage {
+
+    // Hash map whose nodes come from the slab pool; the repositories use it
+    // for every per-trade entry so a save does not touch the global heap
+    template <typename Key, typename Value>
+    using PooledHashMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                             Memory::PoolAllocator<std::pair<const Key, Value>>>;
+
+    // Trades keyed by id plus secondary indexes on counterparty, instrument,
+    // asset class, status and settlement day. Every index bucket is a dense vector of entry
+    // pointers and each entry remembers its slot in every bucket, so adds and
+    // removes are O(1) and a lookup costs O(result size).
+    //
+    // Entries also sit in a slot vector that scans walk in bounded chunks.
+    // A trade keeps its slot until it is erased, so a scan that drops the
+    // lock between chunks visits every trade present throughout exactly once.
+    //
+    // Not synchronised: the owning repository guards it with its own lock.
+    class TradeTable {
+    private:
+        enum IndexSlot : std::size_t {
+            CounterpartySlot,
+            InstrumentSlot,
+            AssetClassSlot,
+            StatusSlot,
+            SettlementDaySlot,
+            IndexSlotCount
+        };
+
+        struct Entry {
+            std::shared_ptr<Models::Trade> trade;
+            // Status as indexed; the trade's own status may be changed behind our back
+            Enums::TradeStatus indexedStatus;
+            std::size_t slots[IndexSlotCount];
+            std::size_t scanSlot;
+        };
+
+        using Bucket = std::vector<Entry*>;
+
+        template <typename Key>
+        class SecondaryIndex {
+        private:
+            std::unordered_map<Key, Bucket> m_buckets;
+            IndexSlot m_slot;
+
+        public:
+            explicit SecondaryIndex(IndexSlot slot) : m_slot(slot) {}
+
+            void Add(const Key& key, Entry* entry) {
+                auto& bucket = m_buckets[key];
+                entry->slots[m_slot] = bucket.size();
+                bucket.push_back(entry);
+            }
+
+            void Remove(const Key& key, Entry* entry) {
+                auto it = m_buckets.find(key);
+                if (it == m_buckets.end()) {
+                    return;
+                }
+                auto& bucket = it->second;
+                std::size_t slot = entry->slots[m_slot];
+                Entry* last = bucket.back();
+                bucket[slot] = last;
+                last->slots[m_slot] = slot;
+                bucket.pop_back();
+                if (bucket.empty()) {
+                    m_buckets.erase(it);
+                }
+            }
+
+            void Collect(const Key& key, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+                auto it = m_buckets.find(key);
+                if (it == m_buckets.end()) {
+                    return;
+                }
+                out.reserve(out.size() + it->second.size());
+                for (const Entry* entry : it->second) {
+                    out.push_back(entry->trade);
+                }
+            }
+        };
+
+        PooledHashMap<std::string, Entry> m_entries;
+        // Scan order; erased slots are null until reused
+        std::vector<Entry*> m_scanSlots;
+        std::vector<std::size_t> m_freeScanSlots;
+        SecondaryIndex<Symbols::SymbolId> m_byCounterparty{CounterpartySlot};
+        SecondaryIndex<Symbols::SymbolId> m_byInstrument{InstrumentSlot};
+        SecondaryIndex<Enums::AssetClass> m_byAssetClass{AssetClassSlot};
+        SecondaryIndex<Enums::TradeStatus> m_byStatus{StatusSlot};
+        SecondaryIndex<Calendars::Day> m_bySettlementDay{SettlementDaySlot};
+
+        void Restatus(Entry* entry, Enums::TradeStatus status) {
+            if (entry->indexedStatus != status) {
+                m_byStatus.Remove(entry->indexedStatus, entry);
+                entry->indexedStatus = status;
+                m_byStatus.Add(status, entry);
+            }
+        }
+
+        void Index(Entry* entry) {
+            const auto& trade = *entry->trade;
+            entry->indexedStatus = trade.GetStatus();
+            m_byCounterparty.Add(trade.GetCounterpartySymbol(), entry);
+            m_byInstrument.Add(trade.GetInstrumentSymbol(), entry);
+            m_byAssetClass.Add(trade.GetAssetClass(), entry);
+            m_byStatus.Add(entry->indexedStatus, entry);
+            m_bySettlementDay.Add(Calendars::HolidayCalendar::ToDay(trade.GetSettlementDate()), entry);
+        }
+
+        void Unindex(Entry* entry) {
+            const auto& trade = *entry->trade;
+            m_byCounterparty.Remove(trade.GetCounterpartySymbol(), entry);
+            m_byInstrument.Remove(trade.GetInstrumentSymbol(), entry);
+            m_byAssetClass.Remove(trade.GetAssetClass(), entry);
+            m_byStatus.Remove(entry->indexedStatus, entry);
+            m_bySettlementDay.Remove(Calendars::HolidayCalendar::ToDay(trade.GetSettlementDate()), entry);
+        }
+
+    public:
+        enum class ScanState {
+            Paused,   // Budget used up; call again from the returned position
+            Finished, // Every slot has been visited
+            Stopped   // The visitor asked to stop
+        };
+
+        TradeTable() = default;
+        TradeTable(const TradeTable&) = delete;
+        TradeTable& operator=(const TradeTable&) = delete;
+
+        // Inserts or replaces by trade id; returns the replaced trade, if any
+        std::shared_ptr<Models::Trade> Upsert(const std::shared_ptr<Models::Trade>& trade) {
+            auto inserted = m_entries.try_emplace(trade->GetTradeId());
+            Entry* entry = &inserted.first->second;
+            std::shared_ptr<Models::Trade> replaced;
+            if (!inserted.second) {
+                Unindex(entry);
+                replaced = std::move(entry->trade);
+            } else if (!m_freeScanSlots.empty()) {
+                entry->scanSlot = m_freeScanSlots.back();
+                m_freeScanSlots.pop_back();
+                m_scanSlots[entry->scanSlot] = entry;
+            } else {
+                entry->scanSlot = m_scanSlots.size();
+                m_scanSlots.push_back(entry);
+            }
+            entry->trade = trade;
+            Index(entry);
+            return replaced;
+        }
+
+        // Removes by trade id; returns the removed trade, if any
+        std::shared_ptr<Models::Trade> Erase(const std::string& tradeId) {
+            auto it = m_entries.find(tradeId);
+            if (it == m_entries.end()) {
+                return nullptr;
+            }
+            Unindex(&it->second);
+            m_scanSlots[it->second.scanSlot] = nullptr;
+            m_freeScanSlots.push_back(it->second.scanSlot);
+            auto removed = std::move(it->second.trade);
+            m_entries.erase(it);
+            return removed;
+        }
+
+        std::shared_ptr<Models::Trade> Find(const std::string& tradeId) const {
+            auto it = m_entries.find(tradeId);
+            return it != m_entries.end() ? it->second.trade : nullptr;
+        }
+
+        bool Contains(const std::string& tradeId) const {
+            return m_entries.find(tradeId) != m_entries.end();
+        }
+
+        // Sets the trade's status and moves it between status buckets.
+        // Returns the trade, or nullptr if the id is unknown.
+        std::shared_ptr<Models::Trade> UpdateStatus(const std::string& tradeId, Enums::TradeStatus status,
+                                                    Enums::TradeStatus& previousStatus) {
+            auto it = m_entries.find(tradeId);
+            if (it == m_entries.end()) {
+                return nullptr;
+            }
+            Entry* entry = &it->second;
+            previousStatus = entry->indexedStatus;
+            entry->trade->SetStatus(status);
+            Restatus(entry, status);
+            return entry->trade;
+        }
+
+        // Moves the trade to status if rule allows it from its current status
+        // (any move when rule is null) and records the outcome. Compare-and-
+        // swaps, so a SetStatus made behind our back is never overwritten
+        // unchecked. Returns the trade, or nullptr if the id is unknown.
+        std::shared_ptr<Models::Trade> Transition(const std::string& tradeId, Enums::TradeStatus status,
+                                                  Interfaces::StatusTransitionRule rule,
+                                                  Interfaces::StatusTransition& result) {
+            auto it = m_entries.find(tradeId);
+            if (it == m_entries.end()) {
+                result.Outcome = Interfaces::TransitionOutcome::NotFound;
+                return nullptr;
+            }
+            Entry* entry = &it->second;
+            auto current = entry->trade->GetStatus();
+            do {
+                result.Previous = current;
+                if (current == status) {
+                    result.Outcome = Interfaces::TransitionOutcome::Unchanged;
+                    return entry->trade;
+                }
+                if (rule && !rule(current, status)) {
+                    result.Outcome = Interfaces::TransitionOutcome::Refused;
+                    return entry->trade;
+                }
+            } while (!entry->trade->CompareExchangeStatus(current, status));
+            result.Outcome = Interfaces::TransitionOutcome::Applied;
+            Restatus(entry, status);
+            return entry->trade;
+        }
+
+        std::size_t Size() const { return m_entries.size(); }
+
+        void CollectByCounterparty(Symbols::SymbolId counterparty, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            m_byCounterparty.Collect(counterparty, out);
+        }
+
+        void CollectByInstrument(Symbols::SymbolId instrumentId, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            m_byInstrument.Collect(instrumentId, out);
+        }
+
+        void CollectByAssetClass(Enums::AssetClass assetClass, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            m_byAssetClass.Collect(assetClass, out);
+        }
+
+        void CollectByStatus(Enums::TradeStatus status, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            m_byStatus.Collect(status, out);
+        }
+
+        void CollectBySettlementDay(Calendars::Day day, std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            m_bySettlementDay.Collect(day, out);
+        }
+
+        void CollectAll(std::vector<std::shared_ptr<Models::Trade>>& out) const {
+            out.reserve(out.size() + m_entries.size());
+            for (const Entry* entry : m_scanSlots) {
+                if (entry) {
+                    out.push_back(entry->trade);
+                }
+            }
+        }
+
+        // Calls visit(const Trade&) for stored trades from slot position
+        // onward, examining at most budget slots. visit returns false to
+        // stop. position is left at the first slot not yet examined.
+        template <typename Visit>
+        ScanState Scan(std::size_t& position, std::size_t budget, Visit&& visit) const {
+            std::size_t end = position + budget < m_scanSlots.size() ? position + budget : m_scanSlots.size();
+            while (position < end) {
+                const Entry* entry = m_scanSlots[position++];
+                if (entry && !visit(static_cast<const Models::Trade&>(*entry->trade))) {
+                    return ScanState::Stopped;
+                }
+            }
+            return position < m_scanSlots.size() ? ScanState::Paused : ScanState::Finished;
+        }
+    };
+
+} // namespace Storage
+} // namespace Core
+} // namespace TradeBookEngine
@@ -1,78 +1,346 @@
 #include "../include/TradeBookEngine/Core/Utils.hpp"
+#include "../include/TradeBookEngine/Core/Calendars/HolidayCalendar.hpp"
 #include "../include/TradeBookEngine/Core/Events/TradeBookedEvent.hpp"
-#include <sstream>
-#include <iomanip>
+#include <cstring>
+#include <ctime>
+#include <limits>
 #include <random>
-#include <set>
+#include <stdexcept>
 
 using namespace TradeBookEngine::Core::Utils;
 using namespace TradeBookEngine::Core::Events;
 
+// SnowflakeIdGenerator implementation
+namespace {
+    // 64 symbols in ascending ASCII order so encoded ids sort like the numbers
+    const char SortableAlphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz~";
+
+    std::uint64_t MillisecondsSinceEpoch() {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count()
+                    - SnowflakeIdGenerator::EpochMilliseconds;
+        return millis > 0 ? static_cast<std::uint64_t>(millis) : 0;
+    }
+
+    int SymbolValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+        if (c == '_') return 36;
+        if (c >= 'a' && c <= 'z') return c - 'a' + 37;
+        if (c == '~') return 63;
+        return -1;
+    }
+
+    std::string PrefixedId(const char (&prefix)[5]) {
+        std::string id(4 + SnowflakeIdGenerator::EncodedLength, '\0');
+        id.replace(0, 4, prefix, 4);
+        SnowflakeIdGenerator::Encode(SnowflakeIdGenerator::Default().Next(), &id[4]);
+        return id;
+    }
+}
+
+SnowflakeIdGenerator::SnowflakeIdGenerator(std::uint16_t nodeId)
+    : m_state(0)
+    , m_nodeBits(0) {
+    SetNodeId(nodeId);
+}
+
+void SnowflakeIdGenerator::SetNodeId(std::uint16_t nodeId) {
+    m_nodeBits.store(static_cast<std::uint64_t>(nodeId & MaxNodeId) << SequenceBits, std::memory_order_relaxed);
+}
+
+std::uint64_t SnowflakeIdGenerator::Next() {
+    const std::uint64_t sequenceMask = (1u << SequenceBits) - 1;
+    std::uint64_t now = MillisecondsSinceEpoch();
+    std::uint64_t state = m_state.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        // A new millisecond restarts the sequence; otherwise (same
+        // millisecond, or the clock stepped back) keep counting from the last id
+        next = (now > (state >> SequenceBits)) ? (now << SequenceBits) : state + 1;
+    } while (!m_state.compare_exchange_weak(state, next, std::memory_order_relaxed));
+
+    std::uint64_t millis = next >> SequenceBits;
+    return (millis << (NodeBits + SequenceBits))
+         | m_nodeBits.load(std::memory_order_relaxed)
+         | (next & sequenceMask);
+}
+
+void SnowflakeIdGenerator::Encode(std::uint64_t id, char* out) {
+    for (std::size_t i = EncodedLength; i-- > 0;) {
+        out[i] = SortableAlphabet[id & 0x3F];
+        id >>= 6;
+    }
+}
+
+bool SnowflakeIdGenerator::Decode(const char* text, std::size_t length, std::uint64_t& id) {
+    if (length != EncodedLength || SymbolValue(text[0]) > 0xF) {
+        return false;
+    }
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        int symbol = SymbolValue(text[i]);
+        if (symbol < 0) {
+            return false;
+        }
+        value = (value << 6) | static_cast<std::uint64_t>(symbol);
+    }
+    id = value;
+    return true;
+}
+
+std::chrono::system_clock::time_point SnowflakeIdGenerator::TimestampOf(std::uint64_t id) {
+    auto millis = static_cast<std::int64_t>(id >> (NodeBits + SequenceBits)) + EpochMilliseconds;
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(millis)));
+}
+
+SnowflakeIdGenerator& SnowflakeIdGenerator::Default() {
+    static SnowflakeIdGenerator generator;
+    return generator;
+}
+
 // IdGenerator implementation
 std::string IdGenerator::GenerateTradeId() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(100000, 999999);
-    
-    auto now = std::chrono::system_clock::now();
-    auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-    
-    return "TRD-" + std::to_string(timestamp) + "-" + std::to_string(dis(gen));
+    return PrefixedId("TRD-");
+}
+
+std::string IdGenerator::GenerateEventId() {
+    return PrefixedId("EVT-");
 }
 
 std::string IdGenerator::GenerateCorrelationId() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(100000, 999999);
+    // Per-thread engine: a shared std::mt19937 is not safe to call concurrently
+    thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(100000, 999999);
     
     return "CORR-" + std::to_string(dis(gen));
 }
 
 // DateTimeUtils implementation
+
+// H. Hinnant's days_from_civil and civil_from_days
+std::int64_t DateTimeUtils::DaysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+}
+
+void DateTimeUtils::CivilFromDays(std::int64_t days, std::int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+unsigned DateTimeUtils::DaysInMonth(std::int64_t year, unsigned month) {
+    static const unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+namespace {
+    std::int64_t FloorDiv(std::int64_t value, std::int64_t divisor) {
+        std::int64_t quotient = value / divisor;
+        return quotient - ((value % divisor != 0) && ((value < 0) != (divisor < 0)));
+    }
+
+    void PutDigits(char* out, std::uint32_t value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    // Reads exactly width digits; false if any is not a digit
+    bool GetDigits(const char* text, int width, unsigned& value) {
+        value = 0;
+        for (int i = 0; i < width; ++i) {
+            auto digit = static_cast<unsigned>(text[i] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    // Timestamps on import and export arrive in runs from the same day, so
+    // each thread remembers its last date in both directions
+    struct CivilDateCache {
+        std::int64_t FormatDay = std::numeric_limits<std::int64_t>::min();
+        char FormatText[10] = {};
+        char ParseText[10] = {};
+        bool ParseValid = false;
+        std::int64_t ParseDay = 0;
+    };
+
+    thread_local CivilDateCache t_dateCache;
+} // namespace
+
+std::size_t DateTimeUtils::FormatIso8601(const std::chrono::system_clock::time_point& timePoint,
+                                         char* buffer, std::size_t size, TimestampPrecision precision) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timePoint.time_since_epoch()).count();
+    std::int64_t seconds = FloorDiv(micros, 1000000);
+    auto fraction = static_cast<std::uint32_t>(micros - seconds * 1000000);
+    std::int64_t days = FloorDiv(seconds, 86400);
+    auto secondOfDay = static_cast<std::uint32_t>(seconds - days * 86400);
+
+    std::size_t fractionDigits = precision == TimestampPrecision::Milliseconds ? 3
+                               : precision == TimestampPrecision::Microseconds ? 6 : 0;
+    std::size_t length = 20 + (fractionDigits ? fractionDigits + 1 : 0);
+    if (size < length + 1) {
+        return 0;
+    }
+
+    CivilDateCache& cache = t_dateCache;
+    if (days != cache.FormatDay) {
+        std::int64_t year;
+        unsigned month;
+        unsigned day;
+        DateTimeUtils::CivilFromDays(days, year, month, day);
+        if (year < 0 || year > 9999) {
+            return 0;
+        }
+        PutDigits(cache.FormatText, static_cast<std::uint32_t>(year), 4);
+        cache.FormatText[4] = '-';
+        PutDigits(cache.FormatText + 5, month, 2);
+        cache.FormatText[7] = '-';
+        PutDigits(cache.FormatText + 8, day, 2);
+        cache.FormatDay = days;
+    }
+
+    std::memcpy(buffer, cache.FormatText, 10);
+    buffer[10] = 'T';
+    PutDigits(buffer + 11, secondOfDay / 3600, 2);
+    buffer[13] = ':';
+    PutDigits(buffer + 14, secondOfDay / 60 % 60, 2);
+    buffer[16] = ':';
+    PutDigits(buffer + 17, secondOfDay % 60, 2);
+    char* tail = buffer + 19;
+    if (fractionDigits == 3) {
+        *tail = '.';
+        PutDigits(tail + 1, fraction / 1000, 3);
+        tail += 4;
+    } else if (fractionDigits == 6) {
+        *tail = '.';
+        PutDigits(tail + 1, fraction, 6);
+        tail += 7;
+    }
+    tail[0] = 'Z';
+    tail[1] = '\0';
+    return length;
+}
+
+bool DateTimeUtils::ParseIso8601(const char* text, std::size_t length,
+                                 std::chrono::system_clock::time_point& timePoint) {
+    if (length < 20 || text[4] != '-' || text[7] != '-' || (text[10] != 'T' && text[10] != 't') ||
+        text[13] != ':' || text[16] != ':') {
+        return false;
+    }
+
+    CivilDateCache& cache = t_dateCache;
+    std::int64_t days;
+    if (cache.ParseValid && std::memcmp(cache.ParseText, text, 10) == 0) {
+        days = cache.ParseDay;
+    } else {
+        unsigned year;
+        unsigned month;
+        unsigned day;
+        if (!GetDigits(text, 4, year) || !GetDigits(text + 5, 2, month) || !GetDigits(text + 8, 2, day) ||
+            month < 1 || month > 12 || day < 1 || day > DateTimeUtils::DaysInMonth(year, month)) {
+            return false;
+        }
+        days = DateTimeUtils::DaysFromCivil(year, month, day);
+        std::memcpy(cache.ParseText, text, 10);
+        cache.ParseDay = days;
+        cache.ParseValid = true;
+    }
+
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+    if (!GetDigits(text + 11, 2, hour) || !GetDigits(text + 14, 2, minute) || !GetDigits(text + 17, 2, second) ||
+        hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    std::size_t position = 19;
+    std::int64_t nanos = 0;
+    if (text[position] == '.') {
+        ++position;
+        std::size_t digits = 0;
+        while (position < length && static_cast<unsigned>(text[position] - '0') <= 9) {
+            if (digits < 9) {
+                nanos = nanos * 10 + (text[position] - '0');
+            }
+            ++digits;
+            ++position;
+        }
+        if (digits == 0 || digits > 9) {
+            return false;
+        }
+        for (std::size_t i = digits; i < 9; ++i) {
+            nanos *= 10;
+        }
+    }
+
+    std::int64_t offsetSeconds = 0;
+    if (position + 1 == length && (text[position] == 'Z' || text[position] == 'z')) {
+        position = length;
+    } else if (position + 6 == length && (text[position] == '+' || text[position] == '-') && text[position + 3] == ':') {
+        unsigned offsetHours;
+        unsigned offsetMinutes;
+        if (!GetDigits(text + position + 1, 2, offsetHours) || !GetDigits(text + position + 4, 2, offsetMinutes) ||
+            offsetHours > 23 || offsetMinutes > 59) {
+            return false;
+        }
+        offsetSeconds = (text[position] == '+' ? 1 : -1) * static_cast<std::int64_t>(offsetHours * 3600 + offsetMinutes * 60);
+    } else {
+        return false;
+    }
+
+    std::int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second - offsetSeconds;
+    auto sinceEpoch = std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanos);
+    timePoint = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch));
+    return true;
+}
+
 std::string DateTimeUtils::ToString(const std::chrono::system_clock::time_point& timePoint) {
-    auto time_t = std::chrono::system_clock::to_time_t(timePoint);
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
-    return ss.str();
+    char buffer[MaxIso8601Length];
+    std::size_t length = FormatIso8601(timePoint, buffer, sizeof(buffer));
+    if (length == 0) {
+        throw std::out_of_range("Timestamp year outside 0000-9999");
+    }
+    return std::string(buffer, length);
 }
 
 std::chrono::system_clock::time_point DateTimeUtils::FromString(const std::string& timeStr) {
-    std::tm tm = {};
-    std::stringstream ss(timeStr);
-    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    
-    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    std::chrono::system_clock::time_point timePoint;
+    if (!ParseIso8601(timeStr.data(), timeStr.size(), timePoint)) {
+        throw std::invalid_argument("Invalid ISO-8601 timestamp: " + timeStr);
+    }
+    return timePoint;
 }
 
 std::chrono::system_clock::time_point DateTimeUtils::AddBusinessDays(
     const std::chrono::system_clock::time_point& startDate, 
     int businessDays) {
-    
-    auto current = startDate;
-    int daysAdded = 0;
-    
-    while (daysAdded < businessDays) {
-        current += std::chrono::hours(24);
-        
-        auto time_t = std::chrono::system_clock::to_time_t(current);
-        auto tm = *std::localtime(&time_t);
-        
-        // Skip weekends (Saturday = 6, Sunday = 0)
-        if (tm.tm_wday != 0 && tm.tm_wday != 6) {
-            daysAdded++;
-        }
-    }
-    
-    return current;
+    return TradeBookEngine::Core::Calendars::HolidayCalendar::WeekendsOnly().AddBusinessDays(startDate, businessDays);
 }
 
 // ValidationUtils implementation
 bool ValidationUtils::IsValidCurrency(const std::string& currency) {
-    static std::set<std::string> validCurrencies = {
-        "USD", "EUR", "GBP", "JPY", "CHF", "CAD", "AUD", "NZD", "SEK", "NOK", "DKK"
-    };
-    
-    return validCurrencies.find(currency) != validCurrencies.end();
+    return Models::CurrencyCode(currency).IsIso4217();
 }
 
 bool ValidationUtils::IsValidNotional(double notional) {
@@ -89,8 +357,8 @@ bool ValidationUtils::IsValidInstrumentId(const std::string& instrumentId) {
 
 // TradeBookedEvent implementation
 TradeBookedEvent::TradeBookedEvent(std::shared_ptr<Models::Trade> trade, const std::string& correlationId)
-    : m_trade(trade)
+    : m_trade(std::move(trade))
     , m_timestamp(std::chrono::system_clock::now())
-    , m_eventId(IdGenerator::GenerateCorrelationId())
-    , m_correlationId(correlationId.empty() ? trade->GetCorrelationId() : correlationId) {
+    , m_eventId(IdGenerator::GenerateEventId())
+    , m_correlationId(correlationId.empty() ? m_trade->GetCorrelationId() : correlationId) {
 }
\ No newline at end of file
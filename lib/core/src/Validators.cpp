@@ -12,27 +12,46 @@ using namespace TradeBookEngine::Core::Utils;
 class EquityValidator : public IAssetValidator {
 public:
     bool IsValid(const TradeDto& tradeDto) const override {
-        return GetValidationErrors(tradeDto).empty();
+        return Check(tradeDto) == ValidationError::None;
     }
 
-    std::vector<std::string> GetValidationErrors(const TradeDto& tradeDto) const override {
-        std::vector<std::string> errors;
+    ValidationErrorMask Check(const TradeDto& tradeDto) const override {
+        ValidationErrorMask errors = ValidationError::None;
 
         if (tradeDto.AssetClass != AssetClass::Equity) {
-            errors.push_back("Invalid asset class for equity validator");
+            errors |= ValidationError::WrongAssetClass;
         }
 
         if (!ValidationUtils::IsValidInstrumentId(tradeDto.InstrumentId)) {
-            errors.push_back("Invalid instrument ID for equity");
+            errors |= ValidationError::InvalidInstrumentId;
         }
 
         if (!ValidationUtils::IsValidNotional(tradeDto.Notional)) {
-            errors.push_back("Invalid notional amount");
+            errors |= ValidationError::InvalidNotional;
         }
 
         // Check for required additional fields for equity
-        auto it = tradeDto.Additional.find("Exchange");
-        if (it == tradeDto.Additional.end() || it->second.empty()) {
+        if (tradeDto.Additional.Exchange().empty()) {
+            errors |= ValidationError::MissingExchange;
+        }
+
+        return errors;
+    }
+
+    std::vector<std::string> GetValidationErrors(const TradeDto& tradeDto) const override {
+        std::vector<std::string> errors;
+        ValidationErrorMask mask = Check(tradeDto);
+
+        if (mask & ValidationError::WrongAssetClass) {
+            errors.push_back("Invalid asset class for equity validator");
+        }
+        if (mask & ValidationError::InvalidInstrumentId) {
+            errors.push_back("Invalid instrument ID for equity");
+        }
+        if (mask & ValidationError::InvalidNotional) {
+            errors.push_back("Invalid notional amount");
+        }
+        if (mask & ValidationError::MissingExchange) {
             errors.push_back("Exchange is required for equity trades");
         }
 
@@ -47,32 +66,53 @@ public:
 class BondValidator : public IAssetValidator {
 public:
     bool IsValid(const TradeDto& tradeDto) const override {
-        return GetValidationErrors(tradeDto).empty();
+        return Check(tradeDto) == ValidationError::None;
     }
 
-    std::vector<std::string> GetValidationErrors(const TradeDto& tradeDto) const override {
-        std::vector<std::string> errors;
+    ValidationErrorMask Check(const TradeDto& tradeDto) const override {
+        ValidationErrorMask errors = ValidationError::None;
 
         if (tradeDto.AssetClass != AssetClass::Bond) {
-            errors.push_back("Invalid asset class for bond validator");
+            errors |= ValidationError::WrongAssetClass;
         }
 
         if (!ValidationUtils::IsValidInstrumentId(tradeDto.InstrumentId)) {
-            errors.push_back("Invalid instrument ID for bond");
+            errors |= ValidationError::InvalidInstrumentId;
         }
 
         if (!ValidationUtils::IsValidNotional(tradeDto.Notional)) {
-            errors.push_back("Invalid notional amount");
+            errors |= ValidationError::InvalidNotional;
         }
 
         // Check for required additional fields for bonds
-        auto maturityIt = tradeDto.Additional.find("MaturityDate");
-        if (maturityIt == tradeDto.Additional.end() || maturityIt->second.empty()) {
-            errors.push_back("MaturityDate is required for bond trades");
+        if (tradeDto.Additional.MaturityDate().empty()) {
+            errors |= ValidationError::MissingMaturityDate;
+        }
+
+        if (tradeDto.Additional.CreditRating().empty()) {
+            errors |= ValidationError::MissingCreditRating;
         }
 
-        auto ratingIt = tradeDto.Additional.find("CreditRating");
-        if (ratingIt == tradeDto.Additional.end() || ratingIt->second.empty()) {
+        return errors;
+    }
+
+    std::vector<std::string> GetValidationErrors(const TradeDto& tradeDto) const override {
+        std::vector<std::string> errors;
+        ValidationErrorMask mask = Check(tradeDto);
+
+        if (mask & ValidationError::WrongAssetClass) {
+            errors.push_back("Invalid asset class for bond validator");
+        }
+        if (mask & ValidationError::InvalidInstrumentId) {
+            errors.push_back("Invalid instrument ID for bond");
+        }
+        if (mask & ValidationError::InvalidNotional) {
+            errors.push_back("Invalid notional amount");
+        }
+        if (mask & ValidationError::MissingMaturityDate) {
+            errors.push_back("MaturityDate is required for bond trades");
+        }
+        if (mask & ValidationError::MissingCreditRating) {
             errors.push_back("CreditRating is required for bond trades");
         }
 
@@ -97,4 +137,4 @@ extern "C" {
     void DestroyValidator(IAssetValidator* validator) {
         delete validator;
     }
-}
\ No newline at end of file
+}
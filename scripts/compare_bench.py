@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Compare two tradebook_bench --json result files.
+
+Usage: scripts/compare_bench.py baseline.json candidate.json [--threshold 10]
+
+Prints every figure present in both files with its change, and exits with
+status 1 if any figure got worse by more than the threshold (in percent).
+Each result says whether higher or lower values are better.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    return {(r["benchmark"], r["name"]): r for r in data["results"]}, data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent regression that fails the comparison (default 10)")
+    args = parser.parse_args()
+
+    baseline, baseline_meta = load(args.baseline)
+    candidate, candidate_meta = load(args.candidate)
+    if baseline_meta.get("hardware_threads") != candidate_meta.get("hardware_threads"):
+        print("warning: runs used different hardware thread counts", file=sys.stderr)
+
+    regressions = 0
+    for key in sorted(baseline.keys() & candidate.keys()):
+        old, new = baseline[key]["value"], candidate[key]["value"]
+        if old == 0:
+            continue
+        change = (new - old) / abs(old) * 100.0
+        worse = -change if baseline[key]["better"] == "higher" else change
+        flag = ""
+        if worse > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{key[0]:<24} {key[1]:<48} {old:>14.1f} {new:>14.1f} {change:>+8.1f}% {baseline[key]['unit']}{flag}")
+
+    missing = sorted(baseline.keys() - candidate.keys())
+    for key in missing:
+        print(f"{key[0]:<24} {key[1]:<48} missing from candidate")
+
+    print(f"\n{regressions} regression(s) beyond {args.threshold:.0f}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,13 +3,43 @@
 #include <stdexcept>
 #include <string>
 #include <chrono>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <csignal>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 #include "TradeBookEngine/Core/TradeService.hpp"
+#include "TradeBookEngine/Core/BookingEngine.hpp"
 #include "TradeBookEngine/Core/Validators/IAssetValidator.hpp"
 #include "TradeBookEngine/Core/Interfaces/ITradeRepository.hpp"
 #include "TradeBookEngine/Core/Interfaces/IEventPublisher.hpp"
+#include "TradeBookEngine/Core/Publishers/AsyncEventPublisher.hpp"
+#include "TradeBookEngine/Core/Analytics/ColumnarTradeStore.hpp"
+#include "TradeBookEngine/Core/Analytics/PositionKeeper.hpp"
+#include "TradeBookEngine/Core/Risk/CounterpartyLimits.hpp"
+#include "TradeBookEngine/Core/Memory/SlabPool.hpp"
+#include "TradeBookEngine/Core/SymbolTable.hpp"
+#include "TradeBookEngine/Core/Repositories/JournalTradeRepository.hpp"
+#include "TradeBookEngine/Core/Repositories/SnapshotTradeRepository.hpp"
+#include "TradeBookEngine/Core/Calendars/HolidayCalendar.hpp"
 #include "TradeBookEngine/Core/TradeDto.hpp"
 #include "TradeBookEngine/Core/Enums.hpp"
+#include "TradeBookEngine/Core/Utils.hpp"
 
 using namespace TradeBookEngine::Core;
 using namespace TradeBookEngine::Core::Services;
@@ -22,11 +52,15 @@ using namespace TradeBookEngine::Core::Enums;
 extern "C" {
     ITradeRepository* CreateInMemoryTradeRepository();
     void DestroyInMemoryTradeRepository(ITradeRepository*);
+    ITradeRepository* CreateShardedTradeRepository(std::size_t shardCount);
+    void DestroyShardedTradeRepository(ITradeRepository*);
     IEventPublisher* CreateNoOpEventPublisher();
     void DestroyNoOpEventPublisher(IEventPublisher*);
     IAssetValidator* CreateEquityValidator();
     IAssetValidator* CreateBondValidator();
     void DestroyValidator(IAssetValidator*);
+    int TryBookTradeC(TradeService* service, const TradeDto* tradeDto, Trade** trade,
+                      char* message, std::size_t messageSize);
 }
 
 struct TestContext {
@@ -124,11 +158,1908 @@ void test_validation_failure() {
     CHECK(threw, "Invalid notional throws invalid_argument");
 }
 
+void test_book_trades_batch() {
+    TestContext ctx;
+    auto existing = ctx.service->BookTrade(MakeValidEquityDto());
+
+    std::vector<TradeDto> batch;
+    auto fresh = MakeValidEquityDto();
+    fresh.IdempotencyKey = "idem-batch-1";
+    batch.push_back(fresh);                 // new trade
+    batch.push_back(MakeValidEquityDto());  // key already booked
+    auto invalid = MakeValidEquityDto();
+    invalid.IdempotencyKey = "idem-batch-2";
+    invalid.Notional = 0.0;
+    batch.push_back(invalid);               // rejected
+    batch.push_back(fresh);                 // repeats a key within the batch
+
+    auto results = ctx.service->BookTrades(batch);
+
+    CHECK(results.size() == batch.size(), "BookTrades returns one result per input");
+    CHECK(results[0].Status == BookingStatus::Booked && results[0].Trade != nullptr,
+          "Batch books a new trade");
+    CHECK(results[1].Status == BookingStatus::Duplicate &&
+          results[1].Trade->GetTradeId() == existing->GetTradeId(),
+          "Batch resolves an existing idempotency key");
+    CHECK(results[2].Status == BookingStatus::Rejected && !results[2].Error.empty(),
+          "Batch reports an invalid trade without throwing");
+    CHECK(results[3].Status == BookingStatus::Duplicate &&
+          results[3].Trade->GetTradeId() == results[0].Trade->GetTradeId(),
+          "Batch deduplicates keys within the batch");
+    CHECK(ctx.service->GetAllTrades().size() == 2, "Batch saved only the new trade");
+}
+
+void test_sharded_repository_concurrent_access() {
+    auto repo = std::shared_ptr<ITradeRepository>(
+        CreateShardedTradeRepository(8),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); }
+    );
+
+    const int writers = 4;
+    const int tradesPerWriter = 500;
+    std::atomic<int> missing{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&repo, &missing, w]() {
+            for (int i = 0; i < tradesPerWriter; ++i) {
+                auto id = "T-" + std::to_string(w) + "-" + std::to_string(i);
+                auto trade = std::make_shared<Trade>(id, AssetClass::Equity, "AAPL",
+                    "CP-" + std::to_string(w), 100.0, "USD", TradeSide::Buy,
+                    std::chrono::system_clock::now(), std::chrono::system_clock::now(), "tester");
+                trade->SetIdempotencyKey("K-" + id);
+                repo->Save(trade);
+                if (!repo->GetById(id) || !repo->GetByIdempotencyKey("K-" + id)) {
+                    ++missing;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(missing.load() == 0, "Sharded repository reads its own concurrent writes");
+    CHECK(repo->GetAll().size() == static_cast<std::size_t>(writers * tradesPerWriter),
+          "Sharded repository holds every saved trade");
+    CHECK(repo->GetByCounterparty("CP-2").size() == static_cast<std::size_t>(tradesPerWriter),
+          "Sharded repository filters by counterparty across shards");
+
+    repo->Delete("T-0-0");
+    CHECK(!repo->Exists("T-0-0") && !repo->GetByIdempotencyKey("K-T-0-0"),
+          "Sharded repository delete removes id and idempotency key");
+}
+
+void test_secondary_index_queries() {
+    auto check = [](const std::shared_ptr<ITradeRepository>& repo, const std::string& name) {
+        auto service = std::make_unique<TradeService>(repo, std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+
+        auto equity = MakeValidEquityDto();
+        auto msft = MakeValidEquityDto();
+        msft.IdempotencyKey = "idem-msft";
+        msft.InstrumentId = "MSFT";
+        msft.Counterparty = "Counterparty2";
+        auto bond = MakeValidEquityDto();
+        bond.IdempotencyKey = "idem-bond";
+        bond.AssetClass = AssetClass::Bond;
+        bond.InstrumentId = "US10Y";
+
+        auto equityTrade = service->BookTrade(equity);
+        service->BookTrade(msft);
+        service->BookTrade(bond);
+
+        CHECK(service->GetTradesByCounterparty("Counterparty1").size() == 2, name + ": counterparty index");
+        CHECK(service->GetTradesByInstrument("MSFT").size() == 1, name + ": instrument index");
+        CHECK(service->GetTradesByAssetClass(AssetClass::Bond).size() == 1, name + ": asset class index");
+        CHECK(service->GetTradesByStatus(TradeStatus::Booked).size() == 3, name + ": status index");
+
+        repo->UpdateStatus(equityTrade->GetTradeId(), TradeStatus::Settled);
+        CHECK(service->GetTradesByStatus(TradeStatus::Settled).size() == 1 &&
+              service->GetTradesByStatus(TradeStatus::Booked).size() == 2,
+              name + ": status index follows UpdateStatus");
+
+        repo->Delete(equityTrade->GetTradeId());
+        CHECK(service->GetTradesByCounterparty("Counterparty1").size() == 1 &&
+              service->GetTradesByInstrument("AAPL").empty() &&
+              service->GetTradesByStatus(TradeStatus::Settled).empty(),
+              name + ": delete removes index entries");
+    };
+
+    check(std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(),
+        [](ITradeRepository* p){ DestroyInMemoryTradeRepository(p); }), "InMemory");
+    check(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); }), "Sharded");
+}
+
+void test_concurrent_idempotent_submissions() {
+    auto check = [](const std::shared_ptr<ITradeRepository>& repo, const std::string& name) {
+        auto publisher = std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); });
+        TradeService service(repo, publisher);
+
+        const int threadCount = 8;
+        std::vector<std::string> tradeIds(threadCount);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&service, &tradeIds, t]() {
+                auto dto = MakeValidEquityDto();
+                dto.IdempotencyKey = "idem-race";
+                tradeIds[static_cast<std::size_t>(t)] = service.BookTrade(dto)->GetTradeId();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        bool allSame = true;
+        for (const auto& id : tradeIds) {
+            allSame = allSame && id == tradeIds[0];
+        }
+        CHECK(allSame, name + ": concurrent retries return the same trade");
+        CHECK(repo->GetAll().size() == 1, name + ": concurrent retries book one trade");
+
+        // A rejected submission gives its key back
+        auto invalid = MakeValidEquityDto();
+        invalid.IdempotencyKey = "idem-retry";
+        invalid.Notional = -1.0;
+        auto rejected = service.BookTrades(std::vector<TradeDto>{invalid});
+        auto valid = MakeValidEquityDto();
+        valid.IdempotencyKey = "idem-retry";
+        auto booked = service.BookTrade(valid);
+        CHECK(rejected[0].Status == BookingStatus::Rejected && booked != nullptr &&
+              repo->GetByIdempotencyKey("idem-retry") == booked,
+              name + ": key is reusable after a rejected booking");
+    };
+
+    check(std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(),
+        [](ITradeRepository* p){ DestroyInMemoryTradeRepository(p); }), "InMemory");
+    check(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); }), "Sharded");
+}
+
+class CountingEventPublisher : public IEventPublisher {
+public:
+    std::atomic<int> published{0};
+    std::atomic<bool> gateOpen{true};
+
+    void Publish(const Events::TradeBookedEvent&) override {
+        while (!gateOpen.load()) {
+            std::this_thread::yield();
+        }
+        ++published;
+    }
+};
+
+void test_async_event_publisher() {
+    auto makeEvent = []() {
+        auto now = std::chrono::system_clock::now();
+        return Events::TradeBookedEvent(std::make_shared<Trade>("T-1", AssetClass::Equity, "AAPL",
+            "CP", 1.0, "USD", TradeSide::Buy, now, now, "tester"), "corr");
+    };
+
+    {
+        auto inner = std::make_shared<CountingEventPublisher>();
+        Publishers::AsyncEventPublisher async(inner, 64);
+        std::vector<std::thread> producers;
+        for (int p = 0; p < 4; ++p) {
+            producers.emplace_back([&async, &makeEvent]() {
+                for (int i = 0; i < 1000; ++i) {
+                    async.Publish(makeEvent());
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        async.Flush();
+        auto stats = async.GetStats();
+        CHECK(inner->published.load() == 4000 && stats.Published == 4000 && stats.Dropped == 0,
+              "AsyncEventPublisher delivers every event under Block policy");
+    }
+
+    {
+        auto inner = std::make_shared<CountingEventPublisher>();
+        inner->gateOpen = false;
+        Publishers::AsyncEventPublisher async(inner, 8, Publishers::BackpressurePolicy::DropOldest, 1);
+        for (int i = 0; i < 100; ++i) {
+            async.Publish(makeEvent());
+        }
+        auto stats = async.GetStats();
+        inner->gateOpen = true;
+        async.Flush();
+        CHECK(stats.Dropped > 0 && stats.QueueDepth <= stats.Capacity,
+              "AsyncEventPublisher drops oldest events when full");
+    }
+
+    {
+        auto inner = std::make_shared<CountingEventPublisher>();
+        inner->gateOpen = false;
+        Publishers::AsyncEventPublisher async(inner, 8, Publishers::BackpressurePolicy::FailFast, 1);
+        bool threw = false;
+        try {
+            for (int i = 0; i < 100; ++i) {
+                async.Publish(makeEvent());
+            }
+        } catch (const Publishers::EventQueueFullError&) {
+            threw = true;
+        }
+        auto stats = async.GetStats();
+        inner->gateOpen = true;
+        async.Flush();
+        CHECK(threw && stats.Rejected == 1, "AsyncEventPublisher fails fast when full");
+    }
+}
+
+void test_snowflake_ids_unique_and_ordered() {
+    const int threadCount = 4;
+    const int idsPerThread = 20000;
+    std::vector<std::vector<std::string>> perThread(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&perThread, t]() {
+            auto& ids = perThread[static_cast<std::size_t>(t)];
+            ids.reserve(idsPerThread);
+            for (int i = 0; i < idsPerThread; ++i) {
+                ids.push_back(Utils::IdGenerator::GenerateTradeId());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> unique;
+    bool ordered = true;
+    for (const auto& ids : perThread) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            unique.insert(ids[i]);
+            ordered = ordered && (i == 0 || ids[i - 1] < ids[i]);
+        }
+    }
+    CHECK(unique.size() == static_cast<std::size_t>(threadCount * idsPerThread),
+          "Snowflake trade ids are unique across threads");
+    CHECK(ordered, "Snowflake trade ids sort by generation order");
+
+    const auto& sample = perThread[0][0];
+    std::uint64_t decoded = 0;
+    bool roundTrip = sample.size() == 15 && sample.compare(0, 4, "TRD-") == 0 &&
+        Utils::SnowflakeIdGenerator::Decode(sample.data() + 4, sample.size() - 4, decoded);
+    auto age = std::chrono::system_clock::now() - Utils::SnowflakeIdGenerator::TimestampOf(decoded);
+    CHECK(roundTrip && age >= std::chrono::seconds(0) && age < std::chrono::minutes(1),
+          "Snowflake trade id decodes to its booking time");
+}
+
+void test_symbol_table() {
+    using namespace Symbols;
+    auto& table = SymbolTable::Instance();
+    CHECK(table.Resolve(EmptySymbol).empty() && table.Resolve(WellKnown::Exchange) == "Exchange" &&
+          table.Resolve(WellKnown::MaturityDate) == "MaturityDate" &&
+          table.Resolve(WellKnown::CreditRating) == "CreditRating" && Intern("") == EmptySymbol &&
+          Intern("Exchange") == WellKnown::Exchange, "Empty and well-known symbols have fixed ids");
+
+    SymbolId first = Intern("symbol-test-AAPL");
+    SymbolId again = Intern(std::string("symbol-test-") + "AAPL");
+    SymbolId other = Intern("symbol-test-MSFT");
+    CHECK(first == again && first != other && Resolve(first) == "symbol-test-AAPL" &&
+          Resolve(other) == "symbol-test-MSFT", "Intern gives equal text one id and Resolve returns it");
+
+    std::size_t size = table.Size();
+    SymbolId found = 0;
+    bool missing = !table.Find("symbol-test-never-interned", found);
+    CHECK(missing && table.Size() == size && table.Find("symbol-test-MSFT", found) && found == other,
+          "Find looks symbols up without interning");
+
+    // Threads racing to intern the same new strings agree on every id
+    const int threadCount = 4;
+    const int perThread = 2000;
+    std::vector<std::vector<SymbolId>> ids(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&ids, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                ids[static_cast<std::size_t>(t)].push_back(Intern("symbol-race-" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    bool agree = true;
+    std::set<SymbolId> distinct;
+    for (int i = 0; i < perThread; ++i) {
+        SymbolId id = ids[0][static_cast<std::size_t>(i)];
+        distinct.insert(id);
+        for (int t = 1; t < threadCount; ++t) {
+            agree = agree && ids[static_cast<std::size_t>(t)][static_cast<std::size_t>(i)] == id;
+        }
+        agree = agree && Resolve(id) == "symbol-race-" + std::to_string(i);
+    }
+    CHECK(agree && distinct.size() == static_cast<std::size_t>(perThread),
+          "Concurrent interning gives every thread the same ids");
+
+    auto trade = std::make_shared<Trade>("T-SYM", AssetClass::Equity, "symbol-test-AAPL", "symbol-test-CP", 1.0,
+        "USD", TradeSide::Buy, std::chrono::system_clock::now(), std::chrono::system_clock::now(), "tester");
+    CHECK(trade->GetInstrumentSymbol() == first && trade->GetInstrumentId() == "symbol-test-AAPL" &&
+          Resolve(trade->GetCounterpartySymbol()) == "symbol-test-CP" && trade->GetCurrencySymbol() == Intern("USD"),
+          "Trades store interned symbols for their repeated fields");
+}
+
+void test_columnar_store_tracks_repository() {
+    auto check = [](const std::shared_ptr<ITradeRepository>& repo, const std::string& name) {
+        auto store = std::make_shared<Analytics::ColumnarTradeStore>();
+        repo->AddListener(store);
+        auto service = std::make_unique<TradeService>(repo, std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+
+        auto buy = MakeValidEquityDto();
+        auto sell = MakeValidEquityDto();
+        sell.IdempotencyKey = "idem-sell";
+        sell.Side = TradeSide::Sell;
+        sell.Notional = 250.0;
+        auto bond = MakeValidEquityDto();
+        bond.IdempotencyKey = "idem-bond";
+        bond.AssetClass = AssetClass::Bond;
+        bond.Notional = 50.0;
+
+        auto buyTrade = service->BookTrade(buy);
+        service->BookTrade(sell);
+        service->BookTrade(bond);
+
+        auto bySide = store->NotionalBySide();
+        auto byAsset = store->NotionalByAssetClass();
+        CHECK(store->Size() == 3 && store->TotalNotional() == 100300.0, name + ": store receives saved trades");
+        CHECK(bySide.Buy == 100050.0 && bySide.Sell == 250.0, name + ": notional by side");
+        CHECK(byAsset[static_cast<std::size_t>(AssetClass::Equity)] == 100250.0 &&
+              byAsset[static_cast<std::size_t>(AssetClass::Bond)] == 50.0, name + ": notional by asset class");
+
+        repo->UpdateStatus(buyTrade->GetTradeId(), TradeStatus::Settled);
+        auto counts = store->CountByStatus();
+        CHECK(counts[static_cast<std::size_t>(TradeStatus::Settled)] == 1 &&
+              counts[static_cast<std::size_t>(TradeStatus::Booked)] == 2, name + ": store follows UpdateStatus");
+
+        repo->Delete(buyTrade->GetTradeId());
+        auto range = store->NotionalRange();
+        CHECK(store->Size() == 2 && range.Min == 50.0 && range.Max == 250.0, name + ": store drops deleted trades");
+    };
+
+    check(std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(),
+        [](ITradeRepository* p){ DestroyInMemoryTradeRepository(p); }), "InMemory");
+    check(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); }), "Sharded");
+
+    // A snapshot repository hands out a fresh Trade for every query and
+    // notification, so rows must follow trade ids, not objects
+    using namespace TradeBookEngine::Core::Repositories;
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() /
+        ("tradebook_columnar_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    std::string path = (dir / "trades.snapshot").string();
+    auto now = std::chrono::system_clock::now();
+    auto makeTrade = [now](const std::string& id, double notional) {
+        auto trade = std::make_shared<Trade>(id, AssetClass::Equity, "AAPL", "ColCpty", notional, "USD",
+            TradeSide::Buy, now, now, "tester");
+        trade->SetStatus(TradeStatus::Booked);
+        return trade;
+    };
+    {
+        auto source = std::unique_ptr<ITradeRepository>(CreateInMemoryTradeRepository());
+        for (int i = 0; i < 4; ++i) {
+            source->Save(makeTrade("C-" + std::to_string(i), 100.0));
+        }
+        WriteTradeSnapshot(*source, path);
+    }
+    {
+        auto snapshot = std::make_shared<SnapshotTradeRepository>(path);
+        auto store = std::make_shared<Analytics::ColumnarTradeStore>();
+        snapshot->AddListener(store);
+        store->Rebuild(snapshot->GetAll());
+        auto transition = snapshot->TransitionStatus("C-1", TradeStatus::Cancelled, IsValidTransition);
+        auto counts = store->CountByStatus();
+        CHECK(transition.Outcome == TransitionOutcome::Applied &&
+              counts[static_cast<std::size_t>(TradeStatus::Booked)] == 3 &&
+              counts[static_cast<std::size_t>(TradeStatus::Cancelled)] == 1,
+              "Snapshot: store follows transitions of snapshot trades");
+        snapshot->Save(makeTrade("C-2", 40.0));
+        snapshot->Delete("C-0");
+        CHECK(store->Size() == 3 && store->TotalNotional() == 240.0 && snapshot->GetAll().size() == 3,
+              "Snapshot: store replaces and drops snapshot trades by id");
+    }
+    std::error_code ignored;
+    fs::remove_all(dir, ignored);
+}
+
+void test_column_kernels_match_scalar() {
+    namespace K = Analytics::Kernels;
+    // Odd length so every vector path also runs its scalar tail
+    const std::size_t rows = 1003;
+    std::vector<double> values(rows);
+    std::vector<std::uint8_t> keys(rows);
+    std::uint32_t seed = 12345;
+    for (std::size_t i = 0; i < rows; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        values[i] = static_cast<double>(seed % 100000u) / 8.0 - 5000.0;
+        keys[i] = static_cast<std::uint8_t>((seed >> 16) % 7u);
+    }
+
+    double sum = 0.0, sumKey3 = 0.0, lo = values[0], hi = values[0];
+    std::uint64_t expectedCounts[K::KeyBuckets] = {};
+    double expectedSums[K::KeyBuckets] = {};
+    for (std::size_t i = 0; i < rows; ++i) {
+        sum += values[i];
+        sumKey3 += keys[i] == 3 ? values[i] : 0.0;
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+        ++expectedCounts[keys[i]];
+        expectedSums[keys[i]] += values[i];
+    }
+
+    std::uint64_t counts[K::KeyBuckets] = {};
+    double sums[K::KeyBuckets] = {};
+    K::CountByKey(keys.data(), rows, counts);
+    K::SumByKey(values.data(), keys.data(), rows, sums);
+    bool bucketsMatch = true;
+    for (std::size_t k = 0; k < K::KeyBuckets; ++k) {
+        bucketsMatch = bucketsMatch && counts[k] == expectedCounts[k] &&
+            std::fabs(sums[k] - expectedSums[k]) < 1e-6;
+    }
+    auto range = K::MinMax(values.data(), rows);
+    auto empty = K::MinMax(values.data(), 0);
+
+    std::string isa = K::ActiveInstructionSet();
+    CHECK(std::fabs(K::Sum(values.data(), rows) - sum) < 1e-6, "Sum kernel matches scalar (" + isa + ")");
+    CHECK(std::fabs(K::SumWhereEquals(values.data(), keys.data(), rows, 3) - sumKey3) < 1e-6,
+          "SumWhereEquals kernel matches scalar");
+    CHECK(range.Min == lo && range.Max == hi && empty.Min > empty.Max, "MinMax kernel matches scalar");
+    CHECK(bucketsMatch, "CountByKey and SumByKey kernels match scalar");
+}
+
+void test_attribute_map() {
+    AttributeMap attributes;
+    attributes["Exchange"] = "NASDAQ";
+    attributes.SetCreditRating("AA+");
+    CHECK(attributes.size() == 2 && attributes.Exchange() == "NASDAQ" &&
+          attributes.Get("CreditRating") == "AA+" && attributes.MaturityDate().empty(),
+          "AttributeMap typed and named accessors agree");
+
+    const std::string longValue(64, 'x');
+    attributes["Desk"] = longValue;
+    attributes["Book"] = "EQ-FLOW";
+    attributes["Exchange"] = "NYSE";
+    AttributeMap copy = attributes;
+    AttributeMap moved = std::move(copy);
+    CHECK(moved.size() == 4 && moved.Get("Desk") == longValue && moved.Exchange() == "NYSE" &&
+          moved.Get("Book") == "EQ-FLOW", "AttributeMap keeps entries past its inline capacity");
+
+    std::size_t symbolsBefore = Symbols::SymbolTable::Instance().Size();
+    CHECK(!moved.Contains("never-interned-attribute-key") &&
+          Symbols::SymbolTable::Instance().Size() == symbolsBefore,
+          "AttributeMap lookups do not intern unknown keys");
+
+    TestContext ctx;
+    auto dto = MakeValidEquityDto();
+    dto.Additional["Desk"] = longValue;
+    auto trade = ctx.service->BookTrade(dto);
+    CHECK(trade->GetAdditional().Exchange() == "NASDAQ" && trade->GetAdditional().Get("Desk") == longValue,
+          "Booked trade carries the DTO attributes");
+
+    dto.IdempotencyKey = "idem-no-exchange";
+    dto.Additional = AttributeMap();
+    bool threw = false;
+    try {
+        (void)ctx.service->BookTrade(dto);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw, "Equity without Exchange attribute is rejected");
+}
+
+void test_pooled_trade_allocation() {
+    TestContext ctx;
+    ctx.service->SetTradeAllocation(TradeAllocation::Pooled);
+
+    // Trades booked on a thread that exits before they are released
+    std::vector<std::shared_ptr<Trade>> booked;
+    std::thread worker([&ctx, &booked]() {
+        for (int i = 0; i < 2000; ++i) {
+            auto dto = MakeValidEquityDto();
+            dto.IdempotencyKey = "pooled-" + std::to_string(i);
+            dto.Notional = 1000.0 + i;
+            booked.push_back(ctx.service->BookTrade(dto));
+        }
+    });
+    worker.join();
+
+    bool intact = booked.size() == 2000;
+    for (std::size_t i = 0; intact && i < booked.size(); ++i) {
+        intact = booked[i]->GetNotional() == 1000.0 + static_cast<double>(i) &&
+            booked[i]->GetAdditional().Exchange() == "NASDAQ" &&
+            ctx.repo->GetById(booked[i]->GetTradeId()) == booked[i];
+    }
+    CHECK(intact, "Pooled trades outlive the thread that booked them");
+
+    for (const auto& trade : booked) {
+        ctx.repo->Delete(trade->GetTradeId());
+    }
+    booked.clear();
+    auto dto = MakeValidEquityDto();
+    dto.IdempotencyKey = "pooled-after-release";
+    auto reused = ctx.service->BookTrade(dto);
+    CHECK(reused && ctx.repo->GetById(reused->GetTradeId()) == reused &&
+          Memory::SlabPool::GetStats().SlabBytes > 0,
+          "Pooled blocks released on another thread are reused");
+}
+
+void test_streaming_reads() {
+    auto check = [](const std::shared_ptr<ITradeRepository>& repo, const std::string& name) {
+        auto service = std::make_unique<TradeService>(repo, std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+        auto now = std::chrono::system_clock::now();
+        // Enough trades that scans span several locked chunks
+        const int tradeCount = 5000;
+        for (int i = 0; i < tradeCount; ++i) {
+            repo->Save(std::make_shared<Trade>("S-" + std::to_string(i), AssetClass::Equity, "AAPL",
+                (i % 2 == 0) ? "Even" : "Odd", 1.0, "USD", TradeSide::Buy, now, now, "tester"));
+        }
+
+        double total = 0.0;
+        std::size_t visited = 0;
+        service->ForEachTrade([&](const Trade& trade) {
+            total += trade.GetNotional();
+            ++visited;
+            return true;
+        });
+        CHECK(visited == static_cast<std::size_t>(tradeCount) && total == tradeCount, name + ": ForEach visits every trade");
+
+        std::size_t odd = 0;
+        repo->ForEach([](const Trade& trade) { return trade.GetCounterparty() == "Odd"; },
+                      [&odd](const Trade&) { return ++odd < 10; });
+        CHECK(odd == 10, name + ": ForEach applies the predicate and stops when asked");
+
+        // Page through evens, deleting some trades between pages
+        std::set<std::string> seen;
+        std::size_t pages = 0;
+        bool pagesBounded = true;
+        auto cursor = service->OpenTradeCursor(300, [](const Trade& trade) { return trade.GetCounterparty() == "Even"; });
+        bool more = true;
+        while (more) {
+            std::size_t inPage = 0;
+            more = cursor.Next([&](const Trade& trade) {
+                seen.insert(trade.GetTradeId());
+                ++inPage;
+                return true;
+            });
+            pagesBounded = pagesBounded && inPage <= 300;
+            if (++pages == 2) {
+                repo->Delete("S-4998");
+            }
+        }
+        CHECK(pagesBounded && pages >= 8 && cursor.Done() && cursor.ContinuationToken().empty(),
+              name + ": cursor returns bounded pages until done");
+        CHECK(seen.size() == static_cast<std::size_t>(tradeCount / 2 - 1) && !seen.count("S-4998"),
+              name + ": cursor sees each remaining trade once");
+
+        std::string token = repo->ReadPage("", 1, TradePredicate(), [](const Trade&) { return true; });
+        TradeCursor resumed(*repo, 10000, TradePredicate(), token);
+        std::size_t rest = 0;
+        resumed.Next([&rest](const Trade&) { ++rest; return true; });
+        CHECK(!token.empty() && rest == static_cast<std::size_t>(tradeCount - 2), name + ": continuation token resumes a scan");
+
+        bool rejected = false;
+        try {
+            repo->ReadPage("not-a-token", 10, TradePredicate(), [](const Trade&) { return true; });
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        CHECK(rejected, name + ": malformed continuation token is rejected");
+    };
+
+    check(std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(),
+        [](ITradeRepository* p){ DestroyInMemoryTradeRepository(p); }), "InMemory");
+    check(std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); }), "Sharded");
+}
+
+void test_journal_recovery() {
+    using namespace TradeBookEngine::Core::Repositories;
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() /
+        ("tradebook_journal_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    fs::path log = dir / "trades.journal";
+    auto open = [](const fs::path& path) {
+        JournalOptions options;
+        options.Path = path.string();
+        options.ShardCount = 4;
+        return std::make_unique<JournalTradeRepository>(options);
+    };
+
+    auto now = std::chrono::system_clock::now();
+    const int tradeCount = 40;
+    {
+        auto repo = open(log);
+        for (int i = 0; i < tradeCount; ++i) {
+            auto trade = std::make_shared<Trade>("J-" + std::to_string(i), AssetClass::Equity, "AAPL", "CP",
+                1000.0 + i, "USD", TradeSide::Buy, now, now, "tester");
+            trade->SetIdempotencyKey("jkey-" + std::to_string(i));
+            trade->AddAdditionalData("Exchange", "NASDAQ");
+            trade->AddAdditionalData("Desk", "a desk name longer than inline");
+            repo->Save(trade);
+        }
+        repo->UpdateStatus("J-3", TradeStatus::Settled);
+        repo->Delete("J-5");
+    }
+    {
+        auto repo = open(log);
+        auto stats = repo->GetStats();
+        auto trade = repo->GetById("J-7");
+        CHECK(stats.RecoveredRecords == static_cast<std::uint64_t>(tradeCount + 2) && stats.TruncatedBytes == 0,
+              "Journal replays every record on reopen");
+        CHECK(trade && trade->GetNotional() == 1007.0 && trade->GetAdditional().Exchange() == "NASDAQ" &&
+              trade->GetAdditional().Get("Desk") == "a desk name longer than inline" &&
+              std::chrono::duration_cast<std::chrono::microseconds>(trade->GetTradeDate() - now).count() == 0,
+              "Journal restores trade fields and attributes");
+        CHECK(repo->GetById("J-3")->GetStatus() == TradeStatus::Settled && !repo->Exists("J-5") &&
+              repo->GetByIdempotencyKey("jkey-9") && repo->GetAll().size() == static_cast<std::size_t>(tradeCount - 1),
+              "Journal restores status changes, deletes and idempotency keys");
+    }
+
+    // Simulate a crash at arbitrary points by truncating a copy of the log
+    std::string bytes;
+    {
+        std::ifstream in(log, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    fs::path torn = dir / "torn.journal";
+    bool prefixOnly = true;
+    bool cleanAfterRepair = true;
+    std::size_t lastCount = 0;
+    for (std::size_t cut = 0; cut <= bytes.size(); cut += (cut + 64 < bytes.size() ? 7u : 1u)) {
+        {
+            std::ofstream out(torn, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(cut));
+        }
+        std::size_t saved = 0;
+        {
+            auto repo = open(torn);
+            saved = static_cast<std::size_t>(std::min<std::uint64_t>(repo->GetStats().RecoveredRecords, tradeCount));
+            for (std::size_t i = 0; i < saved && prefixOnly; ++i) {
+                prefixOnly = repo->Exists("J-" + std::to_string(i)) || i == 5;
+            }
+            prefixOnly = prefixOnly && !repo->Exists("J-" + std::to_string(saved));
+            prefixOnly = prefixOnly && saved >= lastCount;
+            lastCount = saved;
+        }
+        auto reopened = open(torn);
+        cleanAfterRepair = cleanAfterRepair && reopened->GetStats().TruncatedBytes == 0;
+    }
+    CHECK(prefixOnly && lastCount == static_cast<std::size_t>(tradeCount),
+          "Truncated journal recovers exactly a prefix of the commits");
+    CHECK(cleanAfterRepair, "Recovery leaves a clean journal behind");
+
+    // A flipped byte mid-file is damage, not a torn write: opening fails and
+    // the file, with the acknowledged commits after the damage, is kept
+    std::string corrupt = bytes;
+    corrupt[bytes.find("J-20")] ^= 0x5A;
+    {
+        std::ofstream out(torn, std::ios::binary | std::ios::trunc);
+        out.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+    }
+    bool refused = false;
+    try {
+        open(torn);
+    } catch (const JournalError&) {
+        refused = true;
+    }
+    std::string after;
+    {
+        std::ifstream in(torn, std::ios::binary);
+        after.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    CHECK(refused && after == corrupt, "Corrupt journal record mid-file is refused without truncating");
+
+    // The same damage in the last record is treated as a torn write
+    corrupt = bytes;
+    corrupt[corrupt.size() - 2] ^= 0x5A;
+    {
+        std::ofstream out(torn, std::ios::binary | std::ios::trunc);
+        out.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+    }
+    {
+        auto repo = open(torn);
+        auto stats = repo->GetStats();
+        CHECK(stats.TruncatedBytes > 0 && stats.RecoveredRecords == static_cast<std::uint64_t>(tradeCount + 1) &&
+              repo->Exists("J-3"), "Corrupt last journal record is dropped as a torn tail");
+    }
+
+    // Concurrent callers share commits
+    {
+        auto repo = open(dir / "group.journal");
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&repo, t, now]() {
+                for (int i = 0; i < 200; ++i) {
+                    repo->Save(std::make_shared<Trade>("G-" + std::to_string(t) + "-" + std::to_string(i),
+                        AssetClass::Equity, "AAPL", "CP", 1.0, "USD", TradeSide::Sell, now, now, "tester"));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto stats = repo->GetStats();
+        CHECK(stats.Records == 800 && stats.Commits <= stats.Records && repo->GetAll().size() == 800,
+              "Journal commits every concurrent save");
+    }
+
+#if !defined(_WIN32)
+    // A commit that cannot be written leaves no trace: capping the file size
+    // makes the next write fail with EFBIG
+    {
+        std::shared_ptr<ITradeRepository> repo = open(dir / "failing.journal");
+        auto limits = std::make_shared<Risk::CounterpartyLimits>();
+        auto positions = std::make_shared<Analytics::PositionKeeper>();
+        repo->AddListener(limits);
+        repo->AddListener(positions);
+        TradeService service(repo, std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+        service.SetCounterpartyLimits(limits);
+        auto first = MakeValidEquityDto();
+        first.IdempotencyKey = "fail-1";
+        auto booked = service.TryBookTrade(first);
+
+        struct rlimit original;
+        getrlimit(RLIMIT_FSIZE, &original);
+        struct rlimit capped = original;
+        capped.rlim_cur = static_cast<rlim_t>(fs::file_size(dir / "failing.journal"));
+        auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &capped);
+        auto second = first;
+        second.IdempotencyKey = "fail-2";
+        bool threw = false;
+        try {
+            service.TryBookTrade(second);
+        } catch (const JournalError&) {
+            threw = true;
+        }
+        setrlimit(RLIMIT_FSIZE, &original);
+        std::signal(SIGXFSZ, previousHandler);
+
+        auto reservation = repo->TryReserveIdempotencyKeys({"fail-2"});
+        CHECK(threw && booked.Succeeded() && repo->GetAll().size() == 1 && !repo->GetByIdempotencyKey("fail-2") &&
+              reservation[0].Status == ReservationStatus::Reserved &&
+              limits->GetUsage("Counterparty1").Exposure == 100000.0 &&
+              positions->ByCounterparty("Counterparty1").Trades == 1,
+              "A failed journal write leaves the book, keys and listeners untouched");
+        repo->ReleaseIdempotencyKey("fail-2");
+        bool sticky = false;
+        try {
+            repo->Delete(booked.Trade->GetTradeId());
+        } catch (const JournalError&) {
+            sticky = true;
+        }
+        CHECK(sticky && repo->Exists(booked.Trade->GetTradeId()), "Mutations after a journal failure throw");
+    }
+    {
+        auto reopened = open(dir / "failing.journal");
+        CHECK(reopened->GetAll().size() == 1 && reopened->GetByIdempotencyKey("fail-1"),
+              "Only acknowledged commits survive a journal write failure");
+    }
+#endif
+
+    bool rejected = false;
+    {
+        std::ofstream out(dir / "foreign.journal", std::ios::binary);
+        out << "not a journal file";
+    }
+    try {
+        open(dir / "foreign.journal");
+    } catch (const JournalError&) {
+        rejected = true;
+    }
+    CHECK(rejected, "Journal refuses to open a foreign file");
+
+    std::error_code ignored;
+    fs::remove_all(dir, ignored);
+}
+
+void test_snapshot_repository() {
+    using namespace TradeBookEngine::Core::Repositories;
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() /
+        ("tradebook_snapshot_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    std::string path = (dir / "trades.snapshot").string();
+
+    auto source = std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); });
+    auto now = std::chrono::system_clock::now();
+    const int tradeCount = 3000;
+    for (int i = 0; i < tradeCount; ++i) {
+        auto trade = std::make_shared<Trade>("N-" + std::to_string(i), (i % 3 == 0) ? AssetClass::Bond : AssetClass::Equity,
+            "INS-" + std::to_string(i % 7), "CP-" + std::to_string(i % 5), 10.0 + i, "EUR", TradeSide::Buy, now,
+            now + std::chrono::hours(24 * (i % 4)), "tester");
+        trade->SetIdempotencyKey("nkey-" + std::to_string(i));
+        trade->AddAdditionalData("Exchange", "XETRA");
+        if (i % 10 == 0) {
+            trade->SetStatus(TradeStatus::Settled);
+        }
+        source->Save(trade);
+    }
+    auto info = WriteTradeSnapshot(*source, path);
+    CHECK(info.Trades == static_cast<std::uint64_t>(tradeCount) && info.Strings < static_cast<std::uint64_t>(3 * tradeCount) &&
+          !fs::exists(path + ".tmp"), "Snapshot writes every trade with shared strings");
+
+    auto repo = std::make_shared<SnapshotTradeRepository>(path, 4);
+    auto trade = repo->GetById("N-42");
+    CHECK(repo->SnapshotTradeCount() == static_cast<std::size_t>(tradeCount) && trade && trade->GetNotional() == 52.0 &&
+          trade->GetCounterparty() == "CP-2" && trade->GetAdditional().Exchange() == "XETRA" &&
+          trade->GetTradeDate() == std::chrono::time_point_cast<std::chrono::system_clock::duration>(now),
+          "Snapshot serves trades from the mapping");
+    CHECK(repo->GetByIdempotencyKey("nkey-9") && repo->GetByIdempotencyKey("nkey-9")->GetTradeId() == "N-9" &&
+          !repo->GetById("missing") && !repo->GetByIdempotencyKey(""),
+          "Snapshot indexes answer id and idempotency lookups");
+    CHECK(repo->GetByCounterparty("CP-1").size() == static_cast<std::size_t>(tradeCount / 5) &&
+          repo->GetByInstrument("INS-3").size() == static_cast<std::size_t>((tradeCount + 3) / 7) &&
+          repo->GetByStatus(TradeStatus::Settled).size() == static_cast<std::size_t>(tradeCount / 10) &&
+          repo->GetByAssetClass(AssetClass::Bond).size() == static_cast<std::size_t>(tradeCount / 3) &&
+          repo->GetByCounterparty("nobody").empty(),
+          "Snapshot answers secondary queries");
+
+    // Overlay writes on top of the snapshot
+    auto service = std::make_unique<TradeService>(repo, std::shared_ptr<IEventPublisher>(
+        CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+    service->AddValidator(std::shared_ptr<IAssetValidator>(CreateEquityValidator(), [](IAssetValidator* v){ DestroyValidator(v); }));
+    auto dto = MakeValidEquityDto();
+    dto.IdempotencyKey = "nkey-11";
+    auto replay = service->BookTrade(dto);
+    dto.IdempotencyKey = "fresh-key";
+    auto booked = service->BookTrade(dto);
+    CHECK(replay->GetTradeId() == "N-11" && repo->GetById(booked->GetTradeId()) == booked,
+          "Booking on a snapshot honours its idempotency keys");
+
+    CHECK(repo->UpdateStatus("N-1", TradeStatus::Cancelled) && repo->GetById("N-1")->GetStatus() == TradeStatus::Cancelled &&
+          repo->GetByStatus(TradeStatus::Cancelled).size() == 1 && !repo->UpdateStatus("missing", TradeStatus::Cancelled),
+          "Status change on a snapshot trade shadows it");
+    repo->Delete("N-2");
+    repo->Delete("N-1");
+    CHECK(!repo->Exists("N-2") && !repo->GetById("N-1") && !repo->GetByIdempotencyKey("nkey-2") &&
+          repo->GetByCounterparty("CP-2").size() == static_cast<std::size_t>(tradeCount / 5 - 1),
+          "Deleted snapshot trades are tombstoned");
+    CHECK(repo->GetBySettlementDate(now + std::chrono::hours(72)).size() == static_cast<std::size_t>(tradeCount / 4) &&
+          repo->GetBySettlementDate(now + std::chrono::hours(24)).size() == static_cast<std::size_t>(tradeCount / 4 - 1) &&
+          repo->GetBySettlementDate(now + std::chrono::hours(48)).size() == static_cast<std::size_t>(tradeCount / 4 - 1) &&
+          repo->GetBySettlementDate(now + std::chrono::hours(24 * 10)).empty(),
+          "Snapshot answers settlement-day queries from its day index, skipping tombstones");
+
+    std::size_t expected = static_cast<std::size_t>(tradeCount - 2 + 1);
+    std::set<std::string> seen;
+    TradeCursor cursor(*repo, 700);
+    bool bounded = true;
+    bool more = true;
+    while (more) {
+        std::size_t inPage = 0;
+        more = cursor.Next([&](const Trade& visited) {
+            seen.insert(visited.GetTradeId());
+            ++inPage;
+            return true;
+        });
+        bounded = bounded && inPage <= 700;
+    }
+    std::size_t forEach = 0;
+    repo->ForEach(TradePredicate(), [&forEach](const Trade&) { ++forEach; return true; });
+    CHECK(bounded && seen.size() == expected && seen.count(booked->GetTradeId()) && forEach == expected &&
+          repo->GetAll().size() == expected, "Scans cover the snapshot and the overlay once");
+
+    // Compacting into a new snapshot keeps the merged view
+    std::string compacted = (dir / "compacted.snapshot").string();
+    WriteTradeSnapshot(*repo, compacted);
+    SnapshotTradeRepository reopened(compacted);
+    CHECK(reopened.GetAll().size() == expected && !reopened.Exists("N-2") && reopened.Exists(booked->GetTradeId()),
+          "Snapshot of a snapshot repository includes the overlay");
+
+    bool rejected = false;
+    {
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        bytes[20] ^= 0x01;
+        std::ofstream out(dir / "corrupt.snapshot", std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    try {
+        SnapshotTradeRepository corrupt((dir / "corrupt.snapshot").string());
+    } catch (const SnapshotError&) {
+        rejected = true;
+    }
+    CHECK(rejected, "Snapshot with a damaged header is rejected");
+
+    service.reset();
+    repo.reset();
+    std::error_code ignored;
+    fs::remove_all(dir, ignored);
+}
+
+void test_validator_dispatch() {
+    TestContext ctx;
+    ctx.service->AddValidator(std::shared_ptr<IAssetValidator>(CreateBondValidator(), [](IAssetValidator* v){ DestroyValidator(v); }));
+
+    auto equity = MakeValidEquityDto();
+    CHECK(ctx.equityValidator->Check(equity) == ValidationError::None && ctx.service->ValidateTrade(equity).empty(),
+          "Valid equity passes the mask check");
+
+    equity.InstrumentId.clear();
+    equity.Additional = AttributeMap();
+    CHECK(ctx.equityValidator->Check(equity) == (ValidationError::InvalidInstrumentId | ValidationError::MissingExchange),
+          "Equity check reports every failure as a bit");
+    equity.InstrumentId = "AAPL";
+    std::string message = ctx.service->ValidateTrade(equity);
+    CHECK(message == "Validation failed: Exchange is required for equity trades; ",
+          "Failure message is rendered from the validator");
+
+    auto bond = MakeValidEquityDto();
+    bond.AssetClass = AssetClass::Bond;
+    bond.Additional.SetMaturityDate("2030-01-01");
+    std::string bondMessage = ctx.service->ValidateTrade(bond);
+    CHECK(bondMessage.find("CreditRating is required") != std::string::npos &&
+          bondMessage.find("MaturityDate") == std::string::npos, "Bond trades dispatch to the bond validator");
+
+    // A validator that only implements the message API still gates bookings
+    struct LegacyValidator : IAssetValidator {
+        bool IsValid(const TradeDto& dto) const override { return GetValidationErrors(dto).empty(); }
+        std::vector<std::string> GetValidationErrors(const TradeDto& dto) const override {
+            return dto.Notional > 100.0 ? std::vector<std::string>{"Commodity lots are capped"} : std::vector<std::string>();
+        }
+        AssetClass GetSupportedAssetClass() const override { return AssetClass::Commodity; }
+    };
+    ctx.service->AddValidator(std::make_shared<LegacyValidator>());
+    auto commodity = MakeValidEquityDto();
+    commodity.AssetClass = AssetClass::Commodity;
+    CHECK(ctx.service->ValidateTrade(commodity) == "Validation failed: Commodity lots are capped; ",
+          "Validators without Check fall back to their messages");
+}
+
+void test_try_book_trade() {
+    TestContext ctx;
+    auto dto = MakeValidEquityDto();
+    auto booked = ctx.service->TryBookTrade(dto);
+    CHECK(booked.Status == BookingStatus::Booked && booked.Trade && !booked.Error &&
+          booked.Error.Message().empty(), "TryBookTrade books a valid trade");
+    auto duplicate = ctx.service->TryBookTrade(dto);
+    CHECK(duplicate.Status == BookingStatus::Duplicate && duplicate.Trade == booked.Trade,
+          "TryBookTrade returns the existing trade for a duplicate key");
+
+    auto invalid = MakeValidEquityDto();
+    invalid.IdempotencyKey = "reject-then-fix";
+    invalid.Additional = AttributeMap();
+    auto rejected = ctx.service->TryBookTrade(invalid);
+    std::string thrown;
+    try {
+        ctx.service->BookTrade(invalid);
+    } catch (const std::invalid_argument& ex) {
+        thrown = ex.what();
+    }
+    CHECK(rejected.Status == BookingStatus::Rejected && !rejected.Trade &&
+          rejected.Error.Code == BookingErrorCode::AssetValidation &&
+          std::string(rejected.Error.Field) == "Additional.Exchange" &&
+          rejected.Error.ValidationErrors == ValidationError::MissingExchange &&
+          rejected.Error.Message() == thrown && !thrown.empty(),
+          "TryBookTrade reports a structured asset validation error");
+
+    // The error is a value: it renders after its DTO and service are gone
+    BookingError detached;
+    {
+        TestContext scoped;
+        detached = scoped.service->TryBookTrade([] {
+            auto bad = MakeValidEquityDto();
+            bad.InstrumentId = std::string(60, 'X');
+            bad.Additional = AttributeMap();
+            return bad;
+        }()).Error;
+    }
+    CHECK(detached.Code == BookingErrorCode::AssetValidation &&
+          detached.Message() == "Validation failed: Invalid instrument ID; Exchange is required for equity trades; ",
+          "BookingError renders its message from its code and error bits alone");
+
+    invalid.Notional = -5.0;
+    auto negative = ctx.service->TryBookTrade(invalid);
+    CHECK(negative.Error.Code == BookingErrorCode::NonPositiveNotional && std::string(negative.Error.Field) == "Notional" &&
+          negative.Error.Message() == "Notional must be positive", "TryBookTrade reports basic field errors");
+
+    invalid.Notional = 10.0;
+    invalid.Additional.SetExchange("LSE");
+    CHECK(ctx.service->TryBookTrade(invalid).Status == BookingStatus::Booked,
+          "A rejected booking releases its idempotency key");
+
+    // C layer
+    Trade* trade = nullptr;
+    char message[32];
+    auto cDto = MakeValidEquityDto();
+    cDto.IdempotencyKey = "c-api";
+    int ok = TryBookTradeC(ctx.service.get(), &cDto, &trade, message, sizeof(message));
+    CHECK(ok == 0 && trade != nullptr && message[0] == '\0', "TryBookTradeC books and returns the trade");
+    cDto.IdempotencyKey = "c-api-2";
+    cDto.Counterparty.clear();
+    int code = TryBookTradeC(ctx.service.get(), &cDto, &trade, message, sizeof(message));
+    CHECK(code == static_cast<int>(BookingErrorCode::EmptyCounterparty) && trade == nullptr &&
+          std::string(message) == "Counterparty cannot be empty", "TryBookTradeC returns an error code and reason");
+    cDto.Counterparty = "CP";
+    cDto.Additional = AttributeMap();
+    code = TryBookTradeC(ctx.service.get(), &cDto, nullptr, message, 8);
+    CHECK(code == static_cast<int>(BookingErrorCode::AssetValidation) && std::string(message) == "Validat",
+          "TryBookTradeC truncates the reason to the buffer");
+}
+
+void test_iso8601_timestamps() {
+    using Utils::DateTimeUtils;
+    using Utils::TimestampPrecision;
+    using std::chrono::system_clock;
+    using std::chrono::milliseconds;
+    using std::chrono::microseconds;
+
+    auto leapDay = system_clock::time_point(milliseconds(1709210096789LL));
+    char buffer[DateTimeUtils::MaxIso8601Length];
+    std::size_t length = DateTimeUtils::FormatIso8601(leapDay, buffer, sizeof(buffer), TimestampPrecision::Milliseconds);
+    CHECK(std::string(buffer, length) == "2024-02-29T12:34:56.789Z" && buffer[length] == '\0' &&
+          DateTimeUtils::ToString(leapDay) == "2024-02-29T12:34:56Z", "ISO-8601 formats UTC at each precision");
+
+    auto beforeEpoch = system_clock::time_point(microseconds(-1));
+    length = DateTimeUtils::FormatIso8601(beforeEpoch, buffer, sizeof(buffer), TimestampPrecision::Microseconds);
+    CHECK(std::string(buffer, length) == "1969-12-31T23:59:59.999999Z" &&
+          DateTimeUtils::FormatIso8601(leapDay, buffer, 20, TimestampPrecision::Seconds) == 0,
+          "ISO-8601 formats times before the epoch and checks the buffer");
+
+    system_clock::time_point parsed;
+    CHECK(DateTimeUtils::ParseIso8601("2024-02-29T12:34:56.789Z", 24, parsed) && parsed == leapDay &&
+          DateTimeUtils::FromString("2024-02-29T14:34:56.789+02:00") == leapDay &&
+          DateTimeUtils::FromString("2024-02-29T12:34:56Z") == system_clock::time_point(std::chrono::seconds(1709210096)),
+          "ISO-8601 parses as UTC with fractions and offsets");
+
+    bool allRejected = true;
+    for (const char* bad : {"2023-02-29T00:00:00Z", "2024-13-01T00:00:00Z", "2024-01-01T24:00:00Z",
+                            "2024-01-01T00:00:00", "2024-01-01 00:00:00Z", "2024-01-01T00:00:00.Z",
+                            "2024-01-01T00:00:00.1234567890Z", "2024-0a-01T00:00:00Z", ""}) {
+        allRejected = allRejected && !DateTimeUtils::ParseIso8601(bad, std::strlen(bad), parsed);
+    }
+    bool threw = false;
+    try {
+        DateTimeUtils::FromString("not a timestamp");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(allRejected && threw, "ISO-8601 rejects malformed and out-of-range input");
+
+    // Round trip 1900-2200, inside the nanosecond clock range, from several threads
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &mismatches]() {
+            std::mt19937_64 random(static_cast<std::uint64_t>(t) + 1);
+            std::uniform_int_distribution<std::int64_t> range(-2208988800000000LL, 7258118400000000LL);
+            char text[DateTimeUtils::MaxIso8601Length];
+            for (int i = 0; i < 20000; ++i) {
+                auto time = system_clock::time_point(microseconds(range(random)));
+                std::size_t size = DateTimeUtils::FormatIso8601(time, text, sizeof(text), TimestampPrecision::Microseconds);
+                system_clock::time_point back;
+                if (size == 0 || !DateTimeUtils::ParseIso8601(text, size, back) || back != time) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(mismatches == 0, "ISO-8601 round-trips microsecond timestamps across threads");
+}
+
+void test_holiday_calendars() {
+    using namespace TradeBookEngine::Core::Calendars;
+    using Utils::DateTimeUtils;
+    namespace fs = std::filesystem;
+    auto date = [](int year, unsigned month, unsigned day) {
+        return static_cast<Day>(DateTimeUtils::DaysFromCivil(year, month, day));
+    };
+
+    fs::path dir = fs::temp_directory_path() /
+        ("tradebook_calendar_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    {
+        std::ofstream gbp(dir / "london.cal");
+        gbp << "# London settlement\ncode: GBP\nweekend: Sat Sun\n2025-12-25 Christmas Day\n2025-12-26 Boxing Day\n";
+        std::ofstream usd(dir / "USD.cal");
+        usd << "2025-12-25   # Christmas\n\n";
+        std::ofstream ignored(dir / "notes.txt");
+        ignored << "not a calendar\n";
+    }
+    auto registry = std::make_shared<CalendarRegistry>();
+    std::size_t loaded = registry->LoadDirectory(dir.string());
+    auto gbp = registry->Find("GBP");
+    auto usd = registry->Find("USD");
+    CHECK(loaded == 2 && gbp && usd && !registry->Find("london") && registry->Codes().size() == 2,
+          "Calendar directory loads .cal files by code or file name");
+
+    CHECK(gbp->AddBusinessDays(date(2025, 12, 24), 1) == date(2025, 12, 29) &&
+          usd->AddBusinessDays(date(2025, 12, 24), 1) == date(2025, 12, 26) &&
+          gbp->AddBusinessDays(date(2025, 12, 29), -1) == date(2025, 12, 24) &&
+          gbp->AddBusinessDays(date(2025, 12, 25), 0) == date(2025, 12, 25) &&
+          gbp->BusinessDaysBetween(date(2025, 12, 24), date(2026, 1, 1)) == 4 &&
+          gbp->BusinessDaysBetween(date(2026, 1, 1), date(2025, 12, 24)) == -4,
+          "Calendar skips weekends and holidays when adding and counting");
+
+    CHECK(gbp->Roll(date(2025, 5, 31), RollConvention::Following) == date(2025, 6, 2) &&
+          gbp->Roll(date(2025, 5, 31), RollConvention::ModifiedFollowing) == date(2025, 5, 30) &&
+          gbp->Roll(date(2025, 12, 26), RollConvention::Preceding) == date(2025, 12, 24) &&
+          gbp->Roll(date(2025, 12, 26), RollConvention::ModifiedFollowing) == date(2025, 12, 29),
+          "Calendar rolls with following, preceding and modified following");
+
+    // Table lookups agree with stepping one day at a time
+    HolidayCalendar middleEast("ME", {date(2024, 4, 10), date(2024, 4, 11)},
+                               static_cast<WeekendMask>((1u << 5) | (1u << 6)));
+    bool matches = true;
+    std::mt19937 random(17);
+    std::uniform_int_distribution<Day> days(date(2000, 1, 1), date(2050, 1, 1));
+    std::uniform_int_distribution<int> steps(-12, 12);
+    for (int i = 0; i < 2000 && matches; ++i) {
+        Day start = days(random);
+        int n = steps(random);
+        Day expected = start;
+        for (int left = n; left != 0;) {
+            expected += left > 0 ? 1 : -1;
+            if (middleEast.IsBusinessDay(expected)) {
+                left += left > 0 ? -1 : 1;
+            }
+        }
+        matches = middleEast.AddBusinessDays(start, n) == expected &&
+                  (n <= 0 || middleEast.BusinessDaysBetween(start + 1, expected + 1) == n);
+    }
+    CHECK(matches && !middleEast.IsBusinessDay(date(2024, 4, 12)) && middleEast.IsBusinessDay(date(2024, 4, 14)),
+          "Calendar tables match a day-by-day walk with a Friday-Saturday weekend");
+
+    auto friday = std::chrono::system_clock::time_point(std::chrono::seconds(1749816000));  // 2025-06-13T12:00:00Z
+    bool outOfRange = false;
+    try {
+        HolidayCalendar::WeekendsOnly().AddBusinessDays(HolidayCalendar::DefaultLastDay, 1);
+    } catch (const std::out_of_range&) {
+        outOfRange = true;
+    }
+    CHECK(DateTimeUtils::AddBusinessDays(friday, 1) == friday + std::chrono::hours(72) &&
+          DateTimeUtils::AddBusinessDays(friday, -5) == friday - std::chrono::hours(24 * 7) && outOfRange,
+          "AddBusinessDays keeps the time of day and rejects dates past the table");
+
+    std::istringstream bad("code: BAD\n2025-02-30\n");
+    bool rejected = false;
+    try {
+        HolidayCalendar::Parse(bad, "", "bad.cal");
+    } catch (const CalendarError& error) {
+        rejected = std::string(error.what()).find("bad.cal:2") != std::string::npos;
+    }
+    CHECK(rejected, "Calendar parser reports the file and line of a bad date");
+
+    // Settlement dates derived at booking
+    TestContext ctx;
+    ctx.service->SetSettlementCalendars(registry);
+    auto dto = MakeValidEquityDto();
+    dto.IdempotencyKey.clear();
+    dto.Currency = "GBP";
+    dto.TradeDate = HolidayCalendar::FromDay(date(2025, 12, 24)) + std::chrono::hours(10);
+    dto.SettlementDate = std::chrono::system_clock::time_point();
+    auto london = ctx.service->BookTrade(dto);
+    dto.Currency = "JPY";
+    auto fallback = ctx.service->BookTrade(dto);
+    dto.SettlementDate = dto.TradeDate;
+    auto explicitDate = ctx.service->BookTrade(dto);
+    CHECK(london->GetSettlementDate() == HolidayCalendar::FromDay(date(2025, 12, 30)) + std::chrono::hours(10) &&
+          fallback->GetSettlementDate() == HolidayCalendar::FromDay(date(2025, 12, 26)) + std::chrono::hours(10) &&
+          explicitDate->GetSettlementDate() == dto.TradeDate,
+          "TradeService derives missing settlement dates from the currency calendar");
+
+    // Dates the calendars cannot settle are rejected, not thrown, so one
+    // does not fail a whole batch
+    std::vector<TradeDto> batch(3, dto);
+    batch[0].TradeDate = HolidayCalendar::FromDay(date(2199, 12, 30));
+    batch[0].SettlementDate = std::chrono::system_clock::time_point();
+    batch[1].TradeDate = HolidayCalendar::FromDay(date(1850, 1, 1));
+    batch[1].SettlementDate = std::chrono::system_clock::time_point();
+    batch[2].TradeDate = batch[0].TradeDate;
+    batch[2].SettlementDate = batch[0].TradeDate;
+    std::vector<BookingResult> results;
+    bool threw = false;
+    try {
+        results = ctx.service->BookTrades(batch);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    auto farFuture = ctx.service->TryBookTrade(batch[0]);
+    CHECK(!threw && results.size() == 3 && results[0].Status == BookingStatus::Rejected &&
+          results[1].Status == BookingStatus::Rejected && results[2].Status == BookingStatus::Booked &&
+          farFuture.Error.Code == BookingErrorCode::TradeDateOutOfRange &&
+          std::string(farFuture.Error.Field) == "TradeDate",
+          "Trade dates outside the settlement calendar are rejected when the settlement date is derived");
+    bool rangeThrew = false;
+    try {
+        DateTimeUtils::AddBusinessDays(HolidayCalendar::FromDay(date(2199, 12, 30)), 2);
+    } catch (const std::out_of_range&) {
+        rangeThrew = true;
+    }
+    CHECK(rangeThrew && HolidayCalendar::WeekendsOnly().CanAddBusinessDays(date(2199, 12, 29), 1) &&
+          !HolidayCalendar::WeekendsOnly().CanAddBusinessDays(date(2199, 12, 30), 2) &&
+          !HolidayCalendar::WeekendsOnly().CanAddBusinessDays(date(1899, 12, 31), 0),
+          "CanAddBusinessDays predicts where AddBusinessDays would throw");
+
+    fs::remove_all(dir);
+}
+
+void test_currency_codes() {
+    using Models::CurrencyCode;
+    using Utils::ValidationUtils;
+
+    CurrencyCode usd("USD");
+    char text[4];
+    usd.CopyTo(text);
+    CHECK(!usd.Empty() && std::string(text) == "USD" && usd.ToString() == "USD" &&
+          CurrencyCode::FromPacked(usd.Packed()) == usd && sizeof(CurrencyCode) == 2,
+          "CurrencyCode packs three letters into two bytes and back");
+    CHECK(CurrencyCode("usd").Empty() && CurrencyCode("US").Empty() && CurrencyCode("USDT").Empty() &&
+          CurrencyCode("U$D").Empty() && CurrencyCode().ToString().empty() &&
+          CurrencyCode("AUD") < CurrencyCode("EUR") && CurrencyCode("EUR") < CurrencyCode("EUS"),
+          "CurrencyCode rejects anything but A-Z and sorts alphabetically");
+
+    // Every ISO index maps to a distinct ISO code, in alphabetical order
+    bool dense = true;
+    for (std::size_t i = 0; i < Models::IsoCurrencyCount; ++i) {
+        auto code = CurrencyCode::FromIsoIndex(i);
+        dense = dense && code.IsIso4217() && code.IsoIndex() == static_cast<int>(i) &&
+                (i == 0 || CurrencyCode::FromIsoIndex(i - 1) < code);
+    }
+    CHECK(dense && CurrencyCode::FromIsoIndex(Models::IsoCurrencyCount).Empty() &&
+          CurrencyCode("AED").IsoIndex() == 0 && CurrencyCode("ZWL").IsoIndex() == static_cast<int>(Models::IsoCurrencyCount) - 1,
+          "ISO index is dense and alphabetical");
+
+    CHECK(ValidationUtils::IsValidCurrency("USD") && ValidationUtils::IsValidCurrency("INR") &&
+          ValidationUtils::IsValidCurrency("XAU") && !ValidationUtils::IsValidCurrency("ABC") &&
+          !ValidationUtils::IsValidCurrency("usd") && !ValidationUtils::IsValidCurrency("") &&
+          !CurrencyCode("ABC").IsIso4217() && CurrencyCode("ABC").IsoIndex() == -1,
+          "IsValidCurrency covers the ISO-4217 list");
+
+    auto repo = std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); });
+    auto store = std::make_shared<Analytics::ColumnarTradeStore>();
+    repo->AddListener(store);
+    TradeService service(repo, std::shared_ptr<IEventPublisher>(
+        CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+    const char* currencies[] = {"USD", "EUR", "USD", "btc"};
+    std::shared_ptr<Trade> last;
+    for (int i = 0; i < 4; ++i) {
+        auto dto = MakeValidEquityDto();
+        dto.IdempotencyKey.clear();
+        dto.Currency = currencies[i];
+        dto.Notional = 100.0 * (i + 1);
+        last = service.BookTrade(dto);
+    }
+    auto byCurrency = store->NotionalByCurrency();
+    double total = 0.0;
+    for (double notional : byCurrency) {
+        total += notional;
+    }
+    CHECK(byCurrency[static_cast<std::size_t>(CurrencyCode("USD").IsoIndex())] == 400.0 &&
+          byCurrency[static_cast<std::size_t>(CurrencyCode("EUR").IsoIndex())] == 200.0 && total == 600.0 &&
+          last->GetCurrency() == "btc" && last->GetCurrencyCode().Empty(),
+          "Columnar store aggregates notional by ISO currency index");
+}
+
+void test_booking_engine() {
+    auto publisher = std::shared_ptr<IEventPublisher>(
+        CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); });
+    auto validator = std::shared_ptr<IAssetValidator>(
+        CreateEquityValidator(), [](IAssetValidator* v){ DestroyValidator(v); });
+    BookingEngineOptions options;
+    options.WorkerCount = 4;
+    options.QueueCapacity = 64;  // Small, so producers hit a full queue
+    options.MaxBatchSize = 16;
+    options.CpuAffinity = {0};
+    options.ConfigureService = [validator](TradeService& service) { service.AddValidator(validator); };
+
+    const int counterparties = 10;
+    const int perCounterparty = 300;
+    std::mutex orderMutex;
+    std::vector<std::vector<double>> order(counterparties);
+    std::atomic<int> booked{0};
+    {
+        BookingEngine engine(publisher, options);
+        CHECK(engine.WorkerCount() == 4, "BookingEngine starts the requested workers");
+
+        // Two producers interleave; each owns half the counterparties so
+        // submission order per counterparty is well defined
+        std::vector<std::thread> producers;
+        for (int p = 0; p < 2; ++p) {
+            producers.emplace_back([&, p]() {
+                for (int i = 0; i < perCounterparty; ++i) {
+                    for (int c = p; c < counterparties; c += 2) {
+                        auto dto = MakeValidEquityDto();
+                        dto.Counterparty = "CP-" + std::to_string(c);
+                        dto.IdempotencyKey = "engine-" + std::to_string(c) + "-" + std::to_string(i);
+                        dto.Notional = 1.0 + i;
+                        engine.Submit(std::move(dto), [&, c](const BookingResult& result) {
+                            if (result.Status == BookingStatus::Booked) {
+                                ++booked;
+                                std::lock_guard<std::mutex> lock(orderMutex);
+                                order[static_cast<std::size_t>(c)].push_back(result.Trade->GetNotional());
+                            }
+                        });
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        engine.Flush();
+
+        bool ordered = true;
+        for (const auto& notionals : order) {
+            ordered = ordered && notionals.size() == static_cast<std::size_t>(perCounterparty) &&
+                      std::is_sorted(notionals.begin(), notionals.end());
+        }
+        CHECK(booked == counterparties * perCounterparty && ordered,
+              "BookingEngine books every trade in submission order per counterparty");
+
+        auto retry = MakeValidEquityDto();
+        retry.Counterparty = "CP-3";
+        retry.IdempotencyKey = "engine-3-7";
+        auto duplicate = engine.Submit(retry).get();
+        auto invalid = MakeValidEquityDto();
+        invalid.IdempotencyKey.clear();
+        invalid.Additional = AttributeMap();
+        auto rejected = engine.Submit(invalid).get();
+        CHECK(duplicate.Status == BookingStatus::Duplicate && duplicate.Trade->GetNotional() == 8.0 &&
+              rejected.Status == BookingStatus::Rejected && !rejected.Error.empty(),
+              "BookingEngine futures report duplicates and rejections");
+
+        std::size_t visited = 0;
+        engine.ForEachTrade([&visited](const Trade&) { ++visited; return true; });
+        auto stats = engine.GetStats();
+        std::uint64_t submitted = 0, batches = 0;
+        for (const auto& worker : stats) {
+            submitted += worker.Submitted;
+            batches += worker.Batches;
+        }
+        CHECK(visited == static_cast<std::size_t>(booked.load()) &&
+              engine.GetTradesByCounterparty("CP-5").size() == static_cast<std::size_t>(perCounterparty) &&
+              engine.GetTrade(duplicate.Trade->GetTradeId()) == duplicate.Trade &&
+              submitted == static_cast<std::uint64_t>(booked.load()) + 2 && batches < submitted,
+              "BookingEngine queries fan out and batches per worker");
+
+        // Left queued for the destructor to drain
+        for (int i = 0; i < 100; ++i) {
+            auto dto = MakeValidEquityDto();
+            dto.IdempotencyKey = "engine-tail-" + std::to_string(i);
+            engine.Submit(std::move(dto), [&booked](const BookingResult&) { ++booked; });
+        }
+    }
+    CHECK(booked == counterparties * perCounterparty + 100, "BookingEngine drains its queues on destruction");
+
+    // A publisher failure comes after the save: the batch is counted as
+    // failed, not rejected, and its trade is in the book
+    class ThrowingEventPublisher : public IEventPublisher {
+    public:
+        void Publish(const Events::TradeBookedEvent&) override { throw std::runtime_error("publisher down"); }
+    };
+    BookingEngineOptions single;
+    single.WorkerCount = 1;
+    single.ConfigureService = options.ConfigureService;
+    BookingEngine failing(std::make_shared<ThrowingEventPublisher>(), single);
+    auto dto = MakeValidEquityDto();
+    dto.IdempotencyKey = "engine-publish-failure";
+    bool threw = false;
+    try {
+        failing.Submit(dto).get();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    auto failedStats = failing.GetStats();
+    CHECK(threw && failedStats[0].Failed == 1 && failedStats[0].Rejected == 0 && failedStats[0].Booked == 0 &&
+          failing.GetTradesByCounterparty(dto.Counterparty).size() == 1,
+          "BookingEngine counts a thrown batch as failed, not rejected");
+}
+
+void test_booking_metrics() {
+    using namespace TradeBookEngine::Core::Metrics;
+
+    bool bucketsBound = true;
+    for (std::uint64_t value : {std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{15}, std::uint64_t{16},
+                                std::uint64_t{17}, std::uint64_t{100}, std::uint64_t{1000}, std::uint64_t{123456},
+                                std::uint64_t{1} << 35}) {
+        auto bucket = LatencyHistogram::BucketFor(value);
+        auto lower = LatencyHistogram::BucketLowerBound(bucket);
+        auto upper = LatencyHistogram::BucketLowerBound(bucket + 1);
+        bucketsBound = bucketsBound && lower <= value && value < upper && (upper - lower) * 16 <= std::max<std::uint64_t>(lower, 16);
+    }
+    CHECK(bucketsBound, "LatencyHistogram buckets hold their values within 1/16");
+
+    auto histogram = std::make_unique<LatencyHistogram>();
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram->Record(value);
+    }
+    HistogramSnapshot merged;
+    merged.Add(*histogram);
+    merged.Add(*histogram);
+    CHECK(merged.Count == 2000 && merged.MaxNanos() == 1000.0 && std::abs(merged.MeanNanos() - 500.5) < 1e-9,
+          "HistogramSnapshot merges counts, sum and maximum");
+    CHECK(std::abs(merged.PercentileNanos(50.0) - 500.0) <= 500.0 / 16 &&
+          std::abs(merged.PercentileNanos(99.0) - 990.0) <= 990.0 / 16 && merged.PercentileNanos(100.0) <= 1000.0,
+          "HistogramSnapshot percentiles are within one bucket");
+
+    TestContext ctx;
+    ctx.service->SetMetricsSampleInterval(1);
+    auto dto = MakeValidEquityDto();
+    ctx.service->BookTrade(dto);
+    ctx.service->BookTrade(dto);
+    auto invalid = MakeValidEquityDto();
+    invalid.IdempotencyKey = "metrics-invalid";
+    invalid.Counterparty = "";
+    ctx.service->TryBookTrade(invalid);
+
+    std::vector<TradeDto> batch(3, MakeValidEquityDto());
+    batch[1].IdempotencyKey = "metrics-batch";
+    batch[2].IdempotencyKey = "metrics-batch-invalid";
+    batch[2].Notional = 0.0;
+    ctx.service->BookTrades(batch);
+
+    std::thread([&ctx]() {
+        auto other = MakeValidEquityDto();
+        other.IdempotencyKey = "metrics-thread";
+        ctx.service->BookTrade(other);
+    }).join();
+
+    auto snapshot = ctx.service->GetMetricsSnapshot();
+    CHECK(snapshot.Booked == 3 && snapshot.IdempotentHits == 2 && snapshot.Rejected == 2,
+          "Metrics count booked trades, idempotent hits and rejects");
+    CHECK(snapshot.RejectsByReason[static_cast<std::size_t>(BookingErrorCode::EmptyCounterparty)] == 1 &&
+          snapshot.RejectsByReason[static_cast<std::size_t>(BookingErrorCode::NonPositiveNotional)] == 1,
+          "Metrics count rejects by reason");
+    CHECK(snapshot.Threads == 2, "Metrics merge per-thread blocks on read");
+    CHECK(snapshot.Stage(BookingStage::Total).Count == 4 &&
+          snapshot.Stage(BookingStage::IdempotencyLookup).Count == 4 &&
+          snapshot.Stage(BookingStage::Validation).Count == 5 &&
+          snapshot.Stage(BookingStage::Conversion).Count == 3 &&
+          snapshot.Stage(BookingStage::RepositorySave).Count == 2 &&
+          snapshot.Stage(BookingStage::Publish).Count == 2 &&
+          snapshot.Stage(BookingStage::BatchTotal).Count == 1 &&
+          snapshot.Stage(BookingStage::BatchSave).Count == 1,
+          "Metrics time each booking stage");
+    CHECK(snapshot.TicksPerNanosecond > 0.0 &&
+          snapshot.Stage(BookingStage::Total).PercentileNanos(99.0) >= snapshot.Stage(BookingStage::Total).PercentileNanos(50.0),
+          "Metrics convert ticks to nanoseconds");
+    auto text = snapshot.ToText();
+    CHECK(text.find("RepositorySave") != std::string::npos && text.find("EmptyCounterparty=1") != std::string::npos,
+          "Metrics text dump lists stages and reject reasons");
+
+    TestContext sampled;
+    sampled.service->SetMetricsSampleInterval(4);
+    for (int i = 0; i < 10; ++i) {
+        auto next = MakeValidEquityDto();
+        next.IdempotencyKey = "metrics-sampled-" + std::to_string(i);
+        sampled.service->BookTrade(next);
+    }
+    auto sampledSnapshot = sampled.service->GetMetricsSnapshot();
+    CHECK(sampledSnapshot.Booked == 10 && sampledSnapshot.Stage(BookingStage::Total).Count == 3,
+          "Sampled metrics count every booking but time one in each interval");
+
+    TestContext quiet;
+    quiet.service->SetMetricsEnabled(false);
+    quiet.service->BookTrade(MakeValidEquityDto());
+    auto quietSnapshot = quiet.service->GetMetricsSnapshot();
+    CHECK(quietSnapshot.Booked == 0 && quietSnapshot.Stage(BookingStage::Total).Count == 0,
+          "Disabled metrics record nothing");
+
+    std::mutex mutex;
+    std::unique_lock<std::mutex> held(mutex);
+    LockWaitCounters waited;
+    std::thread contender([&mutex, &waited]() {
+        auto before = ThreadLockWaits();
+        auto lock = LockTimed(mutex);
+        waited.Waits = ThreadLockWaits().Waits - before.Waits;
+        waited.Ticks = ThreadLockWaits().Ticks - before.Ticks;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.unlock();
+    contender.join();
+    CHECK(waited.Waits == 1 && waited.Ticks > 0, "LockTimed charges contended acquisitions to the thread");
+}
+
+void test_position_keeper() {
+    using Analytics::PositionDimension;
+    auto repo = std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); });
+    auto positions = std::make_shared<Analytics::PositionKeeper>();
+    repo->AddListener(positions);
+    auto service = std::make_unique<TradeService>(repo, std::shared_ptr<IEventPublisher>(
+        CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+
+    auto buy = MakeValidEquityDto();
+    buy.Counterparty = "PosCpty";
+    buy.InstrumentId = "POS-1";
+    buy.Currency = "CHF";
+    auto sell = buy;
+    sell.IdempotencyKey = "pos-sell";
+    sell.Side = TradeSide::Sell;
+    sell.Notional = 30000.0;
+    auto other = buy;
+    other.IdempotencyKey = "pos-other";
+    other.InstrumentId = "POS-2";
+    other.Notional = 5000.0;
+
+    auto buyTrade = service->BookTrade(buy);
+    auto sellTrade = service->BookTrade(sell);
+    service->BookTrade(other);
+
+    auto counterparty = positions->ByCounterparty("PosCpty");
+    CHECK(counterparty.NetNotional == 75000.0 && counterparty.GrossNotional == 135000.0 && counterparty.Trades == 3,
+          "Positions net buys against sells per counterparty");
+    auto instrument = positions->ByInstrument("POS-1");
+    CHECK(instrument.NetNotional == 70000.0 && instrument.Trades == 2 &&
+          positions->ByInstrument("POS-2").NetNotional == 5000.0, "Positions are kept per instrument");
+    CHECK(positions->ByCurrency("CHF").GrossNotional == 135000.0 && positions->ByCurrency("JPY").Trades == 0 &&
+          positions->ByCounterparty("never-booked-position").Trades == 0, "Positions are kept per currency");
+
+    repo->UpdateStatus(sellTrade->GetTradeId(), TradeStatus::Cancelled);
+    CHECK(positions->ByCounterparty("PosCpty").NetNotional == 105000.0 &&
+          positions->ByCounterparty("PosCpty").Trades == 2, "Cancelling a trade takes it out of its positions");
+    repo->UpdateStatus(sellTrade->GetTradeId(), TradeStatus::Booked);
+    repo->UpdateStatus(buyTrade->GetTradeId(), TradeStatus::Settled);
+    CHECK(positions->ByCounterparty("PosCpty").NetNotional == 75000.0 &&
+          positions->ByCounterparty("PosCpty").Trades == 3, "Settled and rebooked trades count");
+
+    auto replacement = std::make_shared<Trade>(*buyTrade);
+    replacement->SetStatus(TradeStatus::Failed);
+    repo->Save(replacement);
+    CHECK(positions->ByInstrument("POS-1").NetNotional == -30000.0, "Saving over a trade replaces its contribution");
+
+    repo->Delete(sellTrade->GetTradeId());
+    CHECK(positions->ByInstrument("POS-1").Trades == 0 && positions->ByCounterparty("PosCpty").Trades == 1,
+          "Deleting a trade takes it out of its positions");
+
+    auto rebuilt = std::make_shared<Analytics::PositionKeeper>();
+    rebuilt->Rebuild(repo->GetAll());
+    CHECK(rebuilt->ByCounterparty("PosCpty").NetNotional == 5000.0 && rebuilt->ByCurrency("CHF").Trades == 1,
+          "Rebuild seeds positions from an existing book");
+
+    // Bookings from several threads while snapshots are taken: every
+    // snapshot must agree across dimensions
+    auto booked = std::make_shared<Analytics::PositionKeeper>();
+    auto bookedRepo = std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(8),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); });
+    bookedRepo->AddListener(booked);
+    auto bookedService = std::make_unique<TradeService>(bookedRepo, std::shared_ptr<IEventPublisher>(
+        CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+    const int threadCount = 4;
+    const int perThread = 500;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            auto snapshot = booked->Snapshot();
+            double totals[Analytics::PositionDimensionCount] = {};
+            std::int64_t counts[Analytics::PositionDimensionCount] = {};
+            for (std::size_t d = 0; d < Analytics::PositionDimensionCount; ++d) {
+                for (const auto& entry : snapshot.Entries[d]) {
+                    totals[d] += entry.Value.NetNotional;
+                    counts[d] += entry.Value.Trades;
+                }
+            }
+            if (totals[0] != totals[1] || totals[1] != totals[2] || counts[0] != counts[1] || counts[1] != counts[2]) {
+                consistent = false;
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threadCount; ++t) {
+        writers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                auto dto = MakeValidEquityDto();
+                dto.IdempotencyKey = "pos-mt-" + std::to_string(t) + "-" + std::to_string(i);
+                dto.Counterparty = "PosMt-" + std::to_string(i % 7);
+                dto.InstrumentId = "POSMT-" + std::to_string(i % 11);
+                dto.Currency = i % 2 == 0 ? "USD" : "EUR";
+                dto.Side = i % 3 == 0 ? TradeSide::Sell : TradeSide::Buy;
+                dto.Notional = static_cast<double>(1 + i % 10);
+                bookedService->BookTrade(dto);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    double expected = 0.0;
+    for (int i = 0; i < perThread; ++i) {
+        expected += (i % 3 == 0 ? -1.0 : 1.0) * static_cast<double>(1 + i % 10) * threadCount;
+    }
+    auto after = booked->Snapshot();
+    double net = 0.0;
+    std::int64_t trades = 0;
+    for (const auto& entry : after.Of(PositionDimension::Counterparty)) {
+        net += entry.Value.NetNotional;
+        trades += entry.Value.Trades;
+    }
+    CHECK(net == expected && trades == threadCount * perThread &&
+          after.Of(PositionDimension::Currency).size() == 2, "Concurrent bookings all reach the positions");
+    CHECK(consistent.load(), "Position snapshots are consistent across dimensions");
+}
+
+void test_counterparty_limits() {
+    TestContext ctx;
+    auto limits = std::make_shared<Risk::CounterpartyLimits>();
+    ctx.repo->AddListener(limits);
+    ctx.service->SetCounterpartyLimits(limits);
+    limits->SetLimit("LimitCpty", 150000.0);
+
+    auto first = MakeValidEquityDto();
+    first.Counterparty = "LimitCpty";
+    first.IdempotencyKey = "limit-1";
+    auto second = first;
+    second.IdempotencyKey = "limit-2";
+    auto firstOutcome = ctx.service->TryBookTrade(first);
+    auto breach = ctx.service->TryBookTrade(second);
+    CHECK(firstOutcome.Status == BookingStatus::Booked && breach.Status == BookingStatus::Rejected &&
+          breach.Error.Code == BookingErrorCode::LimitBreached &&
+          breach.Error.Message() == "Counterparty limit exceeded", "Bookings over the counterparty limit are rejected");
+    auto usage = limits->GetUsage("LimitCpty");
+    CHECK(usage.HasLimit && usage.Limit == 150000.0 && usage.Exposure == 100000.0,
+          "Booked notional is committed against the limit");
+    CHECK(ctx.service->GetMetricsSnapshot().RejectsByReason[static_cast<std::size_t>(BookingErrorCode::LimitBreached)] == 1,
+          "Limit breaches are counted as a reject reason");
+
+    limits->SetLimit("LimitCpty", 200000.0);
+    auto retried = ctx.service->TryBookTrade(second);
+    CHECK(retried.Status == BookingStatus::Booked, "A rejected booking can be retried with the same key");
+
+    ctx.repo->UpdateStatus(firstOutcome.Trade->GetTradeId(), TradeStatus::Cancelled);
+    CHECK(limits->GetUsage("LimitCpty").Exposure == 100000.0, "Cancelled trades release their exposure");
+    ctx.repo->UpdateStatus(retried.Trade->GetTradeId(), TradeStatus::Settled);
+    CHECK(limits->GetUsage("LimitCpty").Exposure == 0.0, "Settled trades release their exposure");
+
+    std::vector<TradeDto> batch(3, first);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        batch[i].IdempotencyKey = "limit-batch-" + std::to_string(i);
+        batch[i].Notional = 80000.0;
+    }
+    auto results = ctx.service->BookTrades(batch);
+    CHECK(results[0].Status == BookingStatus::Booked && results[1].Status == BookingStatus::Booked &&
+          results[2].Status == BookingStatus::Rejected && results[2].Error == "Counterparty limit exceeded" &&
+          limits->GetUsage("LimitCpty").Exposure == 160000.0, "Batch bookings are checked against the limit");
+    ctx.repo->Delete(results[0].Trade->GetTradeId());
+    CHECK(limits->GetUsage("LimitCpty").Exposure == 80000.0, "Deleted trades release their exposure");
+
+    limits->ReloadLimits({{"OtherCpty", 10.0}});
+    CHECK(!limits->GetUsage("LimitCpty").HasLimit && limits->GetUsage("OtherCpty").Limit == 10.0,
+          "Reloading replaces every counterparty limit");
+    limits->SetDefaultLimit(1000.0);
+    CHECK(limits->GetUsage("LimitCpty").HasLimit && limits->GetUsage("unseen-cpty").Limit == 1000.0,
+          "The default limit covers counterparties without their own");
+    limits->SetDefaultLimit(-1.0);
+    bool threw = false;
+    try {
+        limits->ReloadLimits({{"OtherCpty", 5.0}, {"BadCpty", -5.0}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw && limits->GetUsage("OtherCpty").Limit == 10.0, "Invalid limits are refused without changing any");
+
+    // Rebooking an existing trade id replaces the trade and its exposure
+    limits->SetLimit("ReplaceCpty", 1000.0);
+    auto original = MakeValidEquityDto();
+    original.Counterparty = "ReplaceCpty";
+    original.TradeId = "limit-replace";
+    original.IdempotencyKey = "limit-replace-1";
+    original.Notional = 600.0;
+    auto rebooked = original;
+    rebooked.IdempotencyKey = "limit-replace-2";
+    rebooked.Notional = 300.0;
+    bool replacedBooked = ctx.service->TryBookTrade(original).Status == BookingStatus::Booked &&
+                          ctx.service->TryBookTrade(rebooked).Status == BookingStatus::Booked;
+    CHECK(replacedBooked && ctx.repo->GetByCounterparty("ReplaceCpty").size() == 1 &&
+          limits->GetUsage("ReplaceCpty").Exposure == 300.0, "A replaced trade gives back its exposure");
+    ctx.repo->Delete("limit-replace");
+    CHECK(limits->GetUsage("ReplaceCpty").Exposure == 0.0, "Deleting a replaced trade leaves no exposure behind");
+
+    // Many threads against one counterparty never book past its limit
+    limits->SetLimit("RaceCpty", 12345.0);
+    const int threadCount = 4;
+    const int perThread = 500;
+    std::atomic<int> booked{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                auto dto = MakeValidEquityDto();
+                dto.Counterparty = "RaceCpty";
+                dto.Notional = 10.0;
+                dto.IdempotencyKey = "limit-race-" + std::to_string(t) + "-" + std::to_string(i);
+                if (ctx.service->TryBookTrade(dto).Status == BookingStatus::Booked) {
+                    ++booked;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(booked.load() == 1234 && limits->GetUsage("RaceCpty").Exposure == 12340.0,
+          "Concurrent bookings fill the limit exactly");
+
+    auto rebuilt = std::make_shared<Risk::CounterpartyLimits>();
+    rebuilt->Rebuild(ctx.repo->GetAll());
+    CHECK(rebuilt->GetUsage("RaceCpty").Exposure == 12340.0 && rebuilt->GetUsage("LimitCpty").Exposure == 80000.0,
+          "Rebuild recomputes exposure from the book");
+}
+
+void test_trade_lifecycle() {
+    using namespace TradeBookEngine::Core::Repositories;
+    using Calendars::HolidayCalendar;
+    namespace fs = std::filesystem;
+    CHECK(IsValidTransition(TradeStatus::Pending, TradeStatus::Booked) &&
+          IsValidTransition(TradeStatus::Booked, TradeStatus::Settled) &&
+          IsValidTransition(TradeStatus::Failed, TradeStatus::Settled) &&
+          !IsValidTransition(TradeStatus::Settled, TradeStatus::Cancelled) &&
+          !IsValidTransition(TradeStatus::Cancelled, TradeStatus::Booked) &&
+          !IsValidTransition(TradeStatus::Booked, TradeStatus::Pending), "Lifecycle transition rules");
+
+    auto day = HolidayCalendar::FromDay(20000);
+    const int raceCount = 200;
+    // L-0..L-3 settle at different times on day, L-4 and L-5 the day after,
+    // R-* two days later
+    auto fill = [&day](ITradeRepository& repo, int races) {
+        auto save = [&repo](const std::string& id, std::chrono::system_clock::time_point settlement) {
+            auto trade = std::make_shared<Trade>(id, AssetClass::Equity, "AAPL", "LifeCpty", 1000.0, "USD",
+                TradeSide::Buy, settlement - std::chrono::hours(48), settlement, "tester");
+            trade->SetStatus(TradeStatus::Booked);
+            repo.Save(trade);
+        };
+        for (int i = 0; i < 6; ++i) {
+            save("L-" + std::to_string(i), day + std::chrono::hours(i < 4 ? 1 + 7 * i : 30));
+        }
+        for (int i = 0; i < races; ++i) {
+            save("R-" + std::to_string(i), day + std::chrono::hours(50));
+        }
+    };
+
+    auto check = [&day](const std::shared_ptr<ITradeRepository>& repo, const std::string& name, int races) {
+        auto positions = std::make_shared<Analytics::PositionKeeper>();
+        repo->AddListener(positions);
+        positions->Rebuild(repo->GetAll());
+        TradeService service(repo, std::shared_ptr<IEventPublisher>(
+            CreateNoOpEventPublisher(), [](IEventPublisher* p){ DestroyNoOpEventPublisher(p); }));
+
+        auto cancelled = service.CancelTrade("L-1");
+        auto refused = service.SettleTrade("L-1");
+        auto again = service.CancelTrade("L-1");
+        CHECK(cancelled.Outcome == TransitionOutcome::Applied && cancelled.Previous == TradeStatus::Booked &&
+              refused.Outcome == TransitionOutcome::Refused && refused.Previous == TradeStatus::Cancelled &&
+              !refused.Succeeded() && again.Outcome == TransitionOutcome::Unchanged && again.Succeeded() &&
+              repo->GetById("L-1")->GetStatus() == TradeStatus::Cancelled,
+              name + ": transitions are checked against the current status");
+        CHECK(service.FailTrade("missing").Outcome == TransitionOutcome::NotFound &&
+              service.FailTrade("L-2").Outcome == TransitionOutcome::Applied, name + ": fail and unknown ids");
+
+        CHECK(service.GetTradesBySettlementDate(day + std::chrono::hours(5)).size() == 4 &&
+              service.GetTradesBySettlementDate(day + std::chrono::hours(24)).size() == 2 &&
+              service.GetTradesBySettlementDate(day - std::chrono::hours(1)).empty(),
+              name + ": trades are bucketed by settlement day");
+        CHECK(service.SettleDueTrades(day + std::chrono::hours(12)) == 2 &&
+              repo->GetById("L-0")->GetStatus() == TradeStatus::Settled &&
+              repo->GetById("L-3")->GetStatus() == TradeStatus::Settled &&
+              repo->GetById("L-2")->GetStatus() == TradeStatus::Failed &&
+              repo->GetById("L-4")->GetStatus() == TradeStatus::Booked &&
+              repo->GetByStatus(TradeStatus::Settled).size() == 2,
+              name + ": the sweep settles only Booked trades due that day");
+
+        auto settled = service.SettleTrades({"L-2", "L-4", "missing"});
+        auto cancels = service.CancelTrades({"L-5", "L-4"});
+        CHECK(settled.size() == 3 && settled[0].Outcome == TransitionOutcome::Applied &&
+              settled[0].Previous == TradeStatus::Failed && settled[1].Outcome == TransitionOutcome::Applied &&
+              settled[2].Outcome == TransitionOutcome::NotFound && cancels[0].Outcome == TransitionOutcome::Applied &&
+              cancels[1].Outcome == TransitionOutcome::Refused && repo->GetByStatus(TradeStatus::Cancelled).size() == 2,
+              name + ": bulk transitions report each trade");
+        // Positions count Booked and Settled trades; L-2 dropped out on
+        // failing and came back on settling
+        CHECK(positions->ByCounterparty("LifeCpty").Trades == 4 + races,
+              name + ": listeners see applied transitions");
+
+        // Settle and Cancel race on every R-* trade; exactly one wins each
+        std::atomic<int> settleWins{0}, cancelWins{0}, losses{0};
+        std::thread settler([&]() {
+            for (int i = 0; i < races; ++i) {
+                auto outcome = service.SettleTrade("R-" + std::to_string(i)).Outcome;
+                (outcome == TransitionOutcome::Applied ? settleWins : losses) += 1;
+            }
+        });
+        std::thread canceller([&]() {
+            for (int i = races; i-- > 0;) {
+                auto outcome = service.CancelTrade("R-" + std::to_string(i)).Outcome;
+                (outcome == TransitionOutcome::Applied ? cancelWins : losses) += 1;
+            }
+        });
+        settler.join();
+        canceller.join();
+        CHECK(settleWins.load() + cancelWins.load() == races && losses.load() == races &&
+              repo->GetByStatus(TradeStatus::Settled).size() == static_cast<std::size_t>(4 + settleWins.load()) &&
+              repo->GetByStatus(TradeStatus::Cancelled).size() == static_cast<std::size_t>(2 + cancelWins.load()) &&
+              positions->ByCounterparty("LifeCpty").Trades == 4 + settleWins.load(),
+              name + ": racing transitions apply exactly once");
+    };
+
+    auto inMemory = std::shared_ptr<ITradeRepository>(CreateInMemoryTradeRepository(),
+        [](ITradeRepository* p){ DestroyInMemoryTradeRepository(p); });
+    fill(*inMemory, raceCount);
+    check(inMemory, "InMemory", raceCount);
+    auto sharded = std::shared_ptr<ITradeRepository>(CreateShardedTradeRepository(4),
+        [](ITradeRepository* p){ DestroyShardedTradeRepository(p); });
+    fill(*sharded, raceCount);
+    check(sharded, "Sharded", raceCount);
+
+    fs::path dir = fs::temp_directory_path() /
+        ("tradebook_lifecycle_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+    std::string snapshotPath = (dir / "trades.snapshot").string();
+    // Fresh Booked copies, so every transition starts from a snapshot record
+    fill(*inMemory, raceCount);
+    WriteTradeSnapshot(*inMemory, snapshotPath);
+    check(std::make_shared<SnapshotTradeRepository>(snapshotPath, 4), "Snapshot", raceCount);
+
+    JournalOptions options;
+    options.Path = (dir / "trades.journal").string();
+    options.ShardCount = 4;
+    {
+        auto journal = std::make_shared<JournalTradeRepository>(options);
+        fill(*journal, 0);
+        check(journal, "Journal", 0);
+    }
+    auto reopened = std::make_shared<JournalTradeRepository>(options);
+    CHECK(reopened->GetById("L-2")->GetStatus() == TradeStatus::Settled &&
+          reopened->GetById("L-1")->GetStatus() == TradeStatus::Cancelled &&
+          reopened->GetById("L-4")->GetStatus() == TradeStatus::Settled &&
+          reopened->GetStats().RecoveredRecords == 6 + 7, "Journal: transitions survive reopening");
+    reopened.reset();
+    std::error_code ignored;
+    fs::remove_all(dir, ignored);
+}
+
 int main() {
     std::cout << "Running TradeBookEngine tests...\n";
     test_book_trade_happy_path();
     test_idempotency_returns_existing();
     test_validation_failure();
+    test_book_trades_batch();
+    test_sharded_repository_concurrent_access();
+    test_secondary_index_queries();
+    test_concurrent_idempotent_submissions();
+    test_async_event_publisher();
+    test_snowflake_ids_unique_and_ordered();
+    test_symbol_table();
+    test_columnar_store_tracks_repository();
+    test_column_kernels_match_scalar();
+    test_attribute_map();
+    test_pooled_trade_allocation();
+    test_streaming_reads();
+    test_journal_recovery();
+    test_snapshot_repository();
+    test_validator_dispatch();
+    test_try_book_trade();
+    test_iso8601_timestamps();
+    test_holiday_calendars();
+    test_currency_codes();
+    test_booking_engine();
+    test_booking_metrics();
+    test_position_keeper();
+    test_counterparty_limits();
+    test_trade_lifecycle();
 
     if (failures == 0) {
         std::cout << "All tests passed.\n";